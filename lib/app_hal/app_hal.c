@@ -36,6 +36,12 @@ void hal_setup(void)
     lv_log_register_print_cb(lv_log_print_g_cb);
     #endif
 
+    #if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_ROUTE_BY_SIZE
+    /* Emulate the SDRAM of the board: the large blocks are allocated from a separate pool */
+    static uint64_t sdram[LV_MEM_POOL_EXPAND_SIZE / sizeof(uint64_t)];
+    lv_mem_add_large_pool(sdram, sizeof(sdram));
+    #endif
+
     /* Add a display
      * Use the 'monitor' driver which creates window on PC's monitor to simulate a display*/
 
@@ -172,16 +172,10 @@
     #define LV_DRAW_SW_COMPLEX          1
 
     #if LV_DRAW_SW_COMPLEX == 1
-        /*Allow buffering some shadow calculation.
-        *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
-        #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
-
-        /* Set number of maximally cached circle data.
-        * The circumference of 1/4 circle are saved for anti-aliasing
-        * radius * 4 bytes are used per circle (the most often used radiuses are saved)
-        * 0: to disable caching */
-        #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+        /*Size of the cache of blurred shadow corners and anti-aliased circles of rounded corners in bytes.
+         *They are kept between refreshes and the least recently used ones are dropped to stay in the budget.
+         *A shadow takes `(shadow_width + radius)^2` bytes, a circle `radius * 6` bytes. 0: disable caching*/
+        #define LV_DRAW_SW_MASK_CACHE_SIZE (4 * 1024)
     #endif
 
     #if !defined(LV_USE_DRAW_SW_ASM) && defined(RTE_Acceleration_Arm_2D)
@@ -65,8 +65,34 @@
         #undef LV_MEM_POOL_INCLUDE
         #undef LV_MEM_POOL_ALLOC
     #endif
+
+    /*Route the allocations by size: blocks up to `LV_MEM_ROUTE_SMALL_MAX` bytes (objects, styles, events, draw tasks)
+     *are allocated from the `LV_MEM_SIZE` pool, larger ones (draw buffers, layers, images) from the pools added
+     *with `lv_mem_add_large_pool()`, e.g. in external SDRAM. If a heap is full the other one is used.
+     *`LV_MEM_POOL_EXPAND_SIZE` should be the size of the large pools.*/
+    #define LV_MEM_ROUTE_BY_SIZE 0
+    #if LV_MEM_ROUTE_BY_SIZE
+        #define LV_MEM_ROUTE_SMALL_MAX (4 * 1024U)   /*[bytes]*/
+    #endif
+
+    /*Allocate the small blocks (objects and widgets, draw tasks and descriptors, event and style entries)
+     *from fixed size slabs in a separate `LV_MEM_SLAB_SIZE` bytes pool. It's faster than the heap and
+     *the frequently created and deleted blocks don't fragment it. If the slabs are full the heap is used.*/
+    #define LV_USE_MEM_SLAB 0
+    #if LV_USE_MEM_SLAB
+        #define LV_MEM_SLAB_SIZE (16 * 1024U)   /*[bytes]*/
+
+        /*Block sizes of the slab classes in ascending order. Multiples of 8, at most 512 and 16 classes.*/
+        #define LV_MEM_SLAB_BLOCK_SIZES 16, 32, 48, 64, 80, 96, 128, 160, 192, 256
+    #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
+#if LV_USE_STDLIB_STRING == LV_STDLIB_BUILTIN
+    /*Use the `lv_memcpy`, `lv_memset` and `lv_memmove` tuned for ARMv7E-M (Cortex-M4/M7).
+     *They copy 32 byte blocks in bursts and copy misaligned memories by shifting words instead of bytes.*/
+    #define LV_STRING_BUILTIN_ARMV7EM 0
+#endif  /*LV_USE_STDLIB_STRING == LV_STDLIB_BUILTIN*/
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -128,6 +154,23 @@
 /*The target buffer size for simple layer chunks.*/
 #define LV_DRAW_LAYER_SIMPLE_BUF_SIZE    (24 * 1024)   /*[bytes]*/
 
+/*Keep the buffers of the drawn layers and reuse them for the next layers of similar size instead of
+ *allocating and freeing them on each refresh (e.g. while a transformed or semi-transparent widget is animated).
+ *The buffers are rounded up to size classes, at most 25% larger, to match while the size of the layers changes.
+ *LV_DRAW_LAYER_POOL_SIZE is the max. size of the unused buffers to keep. They stay allocated in the heap of the
+ *draw buffers (the large pool with `LV_MEM_ROUTE_BY_SIZE`), so it needs that much free space. 0: disable the pool*/
+#define LV_DRAW_LAYER_POOL_SIZE    0   /*[bytes]*/
+#if LV_DRAW_LAYER_POOL_SIZE
+    /*Address of a dedicated region of `LV_DRAW_LAYER_POOL_SIZE` bytes for all the layer buffers (e.g. in external SDRAM).
+     *Requires `LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN`. 0: allocate them as the other draw buffers*/
+    #define LV_DRAW_LAYER_POOL_ADR     0
+#endif
+
+/*Skip the widgets which are fully covered by an opaque widget drawn later on the refreshed area.
+ *The opaque widgets are found with `LV_EVENT_COVER_CHECK`.
+ *With `LV_USE_PERF_MONITOR` the draw tasks of the skipped widgets are created and freed to count them.*/
+#define LV_USE_REFR_OCCLUSION   0
+
 /* The stack size of the drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -169,16 +212,10 @@
     #define LV_DRAW_SW_COMPLEX          1
 
     #if LV_DRAW_SW_COMPLEX == 1
-        /*Allow buffering some shadow calculation.
-        *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
-        #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
-
-        /* Set number of maximally cached circle data.
-        * The circumference of 1/4 circle are saved for anti-aliasing
-        * radius * 4 bytes are used per circle (the most often used radiuses are saved)
-        * 0: to disable caching */
-        #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+        /*Size of the cache of blurred shadow corners and anti-aliased circles of rounded corners in bytes.
+         *They are kept between refreshes and the least recently used ones are dropped to stay in the budget.
+         *A shadow takes `(shadow_width + radius)^2` bytes, a circle `radius * 6` bytes. 0: disable caching*/
+        #define LV_DRAW_SW_MASK_CACHE_SIZE (4 * 1024)
     #endif
 
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
@@ -361,14 +398,27 @@
 
 /*Default cache size in bytes.
  *Used by image decoders such as `lv_lodepng` to keep the decoded image in the memory.
- *If size is not set to 0, the decoder will fail to decode when the cache is full.
+ *The least recently used images are evicted to make room for the new ones. Images larger than 1/4 of the cache
+ *or which don't fit (e.g. all the others are pinned or being drawn) are decoded again for each use.
  *If size is 0, the cache function is not enabled and the decoded mem will be released immediately after use.*/
 #define LV_CACHE_DEF_SIZE       0
+#if LV_CACHE_DEF_SIZE
+    /*Address of a dedicated region of `LV_CACHE_DEF_SIZE` bytes for the decoded images (e.g. in external SDRAM).
+     *If it's full the heap is used. 0: allocate them from the heap as the other draw buffers.*/
+    #define LV_IMAGE_CACHE_ADR      0
+#endif
 
 /*Default number of image header cache entries. The cache is used to store the headers of images
  *The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.*/
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
 
+/*Default size of the text measurement cache in bytes. The size and the line breaks of a text are cached
+ *by the text, font, letter and line space, max width and flags. Labels measure their text on every change
+ *and the line breaks are needed again on every draw, so recurring texts are measured only once.
+ *An entry takes about 60 bytes with the copy of its text and 8 bytes per line. Texts which would take more than
+ *a quarter of the cache are not cached. 0: disable*/
+#define LV_TEXT_CACHE_DEF_SIZE 0
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS   2
@@ -380,6 +430,20 @@
 /* Add 2 x 32 bit variables to each lv_obj_t to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/* Cache the resolved style properties of each object, keyed by part, state and property.
+ * Number of entries per object (power of 2), 0: disable.
+ * The cache (~12 bytes per entry) is allocated when the first style is added to the object */
+#define LV_OBJ_STYLE_PROP_CACHE_CNT 0
+
+/* Find the pressed object with a grid of the clickable objects instead of walking the object tree.
+ * The grid is rebuilt on the first search after an object moved, resized or its flags or parent changed.
+ * Transformed objects disable the grid of their screen */
+#define LV_USE_INDEV_HIT_INDEX  0
+#if LV_USE_INDEV_HIT_INDEX
+    /* Size of a grid cell in pixels */
+    #define LV_INDEV_HIT_INDEX_CELL_SIZE 32
+#endif
+
 /* Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -528,6 +592,15 @@
 
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
+#if LV_USE_FONT_COMPRESSED
+    /*Size of the cache of decompressed glyph bitmaps in bytes. 0: disable caching.
+     *Recently drawn glyphs are copied from here instead of being decompressed again.*/
+    #define LV_FONT_COMPRESSED_CACHE_SIZE 0
+#endif
+
+/*Convert the kerning pairs of the fonts loaded with lv_binfont to kerning classes.
+ *The class matrix takes up to 4 kB RAM per font but avoids the binary search on every pair of glyphs.*/
+#define LV_BINFONT_KERN_CLASSES 0
 
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
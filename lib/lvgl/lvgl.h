@@ -109,6 +109,7 @@ extern "C" {
 
 #include "src/draw/lv_draw.h"
 #include "src/draw/lv_draw_buf.h"
+#include "src/draw/lv_draw_layer_pool.h"
 #include "src/draw/lv_draw_vector.h"
 #include "src/draw/sw/lv_draw_sw.h"
 
@@ -50,6 +50,7 @@ extern "C" {
 #include "../stdlib/builtin/lv_tlsf_private.h"
 #include "../others/sysmon/lv_sysmon_private.h"
 #include "../layouts/lv_layout_private.h"
+#include "../indev/lv_indev_hit_index_private.h"
 
 /*********************
  *      DEFINES
@@ -82,10 +83,19 @@ typedef struct lv_global_t {
 
     lv_ll_t disp_ll;
     lv_display_t * disp_refresh;
+#if LV_USE_REFR_OCCLUSION
+    lv_obj_t ** refr_occluded;          /**< Objects not drawn on the area being refreshed*/
+    uint32_t refr_occluded_cnt;
+    uint32_t refr_occluded_size;
+#endif
     lv_display_t * disp_default;
 
     lv_ll_t style_trans_ll;
     bool style_refresh;
+    uint32_t style_refr_batch_depth;          /**< Nesting of `lv_obj_style_refresh_batch_start()`*/
+    lv_obj_style_refr_batch_t * style_refr_batch; /**< Objects whose style refresh is postponed*/
+    uint32_t style_refr_batch_cnt;
+    uint32_t style_refr_batch_size;
     uint32_t style_custom_table_size;
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
@@ -96,6 +106,9 @@ typedef struct lv_global_t {
     lv_ll_t indev_ll;
     lv_indev_t * indev_active;
     lv_obj_t * indev_obj_active;
+#if LV_USE_INDEV_HIT_INDEX
+    lv_indev_hit_index_state_t indev_hit_index;
+#endif
 
     uint32_t layout_count;
     lv_layout_dsc_t * layout_list;
@@ -119,14 +132,20 @@ typedef struct lv_global_t {
     lv_ll_t img_decoder_ll;
 
     lv_cache_t * img_cache;
+    lv_ll_t img_cache_ll;                   /**< Data of the image cache entries to pin and dump them */
+    uint32_t img_cache_hit_cnt;
+    uint32_t img_cache_miss_cnt;
+#if LV_CACHE_DEF_SIZE && LV_IMAGE_CACHE_ADR
+    lv_tlsf_t img_cache_tlsf;               /**< Allocator of the dedicated region of the decoded images */
+#endif
     lv_cache_t * img_header_cache;
+    lv_cache_t * text_cache;
 
     lv_draw_global_info_t draw_info;
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    lv_draw_sw_shadow_cache_t sw_shadow_cache;
-#endif
 #if LV_DRAW_SW_COMPLEX
-    lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
+    lv_cache_t * sw_mask_cache;
+    uint32_t sw_mask_cache_hit_cnt;
+    uint32_t sw_mask_cache_miss_cnt;
 #endif
 
 #if LV_USE_LOG
@@ -187,6 +206,7 @@ typedef struct lv_global_t {
 
 #if LV_USE_FONT_COMPRESSED
     lv_font_fmt_rle_t font_fmt_rle;
+    lv_cache_t * font_compressed_cache;
 #endif
 
 #if LV_USE_SPAN != 0
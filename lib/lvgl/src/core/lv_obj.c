@@ -14,6 +14,7 @@
 #include "lv_obj_class_private.h"
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_private.h"
+#include "../indev/lv_indev_hit_index_private.h"
 #include "lv_refr.h"
 #include "lv_group.h"
 #include "../display/lv_display.h"
@@ -35,6 +36,9 @@
 #define LV_OBJ_DEF_HEIGHT   (LV_DPX(50))
 #define STYLE_TRANSITION_MAX 32
 
+/*Flags which decide whether the pointer can find an object or its children*/
+#define HIT_INDEX_FLAGS (LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_OVERFLOW_VISIBLE)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -51,6 +55,7 @@ static lv_result_t scrollbar_init_draw_dsc(lv_obj_t * obj, lv_draw_rect_dsc_t *
 static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_find);
 static void update_obj_state(lv_obj_t * obj, lv_state_t new_state);
 static void null_on_delete_cb(lv_event_t * e);
+static bool depends_on_parent_size(const lv_obj_t * obj);
 
 #if LV_USE_OBJ_PROPERTY
     static lv_result_t lv_obj_set_any(lv_obj_t *, lv_prop_id_t, const lv_property_t *);
@@ -239,6 +244,10 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
 
     obj->flags |= f;
 
+#if LV_USE_INDEV_HIT_INDEX
+    if(f & HIT_INDEX_FLAGS) lv_indev_hit_index_invalidate();
+#endif
+
     if(f & LV_OBJ_FLAG_HIDDEN) {
         if(lv_obj_has_state(obj, LV_STATE_FOCUSED)) {
             lv_group_t * group = lv_obj_get_group(obj);
@@ -279,6 +288,10 @@ void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
 
     obj->flags &= (~f);
 
+#if LV_USE_INDEV_HIT_INDEX
+    if(f & HIT_INDEX_FLAGS) lv_indev_hit_index_invalidate();
+#endif
+
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
         if(lv_obj_is_layout_positioned(obj)) {
@@ -522,6 +535,13 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_obj_remove_style_all(obj);
     lv_obj_enable_style_refresh(true);
 
+    lv_obj_style_refresh_batch_remove(obj);
+
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    lv_free(obj->style_prop_cache);
+    obj->style_prop_cache = NULL;
+#endif
+
     /*Remove the animations from this object*/
     lv_anim_delete(obj, NULL);
 
@@ -844,11 +864,14 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
             lv_obj_mark_layout_as_dirty(obj);
         }
 
+        /*In RTL the left side moves too, so all the children need to be repositioned.
+         *Else only the children sized or aligned relative to this object.*/
+        bool rtl = lv_obj_get_style_base_dir(obj, LV_PART_MAIN) == LV_BASE_DIR_RTL;
         uint32_t i;
         uint32_t child_cnt = lv_obj_get_child_count(obj);
         for(i = 0; i < child_cnt; i++) {
             lv_obj_t * child = obj->spec_attr->children[i];
-            lv_obj_mark_layout_as_dirty(child);
+            if(rtl || depends_on_parent_size(child)) lv_obj_mark_layout_as_dirty(child);
         }
     }
     else if(code == LV_EVENT_CHILD_CHANGED) {
@@ -994,6 +1017,26 @@ static void null_on_delete_cb(lv_event_t * e)
     *obj_ptr = NULL;
 }
 
+/**
+ * Tell whether the size or position of an object is relative to its parent's size
+ * @param obj   pointer to an object
+ * @return      true: the object needs to be updated when its parent is resized
+ */
+static bool depends_on_parent_size(const lv_obj_t * obj)
+{
+    if(LV_COORD_IS_PCT(lv_obj_get_style_width(obj, LV_PART_MAIN))) return true;
+    if(LV_COORD_IS_PCT(lv_obj_get_style_min_width(obj, LV_PART_MAIN))) return true;
+    if(LV_COORD_IS_PCT(lv_obj_get_style_max_width(obj, LV_PART_MAIN))) return true;
+    if(LV_COORD_IS_PCT(lv_obj_get_style_height(obj, LV_PART_MAIN))) return true;
+    if(LV_COORD_IS_PCT(lv_obj_get_style_min_height(obj, LV_PART_MAIN))) return true;
+    if(LV_COORD_IS_PCT(lv_obj_get_style_max_height(obj, LV_PART_MAIN))) return true;
+    if(LV_COORD_IS_PCT(lv_obj_get_style_x(obj, LV_PART_MAIN))) return true;
+    if(LV_COORD_IS_PCT(lv_obj_get_style_y(obj, LV_PART_MAIN))) return true;
+
+    lv_align_t align = lv_obj_get_style_align(obj, LV_PART_MAIN);
+    return align != LV_ALIGN_DEFAULT && align != LV_ALIGN_TOP_LEFT;
+}
+
 #if LV_USE_OBJ_PROPERTY
 static lv_result_t lv_obj_set_any(lv_obj_t * obj, lv_prop_id_t id, const lv_property_t * prop)
 {
@@ -11,6 +11,7 @@
 #include "../themes/lv_theme.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
+#include "../indev/lv_indev_hit_index_private.h"
 #include "../stdlib/lv_string.h"
 
 /*********************
@@ -98,6 +99,10 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         parent->spec_attr->children[parent->spec_attr->child_cnt - 1] = obj;
     }
 
+#if LV_USE_INDEV_HIT_INDEX
+    lv_indev_hit_index_invalidate();
+#endif
+
     return obj;
 }
 
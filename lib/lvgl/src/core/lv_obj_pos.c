@@ -14,6 +14,7 @@
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "lv_refr_private.h"
+#include "../indev/lv_indev_hit_index_private.h"
 #include "../core/lv_global.h"
 
 /*********************
@@ -32,6 +33,7 @@
 static int32_t calc_content_width(lv_obj_t * obj);
 static int32_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static void mark_layout_path(lv_obj_t * obj);
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv);
 
 /**********************
@@ -103,7 +105,14 @@ bool lv_obj_refr_size(lv_obj_t * obj)
         w = lv_obj_get_style_width(obj, LV_PART_MAIN);
         w_is_content = w == LV_SIZE_CONTENT;
         w_is_pct = LV_COORD_IS_PCT(w);
-        int32_t parent_w = lv_obj_get_content_width(parent);
+        int32_t minw = lv_obj_get_style_min_width(obj, LV_PART_MAIN);
+        int32_t maxw = lv_obj_get_style_max_width(obj, LV_PART_MAIN);
+
+        /*The parent's size matters only for percentage values*/
+        int32_t parent_w = 0;
+        if(w_is_pct || LV_COORD_IS_PCT(minw) || LV_COORD_IS_PCT(maxw)) {
+            parent_w = lv_obj_get_content_width(parent);
+        }
 
         if(w_is_content) {
             w = calc_content_width(obj);
@@ -120,8 +129,6 @@ bool lv_obj_refr_size(lv_obj_t * obj)
             }
         }
 
-        int32_t minw = lv_obj_get_style_min_width(obj, LV_PART_MAIN);
-        int32_t maxw = lv_obj_get_style_max_width(obj, LV_PART_MAIN);
         w = lv_clamp_width(w, minw, maxw, parent_w);
     }
 
@@ -135,7 +142,13 @@ bool lv_obj_refr_size(lv_obj_t * obj)
         h = lv_obj_get_style_height(obj, LV_PART_MAIN);
         h_is_content = h == LV_SIZE_CONTENT;
         h_is_pct = LV_COORD_IS_PCT(h);
-        int32_t parent_h = lv_obj_get_content_height(parent);
+        int32_t minh = lv_obj_get_style_min_height(obj, LV_PART_MAIN);
+        int32_t maxh = lv_obj_get_style_max_height(obj, LV_PART_MAIN);
+
+        int32_t parent_h = 0;
+        if(h_is_pct || LV_COORD_IS_PCT(minh) || LV_COORD_IS_PCT(maxh)) {
+            parent_h = lv_obj_get_content_height(parent);
+        }
 
         if(h_is_content) {
             h = calc_content_height(obj);
@@ -152,8 +165,6 @@ bool lv_obj_refr_size(lv_obj_t * obj)
             }
         }
 
-        int32_t minh = lv_obj_get_style_min_height(obj, LV_PART_MAIN);
-        int32_t maxh = lv_obj_get_style_max_height(obj, LV_PART_MAIN);
         h = lv_clamp_height(h, minh, maxh, parent_h);
     }
 
@@ -161,6 +172,10 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     /*It is very important else recursive resizing can occur without size change*/
     if(lv_obj_get_width(obj) == w && lv_obj_get_height(obj) == h) return false;
 
+#if LV_USE_INDEV_HIT_INDEX
+    lv_indev_hit_index_invalidate();
+#endif
+
     /*Invalidate the original area*/
     lv_obj_invalidate(obj);
 
@@ -197,6 +212,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     lv_obj_invalidate(obj);
 
     obj->readjust_scroll_after_layout = 1;
+    mark_layout_path(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -280,6 +296,7 @@ bool lv_obj_is_layout_positioned(const lv_obj_t * obj)
 void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
     obj->layout_inv = 1;
+    mark_layout_path(obj);
 
     /*Mark the screen as dirty too to mark that there is something to do on this screen*/
     lv_obj_t * scr = lv_obj_get_screen(obj);
@@ -713,6 +730,10 @@ void lv_obj_move_to(lv_obj_t * obj, int32_t x, int32_t y)
      *occur without position change*/
     if(diff.x == 0 && diff.y == 0) return;
 
+#if LV_USE_INDEV_HIT_INDEX
+    lv_indev_hit_index_invalidate();
+#endif
+
     /*Invalidate the original area*/
     lv_obj_invalidate(obj);
 
@@ -755,6 +776,10 @@ void lv_obj_move_to(lv_obj_t * obj, int32_t x, int32_t y)
 
 void lv_obj_move_children_by(lv_obj_t * obj, int32_t x_diff, int32_t y_diff, bool ignore_floating)
 {
+#if LV_USE_INDEV_HIT_INDEX
+    lv_indev_hit_index_invalidate();
+#endif
+
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_count(obj);
     for(i = 0; i < child_cnt; i++) {
@@ -923,6 +948,10 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, int32_t size)
 
     lv_obj_allocate_spec_attr(obj);
     obj->spec_attr->ext_click_pad = size;
+
+#if LV_USE_INDEV_HIT_INDEX
+    lv_indev_hit_index_invalidate();
+#endif
 }
 
 void lv_obj_get_click_area(const lv_obj_t * obj, lv_area_t * area)
@@ -1127,9 +1156,17 @@ static void layout_update_core(lv_obj_t * obj)
 {
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_count(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+
+    /*Go down only to the children which have something to update in their subtree.
+     *Clear the flag first as updating the children can mark the other children again.*/
+    if(obj->layout_child_inv) {
+        obj->layout_child_inv = 0;
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            if(child->layout_inv || child->layout_child_inv || child->readjust_scroll_after_layout) {
+                layout_update_core(child);
+            }
+        }
     }
 
     if(obj->layout_inv) {
@@ -1148,6 +1185,19 @@ static void layout_update_core(lv_obj_t * obj)
     }
 }
 
+/**
+ * Mark the parents of an object so that `layout_update_core` visits it
+ * @param obj   an object with `layout_inv` or `readjust_scroll_after_layout` set
+ */
+static void mark_layout_path(lv_obj_t * obj)
+{
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent && !parent->layout_child_inv) {
+        parent->layout_child_inv = 1;
+        parent = lv_obj_get_parent(parent);
+    }
+}
+
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv)
 {
     int32_t angle = lv_obj_get_style_transform_rotation(obj, 0);
@@ -54,6 +54,9 @@ struct lv_obj_t {
 #if LV_OBJ_STYLE_CACHE
     uint32_t style_main_prop_is_set;
     uint32_t style_other_prop_is_set;
+#endif
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    lv_obj_style_prop_cache_t * style_prop_cache;   /**< Resolved style properties, allocated on first use*/
 #endif
     void * user_data;
 #if LV_USE_OBJ_ID
@@ -63,6 +66,7 @@ struct lv_obj_t {
     lv_obj_flag_t flags;
     lv_state_t state;
     uint16_t layout_inv : 1;
+    uint16_t layout_child_inv : 1;      /**< A descendant has `layout_inv` or `readjust_scroll_after_layout` set*/
     uint16_t readjust_scroll_after_layout : 1;
     uint16_t scr_layout_inv : 1;
     uint16_t skip_trans : 1;
@@ -70,6 +74,8 @@ struct lv_obj_t {
     uint16_t h_layout   : 1;
     uint16_t w_layout   : 1;
     uint16_t is_deleting : 1;
+    uint16_t style_refr_pending : 1;    /**< In the batch of postponed style refreshes*/
+    uint16_t occluded : 1;              /**< Covered by an opaque widget on the area being refreshed*/
 };
 
 
@@ -10,6 +10,8 @@
 #include "../misc/lv_anim_private.h"
 #include "lv_obj_style_private.h"
 #include "lv_obj_class_private.h"
+#include "lv_obj_draw_private.h"
+#include "../indev/lv_indev_hit_index_private.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../misc/lv_color.h"
@@ -20,14 +22,34 @@
  *********************/
 #define MY_CLASS (&lv_obj_class)
 #define style_refr LV_GLOBAL_DEFAULT()->style_refresh
+#define refr_batch_depth LV_GLOBAL_DEFAULT()->style_refr_batch_depth
+#define refr_batch LV_GLOBAL_DEFAULT()->style_refr_batch
+#define refr_batch_cnt LV_GLOBAL_DEFAULT()->style_refr_batch_cnt
+#define refr_batch_size LV_GLOBAL_DEFAULT()->style_refr_batch_size
 #define style_trans_ll_p &(LV_GLOBAL_DEFAULT()->style_trans_ll)
 #define _style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define STYLE_PROP_SHIFTED(prop) ((uint32_t)1 << ((prop) >> 3))
 
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+#if (LV_OBJ_STYLE_PROP_CACHE_CNT & (LV_OBJ_STYLE_PROP_CACHE_CNT - 1)) != 0
+#error "LV_OBJ_STYLE_PROP_CACHE_CNT must be a power of 2"
+#endif
+#define PROP_CACHE_MASK (LV_OBJ_STYLE_PROP_CACHE_CNT - 1)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*What `lv_obj_refresh_style()` has to do besides invalidating the object*/
+typedef enum {
+    REFR_STYLE_CHANGED  = 0x01,  /*Send LV_EVENT_STYLE_CHANGED and mark the layout as dirty*/
+    REFR_PARENT_LAYOUT  = 0x02,  /*Mark the parent's layout as dirty*/
+    REFR_LAYER_TYPE     = 0x04,  /*Update the cached layer type*/
+    REFR_EXT_DRAW       = 0x08,  /*Refresh the extra draw size*/
+    REFR_CHILDREN       = 0x10,  /*Refresh the style of the children*/
+} refr_flag_t;
+
 typedef struct {
     lv_obj_t * obj;
     lv_style_prop_t prop;
@@ -55,6 +77,12 @@ static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector
 static lv_obj_style_t * get_trans_style(lv_obj_t * obj, lv_part_t part);
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                     lv_style_value_t * v);
+static lv_style_res_t get_prop_from_styles(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
+                                           lv_style_value_t * v);
+static void prop_cache_invalidate(lv_obj_t * obj);
+static uint32_t get_refresh_flags(lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop);
+static void refresh_style_flags(lv_obj_t * obj, uint32_t flags);
+static bool refresh_batch_add(lv_obj_t * obj, uint32_t flags);
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
 static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
@@ -89,6 +117,11 @@ void lv_obj_style_init(void)
 void lv_obj_style_deinit(void)
 {
     lv_ll_clear(style_trans_ll_p);
+    lv_free(refr_batch);
+    refr_batch = NULL;
+    refr_batch_cnt = 0;
+    refr_batch_size = 0;
+    refr_batch_depth = 0;
     if(_style_custom_prop_flag_lookup_table != NULL) {
         lv_free(_style_custom_prop_flag_lookup_table);
         _style_custom_prop_flag_lookup_table = NULL;
@@ -135,6 +168,8 @@ void lv_obj_add_style(lv_obj_t * obj, const lv_style_t * style, lv_style_selecto
     obj->styles[i].style = style;
     obj->styles[i].selector = selector;
 
+    prop_cache_invalidate(obj);
+
 #if LV_OBJ_STYLE_CACHE
     uint32_t * prop_is_set = part == LV_PART_MAIN ? &obj->style_main_prop_is_set : &obj->style_other_prop_is_set;
     if(lv_style_is_const(style)) {
@@ -278,44 +313,48 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 
     if(!style_refr) return;
 
-    lv_obj_invalidate(obj);
-
-    lv_part_t part = lv_obj_style_get_selector_part(selector);
+    uint32_t flags = get_refresh_flags(obj, selector, prop);
+    if(refr_batch_depth > 0 && refresh_batch_add(obj, flags)) return;
 
-    bool is_layout_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYOUT_UPDATE);
-    bool is_ext_draw = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_EXT_DRAW_UPDATE);
-    bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE);
-    bool is_layer_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYER_UPDATE);
+    lv_obj_invalidate(obj);
+    refresh_style_flags(obj, flags);
+}
 
-    if(is_layout_refr) {
-        if(part == LV_PART_ANY ||
-           part == LV_PART_MAIN ||
-           lv_obj_get_style_height(obj, 0) == LV_SIZE_CONTENT ||
-           lv_obj_get_style_width(obj, 0) == LV_SIZE_CONTENT) {
-            lv_obj_send_event(obj, LV_EVENT_STYLE_CHANGED, NULL);
-            lv_obj_mark_layout_as_dirty(obj);
-        }
-    }
-    if((part == LV_PART_ANY || part == LV_PART_MAIN) && (prop == LV_STYLE_PROP_ANY || is_layout_refr)) {
-        lv_obj_t * parent = lv_obj_get_parent(obj);
-        if(parent) lv_obj_mark_layout_as_dirty(parent);
-    }
+void lv_obj_style_refresh_batch_start(void)
+{
+    refr_batch_depth++;
+}
 
-    /*Cache the layer type*/
-    if((part == LV_PART_ANY || part == LV_PART_MAIN) && is_layer_refr) {
-        lv_obj_update_layer_type(obj);
+void lv_obj_style_refresh_batch_end(void)
+{
+    LV_ASSERT(refr_batch_depth > 0);
+    refr_batch_depth--;
+    if(refr_batch_depth > 0) return;
+
+    /*Take the objects from the end: the refreshes can delete objects of the batch
+     *which removes them from the array*/
+    while(refr_batch_cnt > 0) {
+        refr_batch_cnt--;
+        lv_obj_t * obj = refr_batch[refr_batch_cnt].obj;
+        uint32_t flags = refr_batch[refr_batch_cnt].flags;
+        obj->style_refr_pending = 0;
+        refresh_style_flags(obj, flags);
     }
+}
 
-    if(prop == LV_STYLE_PROP_ANY || is_ext_draw) {
-        lv_obj_refresh_ext_draw_size(obj);
-    }
-    lv_obj_invalidate(obj);
+void lv_obj_style_refresh_batch_remove(lv_obj_t * obj)
+{
+    if(!obj->style_refr_pending) return;
 
-    if(prop == LV_STYLE_PROP_ANY || (is_inheritable && (is_ext_draw || is_layout_refr))) {
-        if(part != LV_PART_SCROLLBAR) {
-            refresh_children_style(obj);
+    uint32_t i;
+    for(i = 0; i < refr_batch_cnt; i++) {
+        if(refr_batch[i].obj == obj) {
+            refr_batch_cnt--;
+            refr_batch[i] = refr_batch[refr_batch_cnt];
+            break;
         }
     }
+    obj->style_refr_pending = 0;
 }
 
 void lv_obj_enable_style_refresh(bool en)
@@ -357,11 +396,15 @@ void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_
     trans_delete(obj, lv_obj_style_get_selector_part(selector), prop, NULL);
 
     lv_style_t * style = get_local_style(obj, selector);
-    if(selector == LV_PART_MAIN && lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_TRANSFORM)) {
+    /*Invalidate the area with the old transformation.
+     *If a refresh is already postponed, that area was invalidated already and nothing was drawn since then.*/
+    if(selector == LV_PART_MAIN && lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_TRANSFORM) &&
+       !obj->style_refr_pending) {
         lv_obj_invalidate(obj);
     }
 
     lv_style_set_prop(style, prop, value);
+    prop_cache_invalidate(obj);
 
 #if LV_OBJ_STYLE_CACHE
     uint32_t prop_shifted = STYLE_PROP_SHIFTED(prop);
@@ -435,6 +478,7 @@ void lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t p
 
     lv_obj_style_t * style_trans = get_trans_style(obj, part);
     lv_style_set_prop((lv_style_t *)style_trans->style, tr_dsc->prop, v1);  /*Be sure `trans_style` has a valid value*/
+    prop_cache_invalidate(obj);
     lv_obj_refresh_style(obj, tr_dsc->selector, tr_dsc->prop);
 
     if(tr_dsc->prop == LV_STYLE_RADIUS) {
@@ -611,6 +655,9 @@ lv_opa_t lv_obj_get_style_opa_recursive(const lv_obj_t * obj, lv_part_t part)
 void lv_obj_update_layer_type(lv_obj_t * obj)
 {
     lv_layer_type_t layer_type = calculate_layer_type(obj);
+#if LV_USE_INDEV_HIT_INDEX
+    if(layer_type != lv_obj_get_layer_type(obj)) lv_indev_hit_index_invalidate();
+#endif
     if(obj->spec_attr) obj->spec_attr->layer_type = layer_type;
     else if(layer_type != LV_LAYER_TYPE_NONE) {
         lv_obj_allocate_spec_attr(obj);
@@ -697,7 +744,34 @@ static lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t sel
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                     lv_style_value_t * v)
 {
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    /*Transitions are skipped only temporarily, don't mix these results into the cache*/
+    if(obj->skip_trans) return get_prop_from_styles(obj, selector, prop, v);
+
+    lv_obj_style_prop_cache_t * cache = obj->style_prop_cache;
+    if(cache == NULL) return get_prop_from_styles(obj, selector, prop, v);
+
+    uint32_t h = prop ^ (selector >> 16) ^ (selector << 3);
+    lv_obj_style_prop_cache_t * entry = &cache[(h ^ (h >> 5)) & PROP_CACHE_MASK];
+    if(entry->prop == prop && entry->selector == selector) {
+        if(entry->res == LV_STYLE_RES_FOUND) *v = entry->value;
+        return entry->res;
+    }
 
+    lv_style_res_t res = get_prop_from_styles(obj, selector, prop, v);
+    entry->prop = prop;
+    entry->selector = selector;
+    entry->res = res;
+    if(res == LV_STYLE_RES_FOUND) entry->value = *v;
+    return res;
+#else
+    return get_prop_from_styles(obj, selector, prop, v);
+#endif
+}
+
+static lv_style_res_t get_prop_from_styles(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
+                                           lv_style_value_t * v)
+{
     const uint32_t group = (uint32_t)1 << lv_style_get_prop_group(prop);
     const lv_part_t part = lv_obj_style_get_selector_part(selector);
     const lv_state_t state = lv_obj_style_get_selector_state(selector);
@@ -770,6 +844,112 @@ static void report_style_change_core(void * style, lv_obj_t * obj)
     }
 }
 
+/**
+ * Tell what has to be refreshed on an object when a style property changes
+ * @param obj       pointer to an object
+ * @param selector  the part and state of the changed style
+ * @param prop      the changed property or `LV_STYLE_PROP_ANY`
+ * @return          OR-ed `refr_flag_t` values
+ */
+static uint32_t get_refresh_flags(lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
+{
+    lv_part_t part = lv_obj_style_get_selector_part(selector);
+    bool is_main = part == LV_PART_ANY || part == LV_PART_MAIN;
+
+    bool is_layout_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYOUT_UPDATE);
+    bool is_ext_draw = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_EXT_DRAW_UPDATE);
+    bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE);
+    bool is_layer_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYER_UPDATE);
+
+    uint32_t flags = 0;
+    if(is_layout_refr) {
+        if(is_main ||
+           lv_obj_get_style_height(obj, 0) == LV_SIZE_CONTENT ||
+           lv_obj_get_style_width(obj, 0) == LV_SIZE_CONTENT) {
+            flags |= REFR_STYLE_CHANGED;
+        }
+    }
+    if(is_main && (prop == LV_STYLE_PROP_ANY || is_layout_refr)) flags |= REFR_PARENT_LAYOUT;
+    if(is_main && is_layer_refr) flags |= REFR_LAYER_TYPE;
+    if(prop == LV_STYLE_PROP_ANY || is_ext_draw) flags |= REFR_EXT_DRAW;
+    if(prop == LV_STYLE_PROP_ANY || (is_inheritable && (is_ext_draw || is_layout_refr))) {
+        if(part != LV_PART_SCROLLBAR) flags |= REFR_CHILDREN;
+    }
+
+    return flags;
+}
+
+/**
+ * Refresh an object after a style change: the new area is always invalidated
+ * @param obj       pointer to an object
+ * @param flags     what to refresh, OR-ed `refr_flag_t` values (see `get_refresh_flags()`)
+ */
+static void refresh_style_flags(lv_obj_t * obj, uint32_t flags)
+{
+    if(flags & REFR_STYLE_CHANGED) {
+        lv_obj_send_event(obj, LV_EVENT_STYLE_CHANGED, NULL);
+        lv_obj_mark_layout_as_dirty(obj);
+    }
+    if(flags & REFR_PARENT_LAYOUT) {
+        lv_obj_t * parent = lv_obj_get_parent(obj);
+        if(parent) lv_obj_mark_layout_as_dirty(parent);
+    }
+
+    /*Cache the layer type*/
+    if(flags & REFR_LAYER_TYPE) {
+        lv_obj_update_layer_type(obj);
+    }
+
+    if(flags & REFR_EXT_DRAW) {
+        lv_obj_refresh_ext_draw_size(obj);
+    }
+    lv_obj_invalidate(obj);
+
+    if(flags & REFR_CHILDREN) {
+        refresh_children_style(obj);
+    }
+}
+
+/**
+ * Add an object to the batch of postponed style refreshes
+ * @param obj       pointer to an object
+ * @param flags     what to refresh, OR-ed `refr_flag_t` values
+ * @return          true: the refresh is postponed; false: out of memory, refresh it now
+ */
+static bool refresh_batch_add(lv_obj_t * obj, uint32_t flags)
+{
+    if(obj->style_refr_pending) {
+        /*Usually the animations of an object run one after the other, so search from the end*/
+        uint32_t i = refr_batch_cnt;
+        while(i > 0) {
+            i--;
+            if(refr_batch[i].obj == obj) {
+                refr_batch[i].flags |= flags;
+                return true;
+            }
+        }
+        LV_ASSERT(0);   /*Flagged as pending but not in the batch*/
+        return false;
+    }
+
+    if(refr_batch_cnt >= refr_batch_size) {
+        uint32_t new_size = refr_batch_size ? refr_batch_size * 2 : 8;
+        lv_obj_style_refr_batch_t * new_batch = lv_realloc(refr_batch, new_size * sizeof(lv_obj_style_refr_batch_t));
+        if(new_batch == NULL) return false;
+        refr_batch = new_batch;
+        refr_batch_size = new_size;
+    }
+
+    refr_batch[refr_batch_cnt].obj = obj;
+    refr_batch[refr_batch_cnt].flags = flags;
+    refr_batch_cnt++;
+    obj->style_refr_pending = 1;
+
+    /*Invalidate the current area now, the new one is invalidated at the end of the batch*/
+    lv_obj_invalidate(obj);
+    return true;
+}
+
 /**
  * Recursively refresh the style of the children. Go deeper until a not NULL style is found
  * because the NULL styles are inherited from the parent
@@ -819,6 +999,7 @@ static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, t
                     lv_style_remove_prop((lv_style_t *)obj->styles[i].style, tr->prop);
                 }
             }
+            prop_cache_invalidate(obj);
 
             /*Free the transition descriptor too*/
             lv_anim_delete(tr, NULL);
@@ -889,7 +1070,10 @@ static void trans_anim_cb(void * _tr, int32_t v)
             }
         }
         lv_style_set_prop((lv_style_t *)obj->styles[i].style, tr->prop, value_final);
-        if(refr) lv_obj_refresh_style(tr->obj, tr->selector, tr->prop);
+        if(refr) {
+            prop_cache_invalidate(obj);
+            lv_obj_refresh_style(tr->obj, tr->selector, tr->prop);
+        }
         break;
 
     }
@@ -915,6 +1099,7 @@ static void trans_anim_start_cb(lv_anim_t * a)
     lv_obj_style_t * style_trans = get_trans_style(tr->obj, tr->selector);
     /*Be sure `trans_style` has a valid value*/
     lv_style_set_prop((lv_style_t *)style_trans->style, tr->prop, tr->start_value);
+    prop_cache_invalidate(tr->obj);
     lv_obj_refresh_style(tr->obj, tr->selector, tr->prop);
 
 }
@@ -946,6 +1131,7 @@ static void trans_anim_completed_cb(lv_anim_t * a)
 
                 lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop((lv_style_t *)obj_style->style, prop);
+                prop_cache_invalidate(obj);
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, (lv_style_t *)obj_style->style, obj_style->selector);
@@ -972,6 +1158,8 @@ static lv_layer_type_t calculate_layer_type(lv_obj_t * obj)
 
 static void full_cache_refresh(lv_obj_t * obj, lv_part_t part)
 {
+    prop_cache_invalidate(obj);
+
 #if LV_OBJ_STYLE_CACHE
     uint32_t i;
     if(part == LV_PART_MAIN || part == LV_PART_ANY) {
@@ -1015,11 +1203,27 @@ static void full_cache_refresh(lv_obj_t * obj, lv_part_t part)
         }
     }
 #else
-    LV_UNUSED(obj);
     LV_UNUSED(part);
 #endif
 }
 
+static void prop_cache_invalidate(lv_obj_t * obj)
+{
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    /*Allocate the cache when the first style is added, not in the getters which get a const object.
+     *Without the cache (e.g. no memory) the properties are looked up in the styles.*/
+    if(obj->style_prop_cache == NULL && obj->style_cnt > 0) {
+        obj->style_prop_cache = lv_malloc(sizeof(lv_obj_style_prop_cache_t) * LV_OBJ_STYLE_PROP_CACHE_CNT);
+    }
+
+    if(obj->style_prop_cache) {
+        lv_memzero(obj->style_prop_cache, sizeof(lv_obj_style_prop_cache_t) * LV_OBJ_STYLE_PROP_CACHE_CNT);
+    }
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
 static void fade_anim_cb(void * obj, int32_t v)
 {
     lv_obj_set_style_opa(obj, v, 0);
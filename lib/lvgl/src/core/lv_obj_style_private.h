@@ -31,6 +31,23 @@ struct lv_obj_style_t {
     uint32_t is_trans : 1;
 };
 
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+/** An entry of the per object style property cache. Stores the result of looking up `prop`
+ * in the object's own style list for `selector` (part | state), inheritance not included.*/
+struct lv_obj_style_prop_cache_t {
+    lv_style_value_t value;
+    lv_style_selector_t selector;
+    lv_style_prop_t prop;   /**< LV_STYLE_PROP_INV if the entry is empty*/
+    uint8_t res;            /**< Element of `lv_style_res_t`*/
+};
+#endif
+
+/** An object whose style refresh is postponed by `lv_obj_style_refresh_batch_start()`*/
+struct lv_obj_style_refr_batch_t {
+    lv_obj_t * obj;
+    uint32_t flags;         /**< What to refresh, OR-ed from all the refresh requests of the batch*/
+};
+
 struct lv_obj_style_transition_dsc_t {
     uint16_t time;
     uint16_t delay;
@@ -57,6 +74,26 @@ void lv_obj_style_init(void);
  */
 void lv_obj_style_deinit(void);
 
+/**
+ * Postpone the style refreshes (see `lv_obj_refresh_style()`) until `lv_obj_style_refresh_batch_end()`.
+ * The area of the objects is invalidated on the first refresh request, the rest
+ * (events, layout, extra draw size, children) is done once per object at the end.
+ * Used e.g. by the animations to handle all the property changes of a frame in one pass.
+ * Calls can be nested.
+ */
+void lv_obj_style_refresh_batch_start(void);
+
+/**
+ * Do the postponed style refreshes when the outermost batch ends
+ */
+void lv_obj_style_refresh_batch_end(void);
+
+/**
+ * Forget the postponed style refresh of an object. Called when the object is deleted.
+ * @param obj       pointer to an object
+ */
+void lv_obj_style_refresh_batch_remove(lv_obj_t * obj);
+
 /**
  * Used internally to create a style transition
  * @param obj
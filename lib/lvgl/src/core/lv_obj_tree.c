@@ -10,6 +10,7 @@
 #include "lv_obj_class_private.h"
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_private.h"
+#include "../indev/lv_indev_hit_index_private.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../misc/lv_anim_private.h"
@@ -161,6 +162,10 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
 
     lv_obj_invalidate(obj);
 
+#if LV_USE_INDEV_HIT_INDEX
+    lv_indev_hit_index_invalidate();
+#endif
+
     lv_obj_allocate_spec_attr(parent);
 
     lv_obj_t * old_parent = obj->parent;
@@ -246,6 +251,9 @@ void lv_obj_move_to_index(lv_obj_t * obj, int32_t index)
     }
 
     parent->spec_attr->children[index] = obj;
+#if LV_USE_INDEV_HIT_INDEX
+    lv_indev_hit_index_invalidate();
+#endif
     lv_obj_send_event(parent, LV_EVENT_CHILD_CHANGED, NULL);
     lv_obj_invalidate(parent);
 }
@@ -269,6 +277,9 @@ void lv_obj_swap(lv_obj_t * obj1, lv_obj_t * obj2)
 
     parent2->spec_attr->children[index2] = obj1;
     obj1->parent = parent2;
+#if LV_USE_INDEV_HIT_INDEX
+    lv_indev_hit_index_invalidate();
+#endif
 
     lv_obj_send_event(parent, LV_EVENT_CHILD_CHANGED, obj2);
     lv_obj_send_event(parent, LV_EVENT_CHILD_CREATED, obj2);
@@ -508,6 +519,10 @@ static void obj_delete_core(lv_obj_t * obj)
 
     obj->is_deleting = true;
 
+#if LV_USE_INDEV_HIT_INDEX
+    lv_indev_hit_index_invalidate();
+#endif
+
     /*Let the user free the resources used in `LV_EVENT_DELETE`*/
     lv_result_t res = lv_obj_send_event(obj, LV_EVENT_DELETE, NULL);
     if(res == LV_RESULT_INVALID) {
@@ -32,9 +32,24 @@
 /*Display being refreshed*/
 #define disp_refr LV_GLOBAL_DEFAULT()->disp_refresh
 
+#if LV_USE_REFR_OCCLUSION
+/*Number of opaque areas collected per refreshed area to hide the widgets below them*/
+#define OCCLUDER_MAX 8
+
+#define occluded_objs LV_GLOBAL_DEFAULT()->refr_occluded
+#define occluded_objs_cnt LV_GLOBAL_DEFAULT()->refr_occluded_cnt
+#define occluded_objs_size LV_GLOBAL_DEFAULT()->refr_occluded_size
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_REFR_OCCLUSION
+typedef struct {
+    lv_area_t areas[OCCLUDER_MAX];  /**< Areas fully covered by widgets drawn later*/
+    uint32_t cnt;
+} occluders_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -51,6 +66,16 @@ static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
 static void draw_buf_flush(lv_display_t * disp);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 static void wait_for_flushing(lv_display_t * disp);
+#if LV_USE_REFR_OCCLUSION
+static void occlusion_mark(lv_layer_t * layer, lv_obj_t * top_obj);
+static void occlusion_mark_younger(occluders_t * occ, lv_obj_t * border, const lv_area_t * clip);
+static void occlusion_mark_obj(occluders_t * occ, lv_obj_t * obj, const lv_area_t * clip, bool opaque_parents);
+static void occlusion_clear(void);
+#if LV_USE_PERF_MONITOR
+static uint32_t occlusion_count_draw_tasks(lv_layer_t * layer, lv_obj_t * obj);
+static uint32_t occlusion_count_draw_tasks_core(lv_layer_t * layer, lv_obj_t * obj);
+#endif
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -78,6 +103,12 @@ void lv_refr_init(void)
 
 void lv_refr_deinit(void)
 {
+#if LV_USE_REFR_OCCLUSION
+    lv_free(occluded_objs);
+    occluded_objs = NULL;
+    occluded_objs_cnt = 0;
+    occluded_objs_size = 0;
+#endif
 }
 
 void lv_refr_now(lv_display_t * disp)
@@ -376,6 +407,10 @@ void lv_display_refr_timer(lv_timer_t * tmr)
 
     lv_display_send_event(disp_refr, LV_EVENT_REFR_START, NULL);
 
+#if LV_USE_REFR_OCCLUSION && LV_USE_PERF_MONITOR
+    disp_refr->occluded_task_cnt = 0;
+#endif
+
     /*Refresh the screen's layout if required*/
     LV_PROFILER_BEGIN_TAG("layout");
     lv_obj_update_layout(disp_refr->act_scr);
@@ -421,10 +456,6 @@ void lv_display_refr_timer(lv_timer_t * tmr)
 
 refr_finish:
 
-#if LV_DRAW_SW_COMPLEX == 1
-    lv_draw_sw_mask_cleanup();
-#endif
-
     lv_display_send_event(disp_refr, LV_EVENT_REFR_READY, NULL);
 
     LV_TRACE_REFR("finished");
@@ -727,6 +758,12 @@ static void refr_area_part(lv_layer_t * layer)
         top_prev_scr = lv_refr_get_top_obj(&layer->_clip_area, disp_refr->prev_scr);
     }
 
+#if LV_USE_REFR_OCCLUSION
+    /*During screen animations two screens are drawn, don't bother with them*/
+    bool occlusion = disp_refr->prev_scr == NULL;
+    if(occlusion) occlusion_mark(layer, top_act_scr);
+#endif
+
     /*Draw a bottom layer background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
         refr_obj_and_children(layer, lv_display_get_layer_bottom(disp_refr));
@@ -757,6 +794,10 @@ static void refr_area_part(lv_layer_t * layer)
     refr_obj_and_children(layer, lv_display_get_layer_top(disp_refr));
     refr_obj_and_children(layer, lv_display_get_layer_sys(disp_refr));
 
+#if LV_USE_REFR_OCCLUSION
+    if(occlusion) occlusion_clear();
+#endif
+
     draw_buf_flush(disp_refr);
     LV_PROFILER_END;
 }
@@ -1016,6 +1057,15 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
 {
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
 
+#if LV_USE_REFR_OCCLUSION
+    if(obj->occluded) {
+#if LV_USE_PERF_MONITOR
+        disp_refr->occluded_task_cnt += occlusion_count_draw_tasks(layer, obj);
+#endif
+        return;
+    }
+#endif
+
     lv_opa_t opa = lv_obj_get_style_opa_layered(obj, 0);
     if(opa < LV_OPA_MIN) return;
 
@@ -1237,3 +1287,231 @@ static void wait_for_flushing(lv_display_t * disp)
     LV_LOG_TRACE("end");
     LV_PROFILER_END;
 }
+
+#if LV_USE_REFR_OCCLUSION
+
+/**
+ * Mark the widgets which would be fully overdrawn by opaque widgets on the area being refreshed.
+ * The widgets are visited in the reverse order of drawing, so when a widget is checked
+ * the collected opaque areas belong to widgets drawn after it and its children.
+ * @param layer         the layer being refreshed
+ * @param top_obj       the top object found by `lv_refr_get_top_obj` on the active screen or NULL
+ */
+static void occlusion_mark(lv_layer_t * layer, lv_obj_t * top_obj)
+{
+    LV_PROFILER_BEGIN_TAG("occlusion");
+
+    occluders_t occ;
+    occ.cnt = 0;
+
+    /*The top and sys layers are drawn last, with the area's clip area as `refr_obj_and_children` does*/
+    const lv_area_t * clip = &layer->_clip_area;
+    occlusion_mark_obj(&occ, lv_display_get_layer_sys(disp_refr), clip, true);
+    occlusion_mark_obj(&occ, lv_display_get_layer_top(disp_refr), clip, true);
+
+    lv_obj_t * start_obj = top_obj ? top_obj : disp_refr->act_scr;
+    occlusion_mark_younger(&occ, start_obj, clip);
+    occlusion_mark_obj(&occ, start_obj, clip, lv_obj_get_style_opa_recursive(start_obj, LV_PART_MAIN) >= LV_OPA_MAX);
+
+    if(top_obj == NULL) occlusion_mark_obj(&occ, lv_display_get_layer_bottom(disp_refr), clip, true);
+
+    LV_PROFILER_END_TAG("occlusion");
+}
+
+/**
+ * Visit the younger siblings of `border` and its parents, drawn after `border` by `refr_obj_and_children`
+ * @param occ       the opaque areas found so far
+ * @param border    the object whose younger siblings should be visited
+ * @param clip      the clip area of the refreshed area
+ */
+static void occlusion_mark_younger(occluders_t * occ, lv_obj_t * border, const lv_area_t * clip)
+{
+    lv_obj_t * parent = lv_obj_get_parent(border);
+    if(parent == NULL) return;
+
+    /*The siblings of the parents are drawn later*/
+    occlusion_mark_younger(occ, parent, clip);
+
+    bool opaque_parents = lv_obj_get_style_opa_recursive(parent, LV_PART_MAIN) >= LV_OPA_MAX;
+    int32_t i;
+    for(i = lv_obj_get_child_count(parent) - 1; i >= 0; i--) {
+        lv_obj_t * child = parent->spec_attr->children[i];
+        if(child == border) break;
+        occlusion_mark_obj(occ, child, clip, opaque_parents);
+    }
+}
+
+/**
+ * Mark an object if an opaque area covers it, else visit its children and
+ * add the object to the opaque areas if it covers its area.
+ * @param occ               the opaque areas found so far
+ * @param obj               the object to check
+ * @param clip              the clip area `obj` is drawn with
+ * @param opaque_parents    true: the parents of `obj` don't make it transparent
+ */
+static void occlusion_mark_obj(occluders_t * occ, lv_obj_t * obj, const lv_area_t * clip, bool opaque_parents)
+{
+    /*Use the same conditions as `refr_obj` and `lv_obj_redraw`*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+    if(lv_obj_get_style_opa_layered(obj, 0) < LV_OPA_MIN) return;
+
+    /*Transformed widgets are drawn somewhere else than their coordinates*/
+    lv_layer_type_t layer_type = lv_obj_get_layer_type(obj);
+    if(layer_type == LV_LAYER_TYPE_TRANSFORM) return;
+
+    lv_area_t obj_coords_ext;
+    lv_obj_get_coords(obj, &obj_coords_ext);
+    int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&obj_coords_ext, ext_draw_size, ext_draw_size);
+
+    lv_area_t draw_area;
+    if(!lv_area_intersect(&draw_area, clip, &obj_coords_ext)) return;
+
+    uint32_t i;
+    for(i = 0; i < occ->cnt; i++) {
+        if(lv_area_is_in(&draw_area, &occ->areas[i], 0)) {
+            if(occluded_objs_cnt >= occluded_objs_size) {
+                uint32_t new_size = occluded_objs_size ? occluded_objs_size * 2 : 16;
+                lv_obj_t ** new_objs = lv_realloc(occluded_objs, new_size * sizeof(lv_obj_t *));
+                if(new_objs == NULL) return;
+                occluded_objs = new_objs;
+                occluded_objs_size = new_size;
+            }
+            occluded_objs[occluded_objs_cnt] = obj;
+            occluded_objs_cnt++;
+            obj->occluded = 1;
+            return;
+        }
+    }
+
+    /*The children of layers and masked widgets are not checked*/
+    if(layer_type != LV_LAYER_TYPE_NONE) return;
+    if(lv_obj_get_style_clip_corner(obj, LV_PART_MAIN) && lv_obj_get_style_radius(obj, LV_PART_MAIN) != 0) return;
+
+    bool opaque = opaque_parents && lv_obj_get_style_opa(obj, LV_PART_MAIN) >= LV_OPA_MAX;
+
+    lv_area_t clip_coords_for_children;
+    const lv_area_t * obj_coords = lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE) ? &obj_coords_ext : &obj->coords;
+    if(lv_area_intersect(&clip_coords_for_children, clip, obj_coords)) {
+        int32_t c;
+        for(c = lv_obj_get_child_count(obj) - 1; c >= 0; c--) {
+            occlusion_mark_obj(occ, obj->spec_attr->children[c], &clip_coords_for_children, opaque);
+        }
+    }
+
+    /*The children are drawn after the object, so it can hide only the widgets visited later*/
+    if(!opaque || occ->cnt >= OCCLUDER_MAX) return;
+
+    lv_area_t cover_area;
+    if(!lv_area_intersect(&cover_area, clip, &obj->coords)) return;
+    for(i = 0; i < occ->cnt; i++) {
+        if(lv_area_is_in(&cover_area, &occ->areas[i], 0)) return;
+    }
+
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = &cover_area;
+    lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+    if(info.res == LV_COVER_RES_COVER) {
+        occ->areas[occ->cnt] = cover_area;
+        occ->cnt++;
+    }
+}
+
+/**
+ * Unmark the objects marked by `occlusion_mark`
+ */
+static void occlusion_clear(void)
+{
+    uint32_t i;
+    for(i = 0; i < occluded_objs_cnt; i++) {
+        occluded_objs[i]->occluded = 0;
+    }
+    occluded_objs_cnt = 0;
+}
+
+#if LV_USE_PERF_MONITOR
+
+/**
+ * Count the draw tasks that a covered widget and its children would have added, for the perf monitor.
+ * The draw events are sent with a layer which is never dispatched and the draw tasks are freed right away.
+ * @param layer     the layer where the widget would have been drawn
+ * @param obj       the covered widget
+ * @return          the number of draw tasks
+ */
+static uint32_t occlusion_count_draw_tasks(lv_layer_t * layer, lv_obj_t * obj)
+{
+    lv_layer_t count_layer;
+    lv_memzero(&count_layer, sizeof(count_layer));
+    count_layer.buf_area = layer->buf_area;
+    count_layer.color_format = layer->color_format;
+    count_layer._clip_area = layer->_clip_area;
+    count_layer.phy_clip_area = layer->phy_clip_area;
+
+    uint32_t cnt = occlusion_count_draw_tasks_core(&count_layer, obj);
+
+    lv_draw_task_t * t = count_layer.draw_task_head;
+    while(t) {
+        lv_draw_task_t * t_next = t->next;
+        lv_draw_label_dsc_t * draw_label_dsc = lv_draw_task_get_label_dsc(t);
+        if(draw_label_dsc && draw_label_dsc->text_local) lv_free((void *)draw_label_dsc->text);
+        lv_free(t->draw_dsc);
+        lv_free(t);
+        cnt++;
+        t = t_next;
+    }
+
+    return cnt;
+}
+
+/**
+ * Send the draw events of a widget and its children like `lv_obj_redraw()`.
+ * Widgets drawn on their own layer are not drawn but counted as one draw task (the layer's image).
+ * @param layer     the counting layer
+ * @param obj       pointer to a widget
+ * @return          the number of layers which were counted
+ */
+static uint32_t occlusion_count_draw_tasks_core(lv_layer_t * layer, lv_obj_t * obj)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return 0;
+    if(lv_obj_get_style_opa_layered(obj, 0) < LV_OPA_MIN) return 0;
+    if(lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return 1;
+
+    lv_area_t clip_area_ori = layer->_clip_area;
+    lv_area_t obj_coords_ext;
+    lv_obj_get_coords(obj, &obj_coords_ext);
+    int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&obj_coords_ext, ext_draw_size, ext_draw_size);
+
+    lv_area_t clip_coords_for_obj;
+    if(!lv_area_intersect(&clip_coords_for_obj, &clip_area_ori, &obj_coords_ext)) return 0;
+    layer->_clip_area = clip_coords_for_obj;
+
+    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_BEGIN, layer);
+    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN, layer);
+    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_END, layer);
+
+    uint32_t cnt = 0;
+    const lv_area_t * obj_coords = lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE) ? &obj_coords_ext : &obj->coords;
+    lv_area_t clip_coords_for_children;
+    if(lv_area_intersect(&clip_coords_for_children, &clip_area_ori, obj_coords)) {
+        layer->_clip_area = clip_coords_for_children;
+        uint32_t i;
+        uint32_t child_cnt = lv_obj_get_child_count(obj);
+        for(i = 0; i < child_cnt; i++) {
+            cnt += occlusion_count_draw_tasks_core(layer, obj->spec_attr->children[i]);
+        }
+
+        layer->_clip_area = clip_coords_for_obj;
+        lv_obj_send_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer);
+        lv_obj_send_event(obj, LV_EVENT_DRAW_POST, layer);
+        lv_obj_send_event(obj, LV_EVENT_DRAW_POST_END, layer);
+    }
+
+    layer->_clip_area = clip_area_ori;
+    return cnt;
+}
+
+#endif /*LV_USE_PERF_MONITOR*/
+
+#endif /*LV_USE_REFR_OCCLUSION*/
@@ -154,6 +154,10 @@ struct lv_display_t {
     /** The area being refreshed*/
     lv_area_t refreshed_area;
 
+#if LV_USE_REFR_OCCLUSION && LV_USE_PERF_MONITOR
+    uint32_t occluded_task_cnt;     /**< Draw tasks not added in the last refresh as their widgets were covered*/
+#endif
+
 #if LV_USE_PERF_MONITOR
     lv_obj_t * perf_label;
     lv_sysmon_backend_data_t perf_sysmon_backend;
@@ -57,6 +57,7 @@ void lv_draw_init(void)
 #if LV_USE_OS
     lv_thread_sync_init(&_draw_info.sync);
 #endif
+    lv_draw_layer_pool_init();
 }
 
 void lv_draw_deinit(void)
@@ -74,6 +75,8 @@ void lv_draw_deinit(void)
         lv_free(cur_unit);
     }
     _draw_info.unit_head = NULL;
+
+    lv_draw_layer_pool_deinit();
 }
 
 void * lv_draw_create_unit(size_t size)
@@ -215,7 +218,7 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
 
                     _draw_info.used_memory_for_layers_kb -= get_layer_size_kb(layer_size_byte);
                     LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB\n", _draw_info.used_memory_for_layers_kb);
-                    lv_draw_buf_destroy(layer_drawn->draw_buf);
+                    lv_draw_layer_pool_release(layer_drawn->draw_buf);
                     layer_drawn->draw_buf = NULL;
                 }
 
@@ -436,7 +439,7 @@ void * lv_draw_layer_alloc_buf(lv_layer_t * layer)
     int32_t h = lv_area_get_height(&layer->buf_area);
     uint32_t layer_size_byte = h * lv_draw_buf_width_to_stride(w, layer->color_format);
 
-    layer->draw_buf = lv_draw_buf_create(w, h, layer->color_format, 0);
+    layer->draw_buf = lv_draw_layer_pool_get(w, h, layer->color_format);
 
     if(layer->draw_buf == NULL) {
         LV_LOG_WARN("Allocating layer buffer failed. Try later");
@@ -20,6 +20,8 @@
 #include "../stdlib/lv_mem.h"
 #include "../stdlib/lv_string.h"
 #include "../core/lv_global.h"
+#include "../misc/cache/lv_cache.h"
+#include "../misc/cache/lv_text_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -38,6 +40,10 @@
  **********************/
 static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,  const lv_point_t * pos,
                         const lv_font_t * font, uint32_t letter, lv_draw_glyph_cb_t cb);
+static uint32_t get_next_line(const lv_draw_label_dsc_t * dsc, const lv_text_cache_data_t * lines,
+                              uint32_t line_start, int32_t max_width);
+static int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_text_cache_data_t * lines,
+                              uint32_t line_start, uint32_t line_end);
 
 /**********************
  *  STATIC VARIABLES
@@ -206,14 +212,18 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
         pos.y += dsc->hint->y;
     }
 
-    uint32_t line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL,
+    /*Reuse the line breaks of the measured text if it's cached*/
+    lv_cache_entry_t * lines_entry = lv_text_cache_acquire(dsc->text, font, dsc->letter_space, dsc->line_space, w,
                                                            dsc->flag);
+    const lv_text_cache_data_t * lines = lines_entry ? lv_cache_entry_get_data(lines_entry) : NULL;
+
+    uint32_t line_end = line_start + get_next_line(dsc, lines, line_start, w);
 
     /*Go the first visible line*/
     while(pos.y + line_height_font < draw_unit->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
-        line_end += lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_end += get_next_line(dsc, lines, line_start, w);
         pos.y += line_height;
 
         /*Save at the threshold coordinate*/
@@ -223,19 +233,22 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
             dsc->hint->coord_y    = coords->y1;
         }
 
-        if(dsc->text[line_start] == '\0') return;
+        if(dsc->text[line_start] == '\0') {
+            if(lines_entry) lv_text_cache_release(lines_entry);
+            return;
+        }
     }
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = get_line_width(dsc, lines, line_start, line_end);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = get_line_width(dsc, lines, line_start, line_end);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -346,20 +359,18 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_end += get_next_line(dsc, lines, line_start, w);
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = get_line_width(dsc, lines, line_start, line_end);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = get_line_width(dsc, lines, line_start, line_end);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -370,6 +381,7 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
     }
 
     if(draw_letter_dsc._draw_buf) lv_draw_buf_destroy(draw_letter_dsc._draw_buf);
+    if(lines_entry) lv_text_cache_release(lines_entry);
 
     LV_ASSERT_MEM_INTEGRITY();
 }
@@ -378,6 +390,35 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the length of a line from the cached line breaks if possible, else with `lv_text_get_next_line`
+ */
+static uint32_t get_next_line(const lv_draw_label_dsc_t * dsc, const lv_text_cache_data_t * lines,
+                              uint32_t line_start, int32_t max_width)
+{
+    if(lines) {
+        uint32_t len = lv_text_cache_get_next_line(lines, line_start, NULL);
+        if(len != UINT32_MAX) return len;
+    }
+
+    return lv_text_get_next_line(&dsc->text[line_start], dsc->font, dsc->letter_space, max_width, NULL, dsc->flag);
+}
+
+/**
+ * Get the width of a line from the cached widths if possible, else with `lv_text_get_width`
+ */
+static int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_text_cache_data_t * lines,
+                              uint32_t line_start, uint32_t line_end)
+{
+    if(lines) {
+        int32_t width;
+        uint32_t len = lv_text_cache_get_next_line(lines, line_start, &width);
+        if(len != UINT32_MAX && line_start + len == line_end) return width;
+    }
+
+    return lv_text_get_width(&dsc->text[line_start], line_end - line_start, dsc->font, dsc->letter_space);
+}
+
 static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,  const lv_point_t * pos,
                         const lv_font_t * font, uint32_t letter, lv_draw_glyph_cb_t cb)
 {
@@ -0,0 +1,239 @@
+/**
+ * @file lv_draw_layer_pool.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_private.h"
+#include "lv_draw_layer_pool_private.h"
+#include "../core/lv_global.h"
+#include "../stdlib/lv_string.h"
+#include "../stdlib/lv_mem.h"
+#include "../misc/lv_math.h"
+#include "../misc/lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define layer_pool LV_GLOBAL_DEFAULT()->draw_info.layer_pool
+
+/*The smallest size class. Smaller layers use buffers of this size.*/
+#define LAYER_POOL_MIN_CLASS    1024
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_DRAW_LAYER_POOL_SIZE
+typedef struct {
+    lv_draw_buf_t draw_buf;     /*Must be the first to get the entry from the buffer of the layer*/
+    void * buf;                 /*The allocated memory before alignment*/
+    uint32_t size;              /*The size class, i.e. the usable size of `buf`*/
+} layer_pool_entry_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_DRAW_LAYER_POOL_SIZE
+    static uint32_t get_size_class(uint32_t size);
+    static void * entry_buf_alloc(uint32_t size, lv_color_format_t cf);
+    static void entry_buf_free(void * buf);
+    static bool drop_oldest_idle(void);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_layer_pool_init(void)
+{
+#if LV_DRAW_LAYER_POOL_SIZE
+    lv_ll_init(&layer_pool.idle_ll, sizeof(layer_pool_entry_t));
+    lv_ll_init(&layer_pool.used_ll, sizeof(layer_pool_entry_t));
+    layer_pool.handlers = *lv_draw_buf_get_handlers();
+    lv_memzero(&layer_pool.info, sizeof(layer_pool.info));
+    layer_pool.info.max_size = LV_DRAW_LAYER_POOL_SIZE;
+#if LV_DRAW_LAYER_POOL_ADR
+    layer_pool.tlsf = lv_tlsf_create_with_pool((void *)LV_DRAW_LAYER_POOL_ADR, LV_DRAW_LAYER_POOL_SIZE);
+    if(layer_pool.tlsf == NULL) LV_LOG_WARN("Couldn't create the layer pool at %p", (void *)LV_DRAW_LAYER_POOL_ADR);
+#endif
+#endif
+}
+
+void lv_draw_layer_pool_deinit(void)
+{
+#if LV_DRAW_LAYER_POOL_SIZE
+    lv_draw_layer_pool_flush();
+
+    /*The layers should be drawn already but free their buffers too*/
+    layer_pool_entry_t * entry;
+    LV_LL_READ(&layer_pool.used_ll, entry) {
+        entry_buf_free(entry->buf);
+    }
+    lv_ll_clear(&layer_pool.used_ll);
+
+#if LV_DRAW_LAYER_POOL_ADR
+    if(layer_pool.tlsf) lv_tlsf_destroy(layer_pool.tlsf);
+    layer_pool.tlsf = NULL;
+#endif
+#endif
+}
+
+lv_draw_buf_t * lv_draw_layer_pool_get(uint32_t w, uint32_t h, lv_color_format_t cf)
+{
+#if LV_DRAW_LAYER_POOL_SIZE
+    uint32_t stride = lv_draw_buf_width_to_stride(w, cf);
+    uint32_t size = get_size_class(stride * h);
+
+    /*Reuse the most recently released buffer of the same size class*/
+    layer_pool_entry_t * entry;
+    LV_LL_READ(&layer_pool.idle_ll, entry) {
+        if(entry->size == size) break;
+    }
+
+    if(entry) {
+        lv_ll_chg_list(&layer_pool.idle_ll, &layer_pool.used_ll, entry, true);
+        layer_pool.info.idle_size -= size;
+        layer_pool.info.hit_cnt++;
+    }
+    else {
+        layer_pool.info.miss_cnt++;
+
+        /*Free the unused buffers if there is no memory for a new one*/
+        void * buf = entry_buf_alloc(size, cf);
+        while(buf == NULL && drop_oldest_idle()) {
+            buf = entry_buf_alloc(size, cf);
+        }
+
+        entry = buf ? lv_ll_ins_head(&layer_pool.used_ll) : NULL;
+        if(entry == NULL) {
+            if(buf) entry_buf_free(buf);
+
+            /*The layer might still fit into the heap without rounding up its size*/
+            LV_LOG_INFO("No memory in the pool for a %" LV_PRIu32 " bytes layer", size);
+            return lv_draw_buf_create(w, h, cf, stride);
+        }
+        entry->buf = buf;
+        entry->size = size;
+    }
+
+    layer_pool.info.used_size += size;
+    layer_pool.info.used_peak = LV_MAX(layer_pool.info.used_peak, layer_pool.info.used_size);
+    layer_pool.info.total_peak = LV_MAX(layer_pool.info.total_peak,
+                                        layer_pool.info.used_size + layer_pool.info.idle_size);
+
+    /*Set it up as `lv_draw_buf_create()` would do but with the handlers of the pool*/
+    lv_draw_buf_init(&entry->draw_buf, w, h, cf, stride, lv_draw_buf_align(entry->buf, cf), size);
+    lv_draw_buf_set_flag(&entry->draw_buf, LV_IMAGE_FLAGS_MODIFIABLE | LV_IMAGE_FLAGS_ALLOCATED);
+    entry->draw_buf.unaligned_data = entry->buf;
+    entry->draw_buf.handlers = &layer_pool.handlers;
+
+    return &entry->draw_buf;
+#else
+    return lv_draw_buf_create(w, h, cf, 0);
+#endif
+}
+
+void lv_draw_layer_pool_release(lv_draw_buf_t * draw_buf)
+{
+#if LV_DRAW_LAYER_POOL_SIZE
+    /*Not from the pool, allocated as a normal draw buffer*/
+    if(draw_buf->handlers != &layer_pool.handlers) {
+        lv_draw_buf_destroy(draw_buf);
+        return;
+    }
+
+    layer_pool_entry_t * entry = (layer_pool_entry_t *)draw_buf;
+    lv_ll_chg_list(&layer_pool.used_ll, &layer_pool.idle_ll, entry, true);
+    layer_pool.info.used_size -= entry->size;
+    layer_pool.info.idle_size += entry->size;
+
+    while(layer_pool.info.idle_size > LV_DRAW_LAYER_POOL_SIZE) {
+        drop_oldest_idle();
+    }
+#else
+    lv_draw_buf_destroy(draw_buf);
+#endif
+}
+
+void lv_draw_layer_pool_get_info(lv_draw_layer_pool_info_t * info)
+{
+#if LV_DRAW_LAYER_POOL_SIZE
+    *info = layer_pool.info;
+#else
+    lv_memzero(info, sizeof(lv_draw_layer_pool_info_t));
+#endif
+}
+
+void lv_draw_layer_pool_flush(void)
+{
+#if LV_DRAW_LAYER_POOL_SIZE
+    while(drop_oldest_idle());
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_DRAW_LAYER_POOL_SIZE
+
+/**
+ * Round up the size so that the layers of similar size can share the buffers.
+ * The classes are 4 steps between the powers of 2, so at most 25% is wasted.
+ */
+static uint32_t get_size_class(uint32_t size)
+{
+    if(size <= LAYER_POOL_MIN_CLASS) return LAYER_POOL_MIN_CLASS;
+
+    uint32_t step = LAYER_POOL_MIN_CLASS / 4;
+    while(step * 8 < size) step <<= 1;
+
+    return (size + step - 1) & ~(step - 1);
+}
+
+static void * entry_buf_alloc(uint32_t size, lv_color_format_t cf)
+{
+#if LV_DRAW_LAYER_POOL_ADR
+    LV_UNUSED(cf);
+    if(layer_pool.tlsf == NULL) return NULL;
+    return lv_tlsf_malloc(layer_pool.tlsf, size + LV_DRAW_BUF_ALIGN - 1);
+#else
+    /*Allocate as the other draw buffers, the handler adds the space for the alignment*/
+    return lv_draw_buf_get_handlers()->buf_malloc_cb(size, cf);
+#endif
+}
+
+static void entry_buf_free(void * buf)
+{
+#if LV_DRAW_LAYER_POOL_ADR
+    lv_tlsf_free(layer_pool.tlsf, buf);
+#else
+    lv_draw_buf_get_handlers()->buf_free_cb(buf);
+#endif
+}
+
+static bool drop_oldest_idle(void)
+{
+    layer_pool_entry_t * entry = lv_ll_get_tail(&layer_pool.idle_ll);
+    if(entry == NULL) return false;
+
+    layer_pool.info.idle_size -= entry->size;
+    entry_buf_free(entry->buf);
+    lv_ll_remove(&layer_pool.idle_ll, entry);
+    lv_free(entry);
+    return true;
+}
+
+#endif /*LV_DRAW_LAYER_POOL_SIZE*/
@@ -0,0 +1,63 @@
+/**
+ * @file lv_draw_layer_pool.h
+ *
+ */
+
+#ifndef LV_DRAW_LAYER_POOL_H
+#define LV_DRAW_LAYER_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_conf_internal.h"
+#include "../misc/lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t hit_cnt;           /**< Layers which got a buffer from the pool*/
+    uint32_t miss_cnt;          /**< Layers which needed a new buffer*/
+    uint32_t used_size;         /**< Bytes of the buffers used by layers now*/
+    uint32_t idle_size;         /**< Bytes of the unused buffers kept for the next layers*/
+    uint32_t used_peak;         /**< High-water mark of `used_size`*/
+    uint32_t total_peak;        /**< High-water mark of `used_size + idle_size`*/
+    uint32_t max_size;          /**< LV_DRAW_LAYER_POOL_SIZE*/
+} lv_draw_layer_pool_info_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the statistics of the layer buffer pool.
+ * All the fields are 0 if the pool is disabled (`LV_DRAW_LAYER_POOL_SIZE == 0`).
+ * @param info      store the result here
+ */
+void lv_draw_layer_pool_get_info(lv_draw_layer_pool_info_t * info);
+
+/**
+ * Free the unused buffers kept by the layer pool, e.g. before allocating a large block.
+ * The buffers used by the layers being drawn are not affected.
+ */
+void lv_draw_layer_pool_flush(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_LAYER_POOL_H*/
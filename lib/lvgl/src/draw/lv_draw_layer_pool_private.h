@@ -0,0 +1,87 @@
+/**
+ * @file lv_draw_layer_pool_private.h
+ *
+ */
+
+#ifndef LV_DRAW_LAYER_POOL_PRIVATE_H
+#define LV_DRAW_LAYER_POOL_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_draw_layer_pool.h"
+#include "lv_draw_buf_private.h"
+#include "../misc/lv_ll.h"
+
+#if LV_DRAW_LAYER_POOL_SIZE && LV_DRAW_LAYER_POOL_ADR
+#if LV_USE_STDLIB_MALLOC != LV_STDLIB_BUILTIN
+#error "LV_DRAW_LAYER_POOL_ADR requires LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN"
+#endif
+#include "../stdlib/builtin/lv_tlsf.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_DRAW_LAYER_POOL_SIZE
+typedef struct {
+    lv_ll_t idle_ll;                    /**< Unused buffers, the most recently released first*/
+    lv_ll_t used_ll;                    /**< Buffers of the layers being drawn*/
+    lv_draw_buf_handlers_t handlers;    /**< The default handlers, set for the buffers of the pool to recognize them*/
+#if LV_DRAW_LAYER_POOL_ADR
+    lv_tlsf_t tlsf;                     /**< Allocator of the dedicated region*/
+#endif
+    lv_draw_layer_pool_info_t info;
+} lv_draw_layer_pool_t;
+#endif
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the layer buffer pool. Called from `lv_draw_init()`.
+ */
+void lv_draw_layer_pool_init(void);
+
+/**
+ * Free all the buffers of the layer pool. Called from `lv_draw_deinit()`.
+ */
+void lv_draw_layer_pool_deinit(void);
+
+/**
+ * Get a buffer for a layer. An unused buffer of the same size class is reused if there is one.
+ * Allocate a normal draw buffer if the pool is disabled or can't provide one.
+ * @param w         width of the layer
+ * @param h         height of the layer
+ * @param cf        color format of the layer
+ * @return          the draw buffer or NULL if there is no memory
+ */
+lv_draw_buf_t * lv_draw_layer_pool_get(uint32_t w, uint32_t h, lv_color_format_t cf);
+
+/**
+ * Give back a buffer got with `lv_draw_layer_pool_get()` when the layer is drawn.
+ * The least recently released buffers are freed to stay in `LV_DRAW_LAYER_POOL_SIZE`.
+ * @param draw_buf  the buffer of the layer
+ */
+void lv_draw_layer_pool_release(lv_draw_buf_t * draw_buf);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_LAYER_POOL_PRIVATE_H*/
@@ -19,6 +19,7 @@ extern "C" {
  *********************/
 
 #include "lv_draw.h"
+#include "lv_draw_layer_pool_private.h"
 
 /*********************
  *      DEFINES
@@ -177,8 +178,11 @@ typedef struct {
 #else
     int dispatch_req;
 #endif
-    lv_mutex_t circle_cache_mutex;
+    lv_mutex_t mask_cache_mutex;
     bool task_running;
+#if LV_DRAW_LAYER_POOL_SIZE
+    lv_draw_layer_pool_t layer_pool;
+#endif
 } lv_draw_global_info_t;
 
 /**********************
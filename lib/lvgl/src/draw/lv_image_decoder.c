@@ -70,7 +70,7 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void)
 {
-    lv_cache_destroy(img_cache_p, NULL);
+    lv_image_cache_deinit();
     lv_cache_destroy(img_header_cache_p, NULL);
 
     lv_ll_clear(img_decoder_ll_p);
@@ -218,7 +218,15 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
                                                  lv_image_cache_data_t * search_key,
                                                  const lv_draw_buf_t * decoded, void * user_data)
 {
-    lv_cache_entry_t * cache_entry = lv_cache_add(img_cache_p, search_key, NULL);
+    lv_cache_entry_t * cache_entry = NULL;
+    if(lv_image_cache_is_cacheable(search_key->slot.size)) {
+        cache_entry = lv_cache_add(img_cache_p, search_key, NULL);
+    }
+
+    lv_mutex_lock(&img_cache_p->lock);
+    LV_GLOBAL_DEFAULT()->img_cache_miss_cnt++;
+    lv_mutex_unlock(&img_cache_p->lock);
+
     if(cache_entry == NULL) {
         return NULL;
     }
@@ -226,6 +234,14 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
     lv_image_cache_data_t * cached_data;
     cached_data = lv_cache_entry_get_data(cache_entry);
 
+    /*List the entries to find the pinned ones and dump them*/
+    lv_mutex_lock(&img_cache_p->lock);
+    cached_data->hit_cnt = 0;
+    cached_data->pinned = false;
+    cached_data->ll_node = lv_ll_ins_head(&LV_GLOBAL_DEFAULT()->img_cache_ll);
+    if(cached_data->ll_node) *(lv_image_cache_data_t **)cached_data->ll_node = cached_data;
+    lv_mutex_unlock(&img_cache_p->lock);
+
     /*Set the cache entry to decoder data*/
     cached_data->decoded = decoded;
     if(cached_data->src_type == LV_IMAGE_SRC_FILE) {
@@ -405,6 +421,12 @@ static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc)
 
     if(entry) {
         lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+
+        lv_mutex_lock(&cache->lock);
+        cached_data->hit_cnt++;
+        LV_GLOBAL_DEFAULT()->img_cache_hit_cnt++;
+        lv_mutex_unlock(&cache->lock);
+
         dsc->decoded = cached_data->decoded;
         dsc->decoder = (lv_image_decoder_t *)cached_data->decoder;
         dsc->cache_entry = entry;     /*Save the cache to release it in decoder_close*/
@@ -61,6 +61,10 @@ struct lv_image_cache_data_t {
     const lv_draw_buf_t * decoded;
     const lv_image_decoder_t * decoder;
     void * user_data;
+
+    void * ll_node;         /**< Node of the entry in the list of the image cache*/
+    uint32_t hit_cnt;       /**< Number of times the decoded image was found in the cache*/
+    bool pinned;            /**< Kept in the cache by `lv_image_cache_pin()`*/
 };
 
 struct lv_image_header_cache_data_t {
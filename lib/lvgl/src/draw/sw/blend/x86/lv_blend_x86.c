@@ -0,0 +1,496 @@
+/**
+ * @file lv_blend_x86.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_blend_x86.h"
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_SIMD
+
+#include "../../x86/lv_draw_sw_x86_private.h"
+#include "../../../../misc/lv_color.h"
+#include "../../../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*What the opacity of the foreground is multiplied with*/
+typedef enum {
+    MIX_NONE = 0x0,
+    MIX_OPA = 0x1,
+    MIX_MASK = 0x2,
+} mix_flags_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+#if LV_DRAW_SW_SUPPORT_RGB565
+static void rgb565_blend(uint16_t * dest_buf_u16, int32_t dest_stride, const uint16_t * src_buf_u16, int32_t src_stride,
+                         uint16_t color16, const lv_opa_t * mask_buf, int32_t mask_stride, lv_opa_t opa,
+                         int32_t w, int32_t h, mix_flags_t flags);
+static inline void rgb565_block(uint16_t * dest, const uint16_t * src, lv_x86_vec_t color, const lv_opa_t * mask,
+                                lv_x86_vec_t opa, mix_flags_t flags);
+static void argb8888_to_rgb565_blend(lv_draw_sw_blend_image_dsc_t * dsc, mix_flags_t flags);
+static inline void argb8888_to_rgb565_block(uint16_t * dest, const uint32_t * src, const lv_opa_t * mask,
+                                            lv_x86_vec_t opa, mix_flags_t flags);
+static inline lv_x86_vec_t rgb565_mix(lv_x86_vec_t fg, lv_x86_vec_t bg, lv_x86_vec_t mix);
+static inline lv_x86_vec_t argb8888_rgb565_mix(lv_x86_vec_t fg, lv_x86_vec_t bg, lv_x86_vec_t mix);
+#endif
+
+#if LV_DRAW_SW_SUPPORT_ARGB8888
+static void argb8888_blend(uint32_t * dest_buf_u32, int32_t dest_stride, const uint32_t * src_buf_u32,
+                           int32_t src_stride, uint32_t color32, const lv_opa_t * mask_buf, int32_t mask_stride,
+                           lv_opa_t opa, int32_t w, int32_t h, mix_flags_t flags);
+static inline void argb8888_block(uint32_t * dest, const uint32_t * src, lv_x86_vec_t color, const lv_opa_t * mask,
+                                  lv_x86_vec_t opa, mix_flags_t flags);
+#endif
+
+static inline lv_x86_vec_t opa_mix(lv_x86_vec_t a, lv_x86_vec_t mask, lv_x86_vec_t opa, mix_flags_t flags);
+static inline void * drawbuf_next_row(const void * buf, uint32_t stride);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LV_DRAW_SW_SUPPORT_RGB565
+
+lv_result_t lv_color_blend_to_rgb565_with_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_stride, NULL, 0, lv_color_to_u16(dsc->color), NULL, 0, dsc->opa,
+                 dsc->dest_w, dsc->dest_h, MIX_OPA);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_with_mask_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_stride, NULL, 0, lv_color_to_u16(dsc->color), dsc->mask_buf, dsc->mask_stride,
+                 LV_OPA_COVER, dsc->dest_w, dsc->dest_h, MIX_MASK);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_mix_mask_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_stride, NULL, 0, lv_color_to_u16(dsc->color), dsc->mask_buf, dsc->mask_stride,
+                 dsc->opa, dsc->dest_w, dsc->dest_h, MIX_MASK | MIX_OPA);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0, NULL, 0, dsc->opa,
+                 dsc->dest_w, dsc->dest_h, MIX_OPA);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0, dsc->mask_buf, dsc->mask_stride,
+                 LV_OPA_COVER, dsc->dest_w, dsc->dest_h, MIX_MASK);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0, dsc->mask_buf, dsc->mask_stride,
+                 dsc->opa, dsc->dest_w, dsc->dest_h, MIX_MASK | MIX_OPA);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_to_rgb565_blend(dsc, MIX_NONE);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_to_rgb565_blend(dsc, MIX_OPA);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_to_rgb565_blend(dsc, MIX_MASK);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_to_rgb565_blend(dsc, MIX_MASK | MIX_OPA);
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_DRAW_SW_SUPPORT_RGB565*/
+
+#if LV_DRAW_SW_SUPPORT_ARGB8888
+
+lv_result_t lv_color_blend_to_argb8888_with_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_stride, NULL, 0, lv_color_to_u32(dsc->color), NULL, 0, dsc->opa,
+                   dsc->dest_w, dsc->dest_h, MIX_OPA);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_with_mask_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_stride, NULL, 0, lv_color_to_u32(dsc->color), dsc->mask_buf,
+                   dsc->mask_stride, LV_OPA_COVER, dsc->dest_w, dsc->dest_h, MIX_MASK);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_mix_mask_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_stride, NULL, 0, lv_color_to_u32(dsc->color), dsc->mask_buf,
+                   dsc->mask_stride, dsc->opa, dsc->dest_w, dsc->dest_h, MIX_MASK | MIX_OPA);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0, NULL, 0, LV_OPA_COVER,
+                   dsc->dest_w, dsc->dest_h, MIX_NONE);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0, NULL, 0, dsc->opa,
+                   dsc->dest_w, dsc->dest_h, MIX_OPA);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0, dsc->mask_buf, dsc->mask_stride,
+                   LV_OPA_COVER, dsc->dest_w, dsc->dest_h, MIX_MASK);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0, dsc->mask_buf, dsc->mask_stride,
+                   dsc->opa, dsc->dest_w, dsc->dest_h, MIX_MASK | MIX_OPA);
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_DRAW_SW_SUPPORT_ARGB8888*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_DRAW_SW_SUPPORT_RGB565
+
+/**
+ * Blend a color or an RGB565 image to an RGB565 buffer
+ * @param dest_buf_u16  the destination buffer
+ * @param dest_stride   stride of the destination in bytes
+ * @param src_buf_u16   the RGB565 image or NULL to blend `color16`
+ * @param src_stride    stride of the image in bytes
+ * @param color16       the color to blend if there is no image
+ * @param mask_buf      the mask if `flags` has `MIX_MASK`
+ * @param mask_stride   stride of the mask in bytes
+ * @param opa           the opacity if `flags` has `MIX_OPA`
+ * @param w             width of the area
+ * @param h             height of the area
+ * @param flags         what to multiply the opacity with
+ */
+static void LV_ATTRIBUTE_FAST_MEM rgb565_blend(uint16_t * dest_buf_u16, int32_t dest_stride,
+                                               const uint16_t * src_buf_u16, int32_t src_stride,
+                                               uint16_t color16, const lv_opa_t * mask_buf, int32_t mask_stride, lv_opa_t opa,
+                                               int32_t w, int32_t h, mix_flags_t flags)
+{
+    lv_x86_vec_t color = LV_X86_SET16(color16);
+    lv_x86_vec_t opa_v = LV_X86_SET16(opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x <= w - LV_X86_PX16; x += LV_X86_PX16) {
+            rgb565_block(&dest_buf_u16[x], src_buf_u16 ? &src_buf_u16[x] : NULL, color,
+                         mask_buf ? &mask_buf[x] : NULL, opa_v, flags);
+        }
+
+        /*Blend the last few pixels in a temporary vector*/
+        if(x < w) {
+            int32_t rest = w - x;
+            uint16_t dest_tmp[LV_X86_PX16];
+            uint16_t src_tmp[LV_X86_PX16];
+            lv_opa_t mask_tmp[LV_X86_PX16];
+            lv_memzero(src_tmp, sizeof(src_tmp));
+            lv_memzero(mask_tmp, sizeof(mask_tmp));
+            lv_memcpy(dest_tmp, &dest_buf_u16[x], rest * sizeof(uint16_t));
+            if(src_buf_u16) lv_memcpy(src_tmp, &src_buf_u16[x], rest * sizeof(uint16_t));
+            if(mask_buf) lv_memcpy(mask_tmp, &mask_buf[x], rest);
+            rgb565_block(dest_tmp, src_buf_u16 ? src_tmp : NULL, color, mask_buf ? mask_tmp : NULL, opa_v, flags);
+            lv_memcpy(&dest_buf_u16[x], dest_tmp, rest * sizeof(uint16_t));
+        }
+
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+        if(src_buf_u16) src_buf_u16 = drawbuf_next_row(src_buf_u16, src_stride);
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+static inline void LV_ATTRIBUTE_FAST_MEM rgb565_block(uint16_t * dest, const uint16_t * src, lv_x86_vec_t color,
+                                                      const lv_opa_t * mask, lv_x86_vec_t opa, mix_flags_t flags)
+{
+    lv_x86_vec_t fg = src ? LV_X86_LOAD(src) : color;
+    lv_x86_vec_t mix = opa;
+
+    if(flags & MIX_MASK) {
+        lv_x86_vec_t mask_v = LV_X86_LOAD_U8_16(mask);
+        uint32_t transp = LV_X86_MOVEMASK(LV_X86_CMPEQ16(mask_v, LV_X86_ZERO()));
+        if(transp == LV_X86_MOVEMASK_ALL) return;
+
+        if(flags == MIX_MASK) {
+            uint32_t cover = LV_X86_MOVEMASK(LV_X86_CMPEQ16(mask_v, LV_X86_SET16(LV_OPA_COVER)));
+            if(cover == LV_X86_MOVEMASK_ALL) {
+                LV_X86_STORE(dest, fg);
+                return;
+            }
+        }
+
+        mix = opa_mix(mask_v, mask_v, opa, flags & MIX_OPA);
+    }
+
+    LV_X86_STORE(dest, rgb565_mix(fg, LV_X86_LOAD(dest), mix));
+}
+
+static void LV_ATTRIBUTE_FAST_MEM argb8888_to_rgb565_blend(lv_draw_sw_blend_image_dsc_t * dsc, mix_flags_t flags)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint32_t * src_buf_u32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = (flags & MIX_MASK) ? dsc->mask_buf : NULL;
+    int32_t mask_stride = dsc->mask_stride;
+    lv_x86_vec_t opa_v = LV_X86_SET32(dsc->opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x <= w - LV_X86_PX32; x += LV_X86_PX32) {
+            argb8888_to_rgb565_block(&dest_buf_u16[x], &src_buf_u32[x], mask_buf ? &mask_buf[x] : NULL, opa_v, flags);
+        }
+
+        if(x < w) {
+            int32_t rest = w - x;
+            uint16_t dest_tmp[LV_X86_PX32];
+            uint32_t src_tmp[LV_X86_PX32];
+            lv_opa_t mask_tmp[LV_X86_PX32];
+            lv_memzero(src_tmp, sizeof(src_tmp));
+            lv_memzero(mask_tmp, sizeof(mask_tmp));
+            lv_memcpy(dest_tmp, &dest_buf_u16[x], rest * sizeof(uint16_t));
+            lv_memcpy(src_tmp, &src_buf_u32[x], rest * sizeof(uint32_t));
+            if(mask_buf) lv_memcpy(mask_tmp, &mask_buf[x], rest);
+            argb8888_to_rgb565_block(dest_tmp, src_tmp, mask_buf ? mask_tmp : NULL, opa_v, flags);
+            lv_memcpy(&dest_buf_u16[x], dest_tmp, rest * sizeof(uint16_t));
+        }
+
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+        src_buf_u32 = drawbuf_next_row(src_buf_u32, src_stride);
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+static inline void LV_ATTRIBUTE_FAST_MEM argb8888_to_rgb565_block(uint16_t * dest, const uint32_t * src,
+                                                                  const lv_opa_t * mask, lv_x86_vec_t opa,
+                                                                  mix_flags_t flags)
+{
+    lv_x86_vec_t fg = LV_X86_LOAD(src);
+    lv_x86_vec_t mask_v = (flags & MIX_MASK) ? LV_X86_LOAD_U8_32(mask) : opa;
+    lv_x86_vec_t mix = opa_mix(LV_X86_SRL32(fg, 24), mask_v, opa, flags);
+
+    /*Nothing to do in the fully transparent parts of the image*/
+    if(LV_X86_MOVEMASK(LV_X86_CMPEQ32(mix, LV_X86_ZERO())) == LV_X86_MOVEMASK_ALL) return;
+
+    lv_x86_vec_t res = argb8888_rgb565_mix(fg, LV_X86_LOAD_U16_32(dest), mix);
+    LV_X86_STORE_32_U16(dest, res);
+}
+
+/**
+ * Mix RGB565 colors the same way as `lv_color_16_16_mix`
+ * @param fg        the foreground colors
+ * @param bg        the background colors
+ * @param mix       0..255, the opacity of the foreground in the 16 bit lanes
+ * @return          the mixed colors
+ */
+static inline lv_x86_vec_t LV_ATTRIBUTE_FAST_MEM rgb565_mix(lv_x86_vec_t fg, lv_x86_vec_t bg, lv_x86_vec_t mix)
+{
+    lv_x86_vec_t mask_g = LV_X86_SET16(0x3F);
+    lv_x86_vec_t mask_b = LV_X86_SET16(0x1F);
+    mix = LV_X86_SRL16(LV_X86_ADD16(mix, LV_X86_SET16(4)), 3);
+    lv_x86_vec_t mix_inv = LV_X86_SUB16(LV_X86_SET16(32), mix);
+
+    lv_x86_vec_t r = LV_X86_ADD16(LV_X86_MULLO16(LV_X86_SRL16(fg, 11), mix),
+                                  LV_X86_MULLO16(LV_X86_SRL16(bg, 11), mix_inv));
+    lv_x86_vec_t g = LV_X86_ADD16(LV_X86_MULLO16(LV_X86_AND(LV_X86_SRL16(fg, 5), mask_g), mix),
+                                  LV_X86_MULLO16(LV_X86_AND(LV_X86_SRL16(bg, 5), mask_g), mix_inv));
+    lv_x86_vec_t b = LV_X86_ADD16(LV_X86_MULLO16(LV_X86_AND(fg, mask_b), mix),
+                                  LV_X86_MULLO16(LV_X86_AND(bg, mask_b), mix_inv));
+
+    return LV_X86_OR(LV_X86_OR(LV_X86_SLL16(LV_X86_SRL16(r, 5), 11), LV_X86_SLL16(LV_X86_SRL16(g, 5), 5)),
+                     LV_X86_SRL16(b, 5));
+}
+
+/**
+ * Mix ARGB8888 colors to RGB565 colors the same way as `lv_color_24_16_mix`.
+ * The pixels are in the 32 bit lanes, the products of the channels still fit into 16 bits.
+ * @param fg        the foreground colors, their alpha is ignored
+ * @param bg        the RGB565 background colors in the 32 bit lanes
+ * @param mix       0..255, the opacity of the foreground in the 32 bit lanes
+ * @return          the mixed RGB565 colors in the 32 bit lanes
+ */
+static inline lv_x86_vec_t LV_ATTRIBUTE_FAST_MEM argb8888_rgb565_mix(lv_x86_vec_t fg, lv_x86_vec_t bg,
+                                                                     lv_x86_vec_t mix)
+{
+    lv_x86_vec_t mask_g = LV_X86_SET32(0x3F);
+    lv_x86_vec_t mask_rb = LV_X86_SET32(0x1F);
+    lv_x86_vec_t mix_inv = LV_X86_SUB32(LV_X86_SET32(255), mix);
+
+    lv_x86_vec_t fg_r = LV_X86_AND(LV_X86_SRL32(fg, 19), mask_rb);
+    lv_x86_vec_t fg_g = LV_X86_AND(LV_X86_SRL32(fg, 10), mask_g);
+    lv_x86_vec_t fg_b = LV_X86_AND(LV_X86_SRL32(fg, 3), mask_rb);
+
+    lv_x86_vec_t r = LV_X86_ADD32(LV_X86_MULLO16(fg_r, mix), LV_X86_MULLO16(LV_X86_SRL32(bg, 11), mix_inv));
+    lv_x86_vec_t g = LV_X86_ADD32(LV_X86_MULLO16(fg_g, mix),
+                                  LV_X86_MULLO16(LV_X86_AND(LV_X86_SRL32(bg, 5), mask_g), mix_inv));
+    lv_x86_vec_t b = LV_X86_ADD32(LV_X86_MULLO16(fg_b, mix), LV_X86_MULLO16(LV_X86_AND(bg, mask_rb), mix_inv));
+
+    lv_x86_vec_t res = LV_X86_OR(LV_X86_OR(LV_X86_SLL32(LV_X86_SRL32(r, 8), 11), LV_X86_SLL32(LV_X86_SRL32(g, 8), 5)),
+                                 LV_X86_SRL32(b, 8));
+
+    /*The C code returns the converted color and the background unchanged at the two ends*/
+    lv_x86_vec_t fg16 = LV_X86_OR(LV_X86_OR(LV_X86_SLL32(fg_r, 11), LV_X86_SLL32(fg_g, 5)), fg_b);
+    res = LV_X86_SELECT(LV_X86_CMPEQ32(mix, LV_X86_SET32(255)), fg16, res);
+    return LV_X86_SELECT(LV_X86_CMPEQ32(mix, LV_X86_ZERO()), bg, res);
+}
+
+#endif /*LV_DRAW_SW_SUPPORT_RGB565*/
+
+#if LV_DRAW_SW_SUPPORT_ARGB8888
+
+/**
+ * Blend a color or an ARGB8888 image to an ARGB8888 buffer
+ * @param dest_buf_u32  the destination buffer
+ * @param dest_stride   stride of the destination in bytes
+ * @param src_buf_u32   the ARGB8888 image or NULL to blend `color32`
+ * @param src_stride    stride of the image in bytes
+ * @param color32       the color to blend if there is no image
+ * @param mask_buf      the mask if `flags` has `MIX_MASK`
+ * @param mask_stride   stride of the mask in bytes
+ * @param opa           the opacity if `flags` has `MIX_OPA`
+ * @param w             width of the area
+ * @param h             height of the area
+ * @param flags         what to multiply the opacity with
+ */
+static void LV_ATTRIBUTE_FAST_MEM argb8888_blend(uint32_t * dest_buf_u32, int32_t dest_stride,
+                                                 const uint32_t * src_buf_u32, int32_t src_stride,
+                                                 uint32_t color32, const lv_opa_t * mask_buf, int32_t mask_stride,
+                                                 lv_opa_t opa, int32_t w, int32_t h, mix_flags_t flags)
+{
+    lv_x86_vec_t color = LV_X86_SET32(color32 & 0x00FFFFFF);
+    lv_x86_vec_t opa_v = LV_X86_SET32(opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x <= w - LV_X86_PX32; x += LV_X86_PX32) {
+            argb8888_block(&dest_buf_u32[x], src_buf_u32 ? &src_buf_u32[x] : NULL, color,
+                           mask_buf ? &mask_buf[x] : NULL, opa_v, flags);
+        }
+
+        if(x < w) {
+            int32_t rest = w - x;
+            uint32_t dest_tmp[LV_X86_PX32];
+            uint32_t src_tmp[LV_X86_PX32];
+            lv_opa_t mask_tmp[LV_X86_PX32];
+            lv_memzero(src_tmp, sizeof(src_tmp));
+            lv_memzero(mask_tmp, sizeof(mask_tmp));
+            lv_memcpy(dest_tmp, &dest_buf_u32[x], rest * sizeof(uint32_t));
+            if(src_buf_u32) lv_memcpy(src_tmp, &src_buf_u32[x], rest * sizeof(uint32_t));
+            if(mask_buf) lv_memcpy(mask_tmp, &mask_buf[x], rest);
+            argb8888_block(dest_tmp, src_buf_u32 ? src_tmp : NULL, color, mask_buf ? mask_tmp : NULL, opa_v, flags);
+            lv_memcpy(&dest_buf_u32[x], dest_tmp, rest * sizeof(uint32_t));
+        }
+
+        dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dest_stride);
+        if(src_buf_u32) src_buf_u32 = drawbuf_next_row(src_buf_u32, src_stride);
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+static inline void LV_ATTRIBUTE_FAST_MEM argb8888_block(uint32_t * dest, const uint32_t * src, lv_x86_vec_t color,
+                                                        const lv_opa_t * mask, lv_x86_vec_t opa, mix_flags_t flags)
+{
+    lv_x86_vec_t mask_v = (flags & MIX_MASK) ? LV_X86_LOAD_U8_32(mask) : opa;
+    lv_x86_vec_t fg;
+
+    if(src) {
+        fg = LV_X86_LOAD(src);
+        if(flags != MIX_NONE) {
+            lv_x86_vec_t alpha = opa_mix(LV_X86_SRL32(fg, 24), mask_v, opa, flags);
+            fg = LV_X86_OR(LV_X86_AND(fg, LV_X86_SET32(0x00FFFFFF)), LV_X86_SLL32(alpha, 24));
+        }
+    }
+    else {
+        lv_x86_vec_t alpha = (flags & MIX_MASK) ? opa_mix(mask_v, mask_v, opa, flags & MIX_OPA) : opa;
+        fg = LV_X86_OR(color, LV_X86_SLL32(alpha, 24));
+    }
+
+    LV_X86_STORE(dest, lv_x86_mix_argb8888(fg, LV_X86_LOAD(dest)));
+}
+
+#endif /*LV_DRAW_SW_SUPPORT_ARGB8888*/
+
+/**
+ * Multiply an opacity with the mask and/or the opacity like `LV_OPA_MIX2` and `LV_OPA_MIX3`.
+ * Works both on 16 and 32 bit lanes.
+ * @param a         the opacity to multiply
+ * @param mask      the mask values if `flags` has `MIX_MASK`
+ * @param opa       the opacity if `flags` has `MIX_OPA`
+ * @param flags     what to multiply `a` with
+ * @return          the resulted opacity
+ */
+static inline lv_x86_vec_t LV_ATTRIBUTE_FAST_MEM opa_mix(lv_x86_vec_t a, lv_x86_vec_t mask, lv_x86_vec_t opa,
+                                                         mix_flags_t flags)
+{
+    switch((int)flags) {
+        case MIX_OPA:
+            return LV_X86_SRL16(LV_X86_MULLO16(a, opa), 8);
+        case MIX_MASK:
+            return LV_X86_SRL16(LV_X86_MULLO16(a, mask), 8);
+        case MIX_MASK | MIX_OPA:
+            /*a * mask fits into 16 bits, the high half of the product with `opa` is `>> 16`*/
+            return LV_X86_MULHI16(LV_X86_MULLO16(a, mask), opa);
+        default:
+            return a;
+    }
+}
+
+static inline void * LV_ATTRIBUTE_FAST_MEM drawbuf_next_row(const void * buf, uint32_t stride)
+{
+    return (void *)((uint8_t *)buf + stride);
+}
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_SIMD*/
@@ -139,6 +139,10 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, lv_draw_fill_dsc_t * dsc, const
                 break;
             default:
                 LV_LOG_WARN("Gradient type is not supported");
+                if(mask_buf) {
+                    lv_free(mask_buf);
+                    lv_draw_sw_mask_free_param(&mask_rout_param);
+                }
                 return;
         }
         blend_dsc.src_area = &blend_area;
@@ -17,19 +17,55 @@
 #include "../../misc/lv_assert.h"
 #include "../../osal/lv_os.h"
 #include "../../stdlib/lv_string.h"
+#include "../../misc/cache/lv_cache.h"
+#include "../../misc/cache/lv_cache_private.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+    #include "x86/lv_draw_sw_x86.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
+    #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
+#endif
 
 /*********************
  *      DEFINES
  *********************/
-#define CIRCLE_CACHE_LIFE_MAX           1000
-#define CIRCLE_CACHE_AGING(life, r)     life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
-#define circle_cache_mutex              LV_GLOBAL_DEFAULT()->draw_info.circle_cache_mutex
-#define _circle_cache                   LV_GLOBAL_DEFAULT()->sw_circle_cache
+#define mask_cache_mutex                LV_GLOBAL_DEFAULT()->draw_info.mask_cache_mutex
+#define mask_cache_p                    LV_GLOBAL_DEFAULT()->sw_mask_cache
+#define mask_cache_hit_cnt              LV_GLOBAL_DEFAULT()->sw_mask_cache_hit_cnt
+#define mask_cache_miss_cnt             LV_GLOBAL_DEFAULT()->sw_mask_cache_miss_cnt
+
+/*Size of the buffer of a circle: `cir_opa` and the uint16_t `opa_start_on_y` and `x_start_on_y`*/
+#define CIRCLE_BUF_SIZE(radius)         ((radius) * 6 + 6)
+
+#ifndef LV_DRAW_SW_MASK_MIX_OPA
+    #define LV_DRAW_SW_MASK_MIX_OPA(...)    LV_RESULT_INVALID
+#endif
+
+#ifndef LV_DRAW_SW_MASK_MIX_MAP
+    #define LV_DRAW_SW_MASK_MIX_MAP(...)    LV_RESULT_INVALID
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef enum {
+    MASK_CACHE_CIRCLE,
+    MASK_CACHE_SHADOW,
+} mask_cache_type_t;
+
+/*A circle or a shadow corner in the cache. Shadows and circles share the budget.*/
+typedef struct {
+    lv_cache_slot_size_t slot;
+    mask_cache_type_t type;
+    int32_t radius;
+    int32_t width;                                  /*Only for shadows: blur width*/
+    int32_t w;                                      /*Only for shadows: size of the blurred rectangle*/
+    int32_t h;
+    lv_draw_sw_mask_radius_circle_dsc_t circle;     /*Only for circles*/
+    lv_opa_t * shadow_buf;                          /*Only for shadows: `(width + radius)^2` opacities*/
+} mask_cache_data_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -65,6 +101,8 @@ static void circ_calc_aa4(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radiu
 static lv_opa_t * get_next_line(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t y, int32_t * len,
                                 int32_t * x_start);
 static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
+static lv_cache_compare_res_t mask_cache_compare_cb(const mask_cache_data_t * lhs, const mask_cache_data_t * rhs);
+static void mask_cache_free_cb(mask_cache_data_t * entry, void * user_data);
 
 /**********************
  *  STATIC VARIABLES
@@ -80,12 +118,26 @@ static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, l
 
 void lv_draw_sw_mask_init(void)
 {
-    lv_mutex_init(&circle_cache_mutex);
+    lv_mutex_init(&mask_cache_mutex);
+
+    mask_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(mask_cache_data_t), LV_DRAW_SW_MASK_CACHE_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) mask_cache_compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t) mask_cache_free_cb
+    });
+
+    lv_cache_set_name(mask_cache_p, "DRAW_SW_MASK");
 }
 
 void lv_draw_sw_mask_deinit(void)
 {
-    lv_mutex_delete(&circle_cache_mutex);
+    if(mask_cache_p) {
+        lv_cache_destroy(mask_cache_p, NULL);
+        mask_cache_p = NULL;
+    }
+
+    lv_mutex_delete(&mask_cache_mutex);
 }
 
 lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_apply(void * masks[], lv_opa_t * mask_buf, int32_t abs_x,
@@ -109,33 +161,94 @@ lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_apply(void * masks[]
 
 void lv_draw_sw_mask_free_param(void * p)
 {
-    lv_mutex_lock(&circle_cache_mutex);
     lv_draw_sw_mask_common_dsc_t * pdsc = p;
     if(pdsc->type == LV_DRAW_SW_MASK_TYPE_RADIUS) {
         lv_draw_sw_mask_radius_param_t * radius_p = (lv_draw_sw_mask_radius_param_t *) p;
         if(radius_p->circle) {
-            if(radius_p->circle->life < 0) {
-                lv_free(radius_p->circle->cir_opa);
+            if(radius_p->circle->cache_entry == NULL) {
+                lv_free(radius_p->circle->buf);
                 lv_free(radius_p->circle);
             }
             else {
-                radius_p->circle->used_cnt--;
+                /*Let the cache evict the circle when it's not used anymore*/
+                lv_cache_release(mask_cache_p, radius_p->circle->cache_entry, NULL);
             }
+            radius_p->circle = NULL;
         }
     }
+}
 
-    lv_mutex_unlock(&circle_cache_mutex);
+bool lv_draw_sw_mask_cache_get_shadow(int32_t width, int32_t radius, int32_t w, int32_t h, lv_opa_t * buf)
+{
+    if(!lv_cache_is_enabled(mask_cache_p)) return false;
+
+    mask_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.type = MASK_CACHE_SHADOW;
+    search_key.radius = radius;
+    search_key.width = width;
+    search_key.w = w;
+    search_key.h = h;
+
+    lv_mutex_lock(&mask_cache_mutex);
+    lv_cache_entry_t * entry = lv_cache_acquire(mask_cache_p, &search_key, NULL);
+    if(entry == NULL) {
+        mask_cache_miss_cnt++;
+        lv_mutex_unlock(&mask_cache_mutex);
+        return false;
+    }
+
+    mask_cache_hit_cnt++;
+    mask_cache_data_t * data = lv_cache_entry_get_data(entry);
+    lv_memcpy(buf, data->shadow_buf, (width + radius) * (width + radius));
+    lv_cache_release(mask_cache_p, entry, NULL);
+    lv_mutex_unlock(&mask_cache_mutex);
+
+    return true;
 }
 
-void lv_draw_sw_mask_cleanup(void)
+void lv_draw_sw_mask_cache_add_shadow(int32_t width, int32_t radius, int32_t w, int32_t h, const lv_opa_t * buf)
 {
-    uint8_t i;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].buf) {
-            lv_free(_circle_cache[i].buf);
+    if(!lv_cache_is_enabled(mask_cache_p)) return;
+
+    uint32_t size = (width + radius) * (width + radius);
+
+    /*Don't evict everything for a shadow larger than the whole cache*/
+    if(size > lv_cache_get_max_size(mask_cache_p, NULL)) return;
+
+    mask_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.slot.size = size;
+    search_key.type = MASK_CACHE_SHADOW;
+    search_key.radius = radius;
+    search_key.width = width;
+    search_key.w = w;
+    search_key.h = h;
+
+    lv_mutex_lock(&mask_cache_mutex);
+
+    /*An other draw unit might have added it meanwhile*/
+    lv_cache_entry_t * entry = lv_cache_acquire(mask_cache_p, &search_key, NULL);
+    if(entry == NULL) {
+        search_key.shadow_buf = lv_malloc(size);
+        LV_ASSERT_MALLOC(search_key.shadow_buf);
+        if(search_key.shadow_buf) {
+            lv_memcpy(search_key.shadow_buf, buf, size);
+            entry = lv_cache_add(mask_cache_p, &search_key, NULL);
+            if(entry == NULL) lv_free(search_key.shadow_buf);
         }
-        lv_memzero(&(_circle_cache[i]), sizeof(_circle_cache[i]));
     }
+
+    if(entry) lv_cache_release(mask_cache_p, entry, NULL);
+    lv_mutex_unlock(&mask_cache_mutex);
+}
+
+void lv_draw_sw_mask_cache_get_info(lv_draw_sw_mask_cache_info_t * info)
+{
+    info->hit_cnt = mask_cache_hit_cnt;
+    info->miss_cnt = mask_cache_miss_cnt;
+    info->size = mask_cache_p ? lv_cache_get_size(mask_cache_p, NULL) : 0;
+    info->max_size = mask_cache_p ? lv_cache_get_max_size(mask_cache_p, NULL) : 0;
 }
 
 void lv_draw_sw_mask_line_points_init(lv_draw_sw_mask_line_param_t * param, int32_t p1x, int32_t p1y,
@@ -311,47 +424,48 @@ void lv_draw_sw_mask_radius_init(lv_draw_sw_mask_radius_param_t * param, const l
         return;
     }
 
-    lv_mutex_lock(&circle_cache_mutex);
-
-    uint32_t i;
-
-    /*Try to reuse a circle cache entry*/
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].radius == radius) {
-            _circle_cache[i].used_cnt++;
-            CIRCLE_CACHE_AGING(_circle_cache[i].life, radius);
-            param->circle = &(_circle_cache[i]);
-            lv_mutex_unlock(&circle_cache_mutex);
+    mask_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.slot.size = CIRCLE_BUF_SIZE(radius);
+    search_key.type = MASK_CACHE_CIRCLE;
+    search_key.radius = radius;
+
+    lv_mutex_lock(&mask_cache_mutex);
+
+    /*The circle stays in the cache at least until the mask is freed*/
+    lv_cache_entry_t * entry = NULL;
+    if(lv_cache_is_enabled(mask_cache_p)) {
+        entry = lv_cache_acquire(mask_cache_p, &search_key, NULL);
+        if(entry) {
+            mask_cache_hit_cnt++;
+            mask_cache_data_t * data = lv_cache_entry_get_data(entry);
+            param->circle = &data->circle;
+            lv_mutex_unlock(&mask_cache_mutex);
             return;
         }
+        mask_cache_miss_cnt++;
     }
 
-    /*If not cached use the free entry with lowest life*/
-    lv_draw_sw_mask_radius_circle_dsc_t * entry = NULL;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].used_cnt == 0) {
-            if(!entry) entry = &(_circle_cache[i]);
-            else if(_circle_cache[i].life < entry->life) entry = &(_circle_cache[i]);
-        }
+    circ_calc_aa4(&search_key.circle, radius);
+
+    /*Add it to the cache unless it's larger than the whole cache*/
+    if(lv_cache_is_enabled(mask_cache_p) && search_key.slot.size <= lv_cache_get_max_size(mask_cache_p, NULL)) {
+        entry = lv_cache_add(mask_cache_p, &search_key, NULL);
     }
 
-    /*There is no unused entry. Allocate one temporarily*/
-    if(!entry) {
-        entry = lv_malloc_zeroed(sizeof(lv_draw_sw_mask_radius_circle_dsc_t));
-        LV_ASSERT_MALLOC(entry);
-        entry->life = -1;
+    if(entry) {
+        mask_cache_data_t * data = lv_cache_entry_get_data(entry);
+        data->circle.cache_entry = entry;
+        param->circle = &data->circle;
     }
+    /*Not cached (e.g. all the cached circles are used). Allocate one temporarily*/
     else {
-        entry->used_cnt++;
-        entry->life = 0;
-        CIRCLE_CACHE_AGING(entry->life, radius);
+        param->circle = lv_malloc(sizeof(lv_draw_sw_mask_radius_circle_dsc_t));
+        LV_ASSERT_MALLOC(param->circle);
+        *param->circle = search_key.circle;
     }
 
-    param->circle = entry;
-
-    circ_calc_aa4(param->circle, radius);
-    lv_mutex_unlock(&circle_cache_mutex);
-
+    lv_mutex_unlock(&mask_cache_mutex);
 }
 
 void lv_draw_sw_mask_fade_init(lv_draw_sw_mask_fade_param_t * param, const lv_area_t * coords, lv_opa_t opa_top,
@@ -968,14 +1082,18 @@ static lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_mask_fade(lv_opa_t *
     int32_t i;
 
     if(abs_y <= p->cfg.y_top) {
-        for(i = 0; i < len; i++) {
-            mask_buf[i] = mask_mix(mask_buf[i], p->cfg.opa_top);
+        if(LV_RESULT_INVALID == LV_DRAW_SW_MASK_MIX_OPA(mask_buf, p->cfg.opa_top, len)) {
+            for(i = 0; i < len; i++) {
+                mask_buf[i] = mask_mix(mask_buf[i], p->cfg.opa_top);
+            }
         }
         return LV_DRAW_SW_MASK_RES_CHANGED;
     }
     else if(abs_y >= p->cfg.y_bottom) {
-        for(i = 0; i < len; i++) {
-            mask_buf[i] = mask_mix(mask_buf[i], p->cfg.opa_bottom);
+        if(LV_RESULT_INVALID == LV_DRAW_SW_MASK_MIX_OPA(mask_buf, p->cfg.opa_bottom, len)) {
+            for(i = 0; i < len; i++) {
+                mask_buf[i] = mask_mix(mask_buf[i], p->cfg.opa_bottom);
+            }
         }
         return LV_DRAW_SW_MASK_RES_CHANGED;
     }
@@ -986,8 +1104,10 @@ static lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_mask_fade(lv_opa_t *
         lv_opa_t opa_act = LV_OPA_MIX2(abs_y - p->cfg.y_top, opa_diff) / y_diff;
         opa_act += p->cfg.opa_top;
 
-        for(i = 0; i < len; i++) {
-            mask_buf[i] = mask_mix(mask_buf[i], opa_act);
+        if(LV_RESULT_INVALID == LV_DRAW_SW_MASK_MIX_OPA(mask_buf, opa_act, len)) {
+            for(i = 0; i < len; i++) {
+                mask_buf[i] = mask_mix(mask_buf[i], opa_act);
+            }
         }
         return LV_DRAW_SW_MASK_RES_CHANGED;
     }
@@ -1019,9 +1139,11 @@ static lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_mask_map(lv_opa_t * m
         map_tmp += (abs_x - p->cfg.coords.x1);
     }
 
-    int32_t i;
-    for(i = 0; i < len; i++) {
-        mask_buf[i] = mask_mix(mask_buf[i], map_tmp[i]);
+    if(LV_RESULT_INVALID == LV_DRAW_SW_MASK_MIX_MAP(mask_buf, map_tmp, len)) {
+        int32_t i;
+        for(i = 0; i < len; i++) {
+            mask_buf[i] = mask_mix(mask_buf[i], map_tmp[i]);
+        }
     }
 
     return LV_DRAW_SW_MASK_RES_CHANGED;
@@ -1076,7 +1198,7 @@ static void circ_calc_aa4(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radiu
     /*Allocate buffers*/
     if(c->buf) lv_free(c->buf);
 
-    c->buf = lv_malloc(radius * 6 + 6);  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
+    c->buf = lv_malloc(CIRCLE_BUF_SIZE(radius));  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
     LV_ASSERT_MALLOC(c->buf);
     c->cir_opa = c->buf;
     c->opa_start_on_y = (uint16_t *)(c->buf + 2 * radius + 2);
@@ -1233,4 +1355,29 @@ static inline lv_opa_t LV_ATTRIBUTE_FAST_MEM mask_mix(lv_opa_t mask_act, lv_opa_
     return LV_UDIV255(mask_act * mask_new);
 }
 
+static lv_cache_compare_res_t mask_cache_compare_cb(const mask_cache_data_t * lhs, const mask_cache_data_t * rhs)
+{
+    if(lhs->type != rhs->type) return lhs->type > rhs->type ? 1 : -1;
+    if(lhs->radius != rhs->radius) return lhs->radius > rhs->radius ? 1 : -1;
+    if(lhs->width != rhs->width) return lhs->width > rhs->width ? 1 : -1;
+    if(lhs->w != rhs->w) return lhs->w > rhs->w ? 1 : -1;
+    if(lhs->h != rhs->h) return lhs->h > rhs->h ? 1 : -1;
+
+    return 0;
+}
+
+static void mask_cache_free_cb(mask_cache_data_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    if(entry->type == MASK_CACHE_CIRCLE) {
+        lv_free(entry->circle.buf);
+        entry->circle.buf = NULL;
+    }
+    else {
+        lv_free(entry->shadow_buf);
+        entry->shadow_buf = NULL;
+    }
+}
+
 #endif /*LV_DRAW_SW_COMPLEX*/
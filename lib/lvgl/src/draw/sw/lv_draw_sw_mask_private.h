@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_draw_sw_mask.h"
+#include "../../misc/cache/lv_cache.h"
 
 #if LV_DRAW_SW_COMPLEX
 
@@ -31,11 +32,17 @@ typedef struct  {
     lv_opa_t * cir_opa;         /**< Opacity of values on the circumference of an 1/4 circle */
     uint16_t * x_start_on_y;    /**< The x coordinate of the circle for each y value */
     uint16_t * opa_start_on_y;  /**< The index of `cir_opa` for each y value */
-    int32_t life;               /**< How many times the entry way used */
-    uint32_t used_cnt;          /**< Like a semaphore to count the referencing masks */
+    lv_cache_entry_t * cache_entry; /**< The entry of the mask cache holding the circle or NULL if not cached */
     int32_t radius;             /**< The radius of the entry */
 } lv_draw_sw_mask_radius_circle_dsc_t;
 
+typedef struct {
+    uint32_t hit_cnt;           /**< Number of circles and shadows found in the cache */
+    uint32_t miss_cnt;          /**< Number of circles and shadows which had to be calculated */
+    uint32_t size;              /**< Bytes used by the cache */
+    uint32_t max_size;          /**< The budget of the cache in bytes */
+} lv_draw_sw_mask_cache_info_t;
+
 struct lv_draw_sw_mask_common_dsc_t {
     lv_draw_sw_mask_xcb_t cb;
     lv_draw_sw_mask_type_t type;
@@ -132,17 +139,36 @@ struct lv_draw_sw_mask_map_param_t {
     } cfg;
 };
 
-typedef lv_draw_sw_mask_radius_circle_dsc_t lv_draw_sw_mask_radius_circle_dsc_arr_t[LV_DRAW_SW_CIRCLE_CACHE_SIZE];
-
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 /**
- * Called by LVGL the rendering of a screen is ready to clean up
- * the temporal (cache) data of the masks
+ * Copy a blurred shadow corner from the mask cache
+ * @param width     width of the shadow's blur
+ * @param radius    radius of the shadow
+ * @param w         width of the blurred rectangle (larger values don't change the corner)
+ * @param h         height of the blurred rectangle (larger values don't change the corner)
+ * @param buf       copy the `(width + radius)^2` opacities of the corner here
+ * @return          true: the corner was cached and copied
+ */
+bool lv_draw_sw_mask_cache_get_shadow(int32_t width, int32_t radius, int32_t w, int32_t h, lv_opa_t * buf);
+
+/**
+ * Add a copy of a blurred shadow corner to the mask cache
+ * @param width     width of the shadow's blur
+ * @param radius    radius of the shadow
+ * @param w         width of the blurred rectangle
+ * @param h         height of the blurred rectangle
+ * @param buf       the `(width + radius)^2` opacities of the corner
+ */
+void lv_draw_sw_mask_cache_add_shadow(int32_t width, int32_t radius, int32_t w, int32_t h, const lv_opa_t * buf);
+
+/**
+ * Get the statistics of the cache of circles and shadow corners
+ * @param info      store the statistics here
  */
-void lv_draw_sw_mask_cleanup(void);
+void lv_draw_sw_mask_cache_get_info(lv_draw_sw_mask_cache_info_t * info);
 
 /**********************
  *      MACROS
@@ -51,38 +51,77 @@ typedef struct {
 static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
                                      int32_t * yout);
 
+/**
+ * Narrow the range of a row to the pixels which can be in the image along one axis.
+ * The pixels outside of the range are surely out of the image, the ones inside might be in it.
+ * @param ups       upscaled source coordinate of the first pixel of the row
+ * @param step      change of `ups` on the next pixel, upscaled by 256 again
+ * @param size      width or height of the source image
+ * @param dest_w    number of pixels in the row
+ * @param x_start   the first pixel of the range, can be only increased
+ * @param x_end     the pixel after the range, can be only decreased
+ */
+static void transform_limit_row(int32_t ups, int32_t step, int32_t size, int32_t dest_w,
+                                int32_t * x_start, int32_t * x_end);
+
+/**
+ * Write the same as the transform functions for the pixels which are out of the image
+ * @param dest_buf  the row in the destination buffer
+ * @param abuf      the row in the alpha buffer for RGB565 and RGB565A8 images
+ * @param src_cf    color format of the source image
+ * @param recolor   true: L8 images are converted to ARGB8888 for recoloring
+ * @param x_from    the first pixel to clear
+ * @param x_to      the pixel after the last one to clear
+ */
+static void transform_clear(uint8_t * dest_buf, uint8_t * abuf, lv_color_format_t src_cf, bool recolor,
+                            int32_t x_from, int32_t x_to);
+
+static bool transform_right_angle_supported(lv_color_format_t src_cf);
+
+/**
+ * Copy a row of a multiple of 90 degrees rotated image. Every destination pixel is exactly on a source pixel
+ * so no interpolation is needed.
+ * @param xs        X coordinate of the first source pixel (not upscaled)
+ * @param ys        Y coordinate of the first source pixel (not upscaled)
+ * @param xs_step   -1, 0 or 1: the change of `xs` on the next destination pixel
+ * @param ys_step   -1, 0 or 1: the change of `ys` on the next destination pixel
+ */
+static void transform_right_angle(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                  int32_t xs, int32_t ys, int32_t xs_step, int32_t ys_step,
+                                  int32_t x_end, uint8_t * dest_buf, uint8_t * abuf, lv_color_format_t src_cf);
+
 #if LV_DRAW_SW_SUPPORT_RGB888
 static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                             int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size);
+                             int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size);
 #endif
 
 #if LV_DRAW_SW_SUPPORT_ARGB8888
 static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint8_t * dest_buf, bool aa);
+                               int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa);
 #endif
 
 #if LV_DRAW_SW_SUPPORT_RGB565A8
 static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa);
+                               int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa);
 #endif
 
 #if LV_DRAW_SW_SUPPORT_A8
 static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                         int32_t x_end, uint8_t * abuf, bool aa);
+                         int32_t x_start, int32_t x_end, uint8_t * abuf, bool aa);
 #endif
 
 #if LV_DRAW_SW_SUPPORT_L8
 static void transform_l8_to_al88(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                  int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                                 int32_t x_end, uint8_t * abuf, bool aa);
+                                 int32_t x_start, int32_t x_end, uint8_t * abuf, bool aa);
 
 static void transform_l8_to_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                      int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                                     int32_t x_end, uint8_t * abuf, bool aa);
+                                     int32_t x_start, int32_t x_end, uint8_t * abuf, bool aa);
 #endif
 
 /**********************
@@ -157,7 +196,7 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
     bool aa = (bool) draw_dsc->antialias;
     bool is_rotated = draw_dsc->rotation;
 
-    int32_t xs_ups = 0, ys_ups = 0, ys_ups_start = 0, ys_step_256_original = 0;
+    int32_t xs_ups = 0, ys_ups = 0, y_max = 0;
     int32_t xs_step_256 = 0, ys_step_256 = 0;
 
     /*When some of the color formats are disabled, these variables could be unused, avoid warning here*/
@@ -167,6 +206,21 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
     LV_UNUSED(xs_step_256);
     LV_UNUSED(ys_step_256);
 
+    /*Without scaling a multiple of 90 degrees maps every destination pixel exactly to a source pixel.
+     *The general path below would interpolate with the slightly inaccurate sine and cosine
+     *which could shift the image by a pixel and soften its edges.*/
+    bool right_angle = false;
+    int32_t ra_cos = 0, ra_sin = 0;
+    if(is_rotated && draw_dsc->rotation % 900 == 0 &&
+       draw_dsc->scale_x == LV_SCALE_NONE && draw_dsc->scale_y == LV_SCALE_NONE &&
+       transform_right_angle_supported(src_cf)) {
+        static const int8_t right_angle_cos[4] = {1, 0, -1, 0};
+        int32_t quarter = ((tr_dsc.angle % 3600 + 3600) % 3600) / 900;
+        ra_cos = right_angle_cos[quarter];
+        ra_sin = right_angle_cos[(quarter + 3) % 4];
+        right_angle = true;
+    }
+
     /*If scaled only make some simplification to avoid rounding errors.
      *For example if there is a 100x100 image zoomed to 300%
      *The destination area in X will be x1=0; x2=299
@@ -176,41 +230,51 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
      *As it's larger than 99.5 LVGL will start to mix the next coordinate
      *which is out of the image, so will make the pixel more transparent.
      *To avoid it in case of scale only limit the coordinates to the 0..297 range,
-     *that is to 0..(src_w-1)*zoom */
+     *that is to 0..(src_w-1)*zoom.
+     *The rows are mapped one by one (and not interpolated in `dest_area`) so that the result
+     *doesn't depend on how the image is split into areas, e.g. by a partial render buffer.*/
     if(is_rotated == false) {
         int32_t xs1_ups, ys1_ups, xs2_ups, ys2_ups;
 
         int32_t x_max = (((src_w - 1 - draw_dsc->pivot.x) * draw_dsc->scale_x) >> 8) + draw_dsc->pivot.x;
-        int32_t y_max = (((src_h - 1 - draw_dsc->pivot.y) * draw_dsc->scale_y) >> 8) + draw_dsc->pivot.y;
+        y_max = (((src_h - 1 - draw_dsc->pivot.y) * draw_dsc->scale_y) >> 8) + draw_dsc->pivot.y;
 
         lv_area_t dest_area_limited;
         dest_area_limited.x1 = dest_area->x1 > x_max ? x_max : dest_area->x1;
         dest_area_limited.x2 = dest_area->x2 > x_max ? x_max : dest_area->x2;
-        dest_area_limited.y1 = dest_area->y1 > y_max ? y_max : dest_area->y1;
-        dest_area_limited.y2 = dest_area->y2 > y_max ? y_max : dest_area->y2;
 
-        transform_point_upscaled(&tr_dsc, dest_area_limited.x1, dest_area_limited.y1, &xs1_ups, &ys1_ups);
-        transform_point_upscaled(&tr_dsc, dest_area_limited.x2, dest_area_limited.y2, &xs2_ups, &ys2_ups);
+        transform_point_upscaled(&tr_dsc, dest_area_limited.x1, 0, &xs1_ups, &ys1_ups);
+        transform_point_upscaled(&tr_dsc, dest_area_limited.x2, 0, &xs2_ups, &ys2_ups);
 
         int32_t xs_diff = xs2_ups - xs1_ups;
-        int32_t ys_diff = ys2_ups - ys1_ups;
         xs_step_256 = 0;
-        ys_step_256_original = 0;
         if(dest_w > 1) {
             xs_step_256 = (256 * xs_diff) / (dest_w - 1);
         }
-        if(dest_h > 1) {
-            ys_step_256_original = (256 * ys_diff) / (dest_h - 1);
-        }
 
         xs_ups = xs1_ups + 0x80;
-        ys_ups_start = ys1_ups + 0x80;
     }
 
     int32_t y;
     for(y = 0; y < dest_h; y++) {
+        if(right_angle) {
+            int32_t x_rel = dest_area->x1 - tr_dsc.pivot.x;
+            int32_t y_rel = dest_area->y1 + y - tr_dsc.pivot.y;
+            int32_t xs = ra_cos * x_rel - ra_sin * y_rel + tr_dsc.pivot.x;
+            int32_t ys = ra_sin * x_rel + ra_cos * y_rel + tr_dsc.pivot.y;
+            transform_right_angle(src_buf, src_w, src_h, src_stride, xs, ys, ra_cos, ra_sin, dest_w, dest_buf,
+                                  alpha_buf, src_cf);
+
+            dest_buf = (uint8_t *)dest_buf + dest_stride;
+            if(alpha_buf) alpha_buf += dest_stride_a8;
+            continue;
+        }
+
         if(is_rotated == false) {
-            ys_ups = ys_ups_start + ((ys_step_256_original * y) >> 8);
+            int32_t xs_tmp;
+            int32_t y_limited = dest_area->y1 + y > y_max ? y_max : dest_area->y1 + y;
+            transform_point_upscaled(&tr_dsc, 0, y_limited, &xs_tmp, &ys_ups);
+            ys_ups += 0x80;
             ys_step_256 = 0;
         }
         else {
@@ -231,50 +295,63 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
             ys_ups = ys1_ups + 0x80;
         }
 
+        /*The rotated image usually covers only a part of the row.
+         *Clear the rest at once instead of transforming it pixel by pixel.*/
+        int32_t x_start = 0;
+        int32_t x_end = dest_w;
+        if(is_rotated) {
+            transform_limit_row(xs_ups, xs_step_256, src_w, dest_w, &x_start, &x_end);
+            transform_limit_row(ys_ups, ys_step_256, src_h, dest_w, &x_start, &x_end);
+            if(x_end < x_start) x_end = x_start;
+            transform_clear(dest_buf, alpha_buf, src_cf, draw_dsc->recolor_opa >= LV_OPA_MIN, 0, x_start);
+            transform_clear(dest_buf, alpha_buf, src_cf, draw_dsc->recolor_opa >= LV_OPA_MIN, x_end, dest_w);
+        }
+
         switch(src_cf) {
 #if LV_DRAW_SW_SUPPORT_XRGB8888
             case LV_COLOR_FORMAT_XRGB8888:
-                transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa,
-                                 4);
+                transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                 x_start, x_end, dest_buf, aa, 4);
                 break;
 #endif
 #if LV_DRAW_SW_SUPPORT_RGB888
             case LV_COLOR_FORMAT_RGB888:
-                transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa,
-                                 3);
+                transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                 x_start, x_end, dest_buf, aa, 3);
                 break;
 #endif
 #if LV_DRAW_SW_SUPPORT_A8
             case LV_COLOR_FORMAT_A8:
-                transform_a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa);
+                transform_a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                             x_start, x_end, dest_buf, aa);
                 break;
 #endif
 #if LV_DRAW_SW_SUPPORT_ARGB8888
             case LV_COLOR_FORMAT_ARGB8888:
-                transform_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                   aa);
+                transform_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                   x_start, x_end, dest_buf, aa);
                 break;
 #endif
 #if LV_DRAW_SW_SUPPORT_RGB565 && LV_DRAW_SW_SUPPORT_RGB565A8
             case LV_COLOR_FORMAT_RGB565:
-                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                   alpha_buf, false, aa);
+                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                   x_start, x_end, dest_buf, alpha_buf, false, aa);
                 break;
 #endif
 #if LV_DRAW_SW_SUPPORT_RGB565A8
             case LV_COLOR_FORMAT_RGB565A8:
-                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w,
-                                   (uint16_t *)dest_buf,
-                                   alpha_buf, true, aa);
+                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                   x_start, x_end, (uint16_t *)dest_buf, alpha_buf, true, aa);
                 break;
 #endif
 #if LV_DRAW_SW_SUPPORT_L8
             case LV_COLOR_FORMAT_L8:
                 if(draw_dsc->recolor_opa >= LV_OPA_MIN)
-                    transform_l8_to_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                             aa);
+                    transform_l8_to_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                             x_start, x_end, dest_buf, aa);
                 else
-                    transform_l8_to_al88(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa);
+                    transform_l8_to_al88(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                         x_start, x_end, dest_buf, aa);
                 break;
 #endif
             default:
@@ -294,16 +371,20 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
 
 static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                             int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size)
+                             int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
+    /*Accumulate the steps instead of multiplying them by `x` in every iteration*/
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
     int32_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = x_start; x < x_end; x++, xs_acc += xs_step, ys_acc += ys_step) {
+        xs_ups = xs_ups_start + (xs_acc >> 8);
+        ys_ups = ys_ups_start + (ys_acc >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
@@ -351,13 +432,20 @@ static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h,
            ys_int + y_next >= 0 &&
            ys_int + y_next <= src_h - 1) {
             const uint8_t * px_hor_u8 = src_u8 + (int32_t)(x_next * px_size);
+            const uint8_t * px_ver_u8 = src_u8 + (int32_t)(y_next * src_stride);
+
+            /*Inside a single colored area there is nothing to mix*/
+            if(px_hor_u8[0] == src_u8[0] && px_hor_u8[1] == src_u8[1] && px_hor_u8[2] == src_u8[2] &&
+               px_ver_u8[0] == src_u8[0] && px_ver_u8[1] == src_u8[1] && px_ver_u8[2] == src_u8[2]) {
+                continue;
+            }
+
             lv_color32_t px_hor;
             px_hor.red = px_hor_u8[2];
             px_hor.green = px_hor_u8[1];
             px_hor.blue = px_hor_u8[0];
             px_hor.alpha = 0xff;
 
-            const uint8_t * px_ver_u8 = src_u8 + (int32_t)(y_next * src_stride);
             lv_color32_t px_ver;
             px_ver.red = px_ver_u8[2];
             px_ver.green = px_ver_u8[1];
@@ -394,16 +482,19 @@ static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h,
 
 static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint8_t * dest_buf, bool aa)
+                               int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
     int32_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = x_start; x < x_end; x++, xs_acc += xs_step, ys_acc += ys_step) {
+        xs_ups = xs_ups_start + (xs_acc >> 8);
+        ys_ups = ys_ups_start + (ys_acc >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
@@ -414,6 +505,14 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
             continue;
         }
 
+        const lv_color32_t * src_c32 = (const lv_color32_t *)(src + ys_int * src_stride + xs_int * 4);
+
+        /*Without anti-aliasing only the pixels on the edges of the image are faded*/
+        if(!aa && xs_int > 0 && xs_int < src_w - 1 && ys_int > 0 && ys_int < src_h - 1) {
+            dest_c32[x] = src_c32[0];
+            continue;
+        }
+
         /*Get the direction the hor and ver neighbor
          *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
         int32_t xs_fract = xs_ups & 0xFF;
@@ -438,8 +537,6 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
             ys_fract = ys_fract - 0x80;
         }
 
-        const lv_color32_t * src_c32 = (const lv_color32_t *)(src + ys_int * src_stride + xs_int * 4);
-
         dest_c32[x] = src_c32[0];
 
         if(aa &&
@@ -451,6 +548,9 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
             lv_color32_t px_hor = src_c32[x_next];
             lv_color32_t px_ver = *(const lv_color32_t *)((uint8_t *)src_c32 + y_next * src_stride);
 
+            /*Inside a single colored area (e.g. the inner part of an opaque image) there is nothing to mix*/
+            if(lv_color32_eq(dest_c32[x], px_hor) && lv_color32_eq(dest_c32[x], px_ver)) continue;
+
             if(px_ver.alpha == 0) {
                 dest_c32[x].alpha = (dest_c32[x].alpha * (0xFF - ys_fract)) >> 8;
             }
@@ -487,7 +587,7 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
 
 static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa)
+                               int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
@@ -497,10 +597,13 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
     /*Must be signed type, because we would use negative array index calculated from stride*/
     int32_t alpha_stride = src_stride / 2; /*alpha map stride is always half of RGB map stride*/
 
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
     int32_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = x_start; x < x_end; x++, xs_acc += xs_step, ys_acc += ys_step) {
+        xs_ups = xs_ups_start + (xs_acc >> 8);
+        ys_ups = ys_ups_start + (ys_acc >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
@@ -602,15 +705,18 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
 
 static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                         int32_t x_end, uint8_t * abuf, bool aa)
+                         int32_t x_start, int32_t x_end, uint8_t * abuf, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
 
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
     int32_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = x_start; x < x_end; x++, xs_acc += xs_step, ys_acc += ys_step) {
+        xs_ups = xs_ups_start + (xs_acc >> 8);
+        ys_ups = ys_ups_start + (ys_acc >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
@@ -683,16 +789,19 @@ static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int3
 /* L8 will be transformed into an AL88 buffer, because it will not be recolored */
 static void transform_l8_to_al88(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                  int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                                 int32_t x_end, uint8_t * dest_buf, bool aa)
+                                 int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
     lv_color16a_t * dest_al88 = (lv_color16a_t *)dest_buf;
 
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
     int32_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = x_start; x < x_end; x++, xs_acc += xs_step, ys_acc += ys_step) {
+        xs_ups = xs_ups_start + (xs_acc >> 8);
+        ys_ups = ys_ups_start + (ys_acc >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
@@ -764,16 +873,19 @@ static void transform_l8_to_al88(const uint8_t * src, int32_t src_w, int32_t src
 /* L8 has to be transformed into an ARGB8888 buffer, because it will be recolored as well */
 static void transform_l8_to_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                      int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                                     int32_t x_end, uint8_t * dest_buf, bool aa)
+                                     int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *)dest_buf;
 
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
     int32_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = x_start; x < x_end; x++, xs_acc += xs_step, ys_acc += ys_step) {
+        xs_ups = xs_ups_start + (xs_acc >> 8);
+        ys_ups = ys_ups_start + (ys_acc >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
@@ -841,6 +953,178 @@ static void transform_l8_to_argb8888(const uint8_t * src, int32_t src_w, int32_t
 
 #endif
 
+static void transform_limit_row(int32_t ups, int32_t step, int32_t size, int32_t dest_w,
+                                int32_t * x_start, int32_t * x_end)
+{
+    /*The pixel `x` is in the image if 0 <= ups + ((step * x) >> 8) < size * 256.
+     *As the shift rounds down by less than 1 it requires
+     *lo <= step * x < hi with lo = -ups * 256 and hi = (size * 256 - ups) * 256*/
+    int64_t lo = -(int64_t)ups * 256;
+    int64_t hi = ((int64_t)size * 256 - ups) * 256;
+    int64_t first;
+    int64_t last;
+
+    if(step == 0) {
+        if(lo > 0 || hi <= 0) *x_end = *x_start;
+        return;
+    }
+    else if(step > 0) {
+        /*x >= ceil(lo / step) and x <= ceil(hi / step) - 1*/
+        first = lo > 0 ? (lo + step - 1) / step : -(-lo / step);
+        last = (hi > 0 ? (hi + step - 1) / step : -(-hi / step)) - 1;
+    }
+    else {
+        /*x <= floor(lo / step) and x >= floor(hi / step) + 1*/
+        int64_t step_abs = -(int64_t)step;
+        first = (-hi >= 0 ? -hi / step_abs : -((hi + step_abs - 1) / step_abs)) + 1;
+        last = -lo >= 0 ? -lo / step_abs : -((lo + step_abs - 1) / step_abs);
+    }
+
+    if(first > *x_start) *x_start = first > dest_w ? dest_w : (int32_t)first;
+    if(last + 1 < *x_end) *x_end = last + 1 < 0 ? 0 : (int32_t)(last + 1);
+}
+
+static void transform_clear(uint8_t * dest_buf, uint8_t * abuf, lv_color_format_t src_cf, bool recolor,
+                            int32_t x_from, int32_t x_to)
+{
+    if(x_from >= x_to) return;
+
+    int32_t x;
+    switch(src_cf) {
+        case LV_COLOR_FORMAT_XRGB8888:
+        case LV_COLOR_FORMAT_RGB888:
+            /*Only the alpha channel is set*/
+            for(x = x_from; x < x_to; x++) {
+                ((lv_color32_t *)dest_buf)[x].alpha = 0x00;
+            }
+            break;
+        case LV_COLOR_FORMAT_ARGB8888:
+            lv_memzero(dest_buf + x_from * 4, (x_to - x_from) * 4);
+            break;
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_RGB565A8:
+            lv_memzero(abuf + x_from, x_to - x_from);
+            break;
+        case LV_COLOR_FORMAT_A8:
+            lv_memzero(dest_buf + x_from, x_to - x_from);
+            break;
+        case LV_COLOR_FORMAT_L8: {
+                uint32_t px_size = recolor ? 4 : 2;
+                lv_memzero(dest_buf + x_from * px_size, (x_to - x_from) * px_size);
+                break;
+            }
+        default:
+            break;
+    }
+}
+
+static bool transform_right_angle_supported(lv_color_format_t src_cf)
+{
+    switch(src_cf) {
+#if LV_DRAW_SW_SUPPORT_ARGB8888
+        case LV_COLOR_FORMAT_ARGB8888:
+#endif
+#if LV_DRAW_SW_SUPPORT_XRGB8888
+        case LV_COLOR_FORMAT_XRGB8888:
+#endif
+#if LV_DRAW_SW_SUPPORT_RGB888
+        case LV_COLOR_FORMAT_RGB888:
+#endif
+#if LV_DRAW_SW_SUPPORT_RGB565 && LV_DRAW_SW_SUPPORT_RGB565A8
+        case LV_COLOR_FORMAT_RGB565:
+#endif
+#if LV_DRAW_SW_SUPPORT_RGB565A8
+        case LV_COLOR_FORMAT_RGB565A8:
+#endif
+#if LV_DRAW_SW_SUPPORT_A8
+        case LV_COLOR_FORMAT_A8:
+#endif
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void transform_right_angle(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                  int32_t xs, int32_t ys, int32_t xs_step, int32_t ys_step,
+                                  int32_t x_end, uint8_t * dest_buf, uint8_t * abuf, lv_color_format_t src_cf)
+{
+    int32_t x;
+    switch(src_cf) {
+#if LV_DRAW_SW_SUPPORT_ARGB8888
+        case LV_COLOR_FORMAT_ARGB8888: {
+                uint32_t * dest_u32 = (uint32_t *)dest_buf;
+                for(x = 0; x < x_end; x++, xs += xs_step, ys += ys_step) {
+                    if(xs < 0 || xs >= src_w || ys < 0 || ys >= src_h) {
+                        dest_u32[x] = 0x00000000;
+                        continue;
+                    }
+                    dest_u32[x] = *(const uint32_t *)(src + ys * src_stride + xs * 4);
+                }
+                break;
+            }
+#endif
+#if LV_DRAW_SW_SUPPORT_XRGB8888 || LV_DRAW_SW_SUPPORT_RGB888
+        case LV_COLOR_FORMAT_XRGB8888:
+        case LV_COLOR_FORMAT_RGB888: {
+                uint32_t px_size = src_cf == LV_COLOR_FORMAT_RGB888 ? 3 : 4;
+                lv_color32_t * dest_c32 = (lv_color32_t *)dest_buf;
+                for(x = 0; x < x_end; x++, xs += xs_step, ys += ys_step) {
+                    if(xs < 0 || xs >= src_w || ys < 0 || ys >= src_h) {
+                        *((uint32_t *)&dest_c32[x]) = 0x00000000;
+                        continue;
+                    }
+                    const uint8_t * src_u8 = src + ys * src_stride + xs * px_size;
+                    dest_c32[x].red = src_u8[2];
+                    dest_c32[x].green = src_u8[1];
+                    dest_c32[x].blue = src_u8[0];
+                    dest_c32[x].alpha = 0xff;
+                }
+                break;
+            }
+#endif
+#if LV_DRAW_SW_SUPPORT_RGB565A8
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_RGB565A8: {
+                uint16_t * cbuf = (uint16_t *)dest_buf;
+                /*The alpha map stride is always half of RGB map stride*/
+                const lv_opa_t * src_alpha = src_cf == LV_COLOR_FORMAT_RGB565A8 ? src + src_stride * src_h : NULL;
+                int32_t alpha_stride = src_stride / 2;
+                for(x = 0; x < x_end; x++, xs += xs_step, ys += ys_step) {
+                    if(xs < 0 || xs >= src_w || ys < 0 || ys >= src_h) {
+                        abuf[x] = 0x00;
+                        continue;
+                    }
+                    cbuf[x] = *(const uint16_t *)(src + ys * src_stride + xs * 2);
+                    abuf[x] = src_alpha ? src_alpha[ys * alpha_stride + xs] : 0xff;
+                }
+                break;
+            }
+#endif
+#if LV_DRAW_SW_SUPPORT_A8
+        case LV_COLOR_FORMAT_A8:
+            for(x = 0; x < x_end; x++, xs += xs_step, ys += ys_step) {
+                if(xs < 0 || xs >= src_w || ys < 0 || ys >= src_h) {
+                    dest_buf[x] = 0x00;
+                    continue;
+                }
+                dest_buf[x] = src[ys * src_stride + xs];
+            }
+            break;
+#endif
+        default:
+            LV_UNUSED(src);
+            LV_UNUSED(src_w);
+            LV_UNUSED(src_h);
+            LV_UNUSED(src_stride);
+            LV_UNUSED(x_end);
+            LV_UNUSED(dest_buf);
+            LV_UNUSED(abuf);
+            LV_UNUSED(x);
+            break;
+    }
+}
+
 static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
                                      int32_t * yout)
 {
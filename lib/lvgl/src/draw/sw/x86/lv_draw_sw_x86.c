@@ -0,0 +1,118 @@
+/**
+ * @file lv_draw_sw_x86.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_draw_sw_x86_private.h"
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_SIMD
+
+#include "../../../misc/lv_math.h"
+#include "../../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+#if LV_DRAW_SW_COMPLEX
+static inline lv_x86_vec_t mask_mix(lv_x86_vec_t mask_act, lv_x86_vec_t mask_new);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LV_DRAW_SW_COMPLEX
+
+lv_result_t lv_draw_sw_mask_mix_opa_x86(lv_opa_t * mask_buf, lv_opa_t opa, int32_t len)
+{
+    /*The same shortcuts as `mask_mix` takes for every pixel*/
+    if(opa >= LV_OPA_MAX) return LV_RESULT_OK;
+    if(opa <= LV_OPA_MIN) {
+        lv_memzero(mask_buf, len);
+        return LV_RESULT_OK;
+    }
+
+    lv_x86_vec_t opa_v = LV_X86_SET16(opa);
+
+    int32_t i;
+    for(i = 0; i <= len - LV_X86_PX16; i += LV_X86_PX16) {
+        LV_X86_STORE_16_U8(&mask_buf[i], mask_mix(LV_X86_LOAD_U8_16(&mask_buf[i]), opa_v));
+    }
+
+    if(i < len) {
+        lv_opa_t mask_tmp[LV_X86_PX16];
+        lv_memzero(mask_tmp, sizeof(mask_tmp));
+        lv_memcpy(mask_tmp, &mask_buf[i], len - i);
+        LV_X86_STORE_16_U8(mask_tmp, mask_mix(LV_X86_LOAD_U8_16(mask_tmp), opa_v));
+        lv_memcpy(&mask_buf[i], mask_tmp, len - i);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_mask_mix_map_x86(lv_opa_t * mask_buf, const lv_opa_t * map, int32_t len)
+{
+    int32_t i;
+    for(i = 0; i <= len - LV_X86_PX16; i += LV_X86_PX16) {
+        LV_X86_STORE_16_U8(&mask_buf[i], mask_mix(LV_X86_LOAD_U8_16(&mask_buf[i]), LV_X86_LOAD_U8_16(&map[i])));
+    }
+
+    if(i < len) {
+        lv_opa_t mask_tmp[LV_X86_PX16];
+        lv_opa_t map_tmp[LV_X86_PX16];
+        lv_memzero(mask_tmp, sizeof(mask_tmp));
+        lv_memzero(map_tmp, sizeof(map_tmp));
+        lv_memcpy(mask_tmp, &mask_buf[i], len - i);
+        lv_memcpy(map_tmp, &map[i], len - i);
+        LV_X86_STORE_16_U8(mask_tmp, mask_mix(LV_X86_LOAD_U8_16(mask_tmp), LV_X86_LOAD_U8_16(map_tmp)));
+        lv_memcpy(&mask_buf[i], mask_tmp, len - i);
+    }
+
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_DRAW_SW_COMPLEX*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_DRAW_SW_COMPLEX
+
+/**
+ * The same as `mask_mix` of `lv_draw_sw_mask.c` on 16 bit lanes
+ * @param mask_act  the current mask values
+ * @param mask_new  the mask values to mix with
+ * @return          the mixed mask values
+ */
+static inline lv_x86_vec_t mask_mix(lv_x86_vec_t mask_act, lv_x86_vec_t mask_new)
+{
+    /*LV_UDIV255(x) is (x * 0x8081) >> 23, i.e. the high half of the product shifted by 7*/
+    lv_x86_vec_t res = LV_X86_SRL16(LV_X86_MULHI16(LV_X86_MULLO16(mask_act, mask_new), LV_X86_SET16(0x8081)), 7);
+    res = LV_X86_SELECT(LV_X86_CMPGT16(mask_new, LV_X86_SET16(LV_OPA_MAX - 1)), mask_act, res);
+    return LV_X86_ANDNOT(LV_X86_CMPGT16(LV_X86_SET16(LV_OPA_MIN + 1), mask_new), res);
+}
+
+#endif /*LV_DRAW_SW_COMPLEX*/
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_SIMD*/
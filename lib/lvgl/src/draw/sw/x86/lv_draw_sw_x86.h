@@ -0,0 +1,91 @@
+/**
+ * @file lv_draw_sw_x86.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_X86_H
+#define LV_DRAW_SW_X86_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../../lv_conf_internal.h"
+
+/*Detect SSE2 based on the compilers' predefined macros. It's always available on x86-64.*/
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define LV_DRAW_SW_X86_SIMD     1
+#else
+    #define LV_DRAW_SW_X86_SIMD     0
+#endif
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_SIMD
+
+#include "../../../misc/lv_types.h"
+
+#ifdef LV_DRAW_SW_X86_CUSTOM_INCLUDE
+#include LV_DRAW_SW_X86_CUSTOM_INCLUDE
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if LV_DRAW_SW_COMPLEX
+
+#ifndef LV_DRAW_SW_MASK_MIX_OPA
+#define LV_DRAW_SW_MASK_MIX_OPA(mask_buf, opa, len) \
+    lv_draw_sw_mask_mix_opa_x86(mask_buf, opa, len)
+#endif
+
+#ifndef LV_DRAW_SW_MASK_MIX_MAP
+#define LV_DRAW_SW_MASK_MIX_MAP(mask_buf, map, len) \
+    lv_draw_sw_mask_mix_map_x86(mask_buf, map, len)
+#endif
+
+#endif /*LV_DRAW_SW_COMPLEX*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/* The functions give the same result as the C implementations, bit by bit.
+ * They use SSE2, or AVX2 if the compiler targets it (e.g. with `-mavx2` or `-march=native`).*/
+
+/**
+ * Mix a mask row with a constant opacity the same way as `mask_mix` of `lv_draw_sw_mask.c`
+ * @param mask_buf  the mask row to modify
+ * @param opa       the opacity to mix with
+ * @param len       number of mask pixels
+ * @return          LV_RESULT_OK
+ */
+lv_result_t lv_draw_sw_mask_mix_opa_x86(lv_opa_t * mask_buf, lv_opa_t opa, int32_t len);
+
+/**
+ * Mix a mask row with an other mask row the same way as `mask_mix` of `lv_draw_sw_mask.c`
+ * @param mask_buf  the mask row to modify
+ * @param map       the mask to mix with
+ * @param len       number of mask pixels
+ * @return          LV_RESULT_OK
+ */
+lv_result_t lv_draw_sw_mask_mix_map_x86(lv_opa_t * mask_buf, const lv_opa_t * map, int32_t len);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_SIMD*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_X86_H*/
@@ -0,0 +1,239 @@
+/**
+ * @file lv_draw_sw_x86_private.h
+ *
+ * Vector operations used by the SSE2/AVX2 kernels. A vector is 128 bit with SSE2
+ * and 256 bit if the compiler targets AVX2, so the kernels are written once for
+ * `LV_X86_PX16` 16 bit or `LV_X86_PX32` 32 bit pixels per vector.
+ */
+
+#ifndef LV_DRAW_SW_X86_PRIVATE_H
+#define LV_DRAW_SW_X86_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_draw_sw_x86.h"
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_SIMD
+
+#include "../../../misc/lv_color.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if defined(__AVX2__)
+
+typedef __m256i lv_x86_vec_t;
+
+#define LV_X86_PX16                 16
+#define LV_X86_PX32                 8
+#define LV_X86_MOVEMASK_ALL         0xFFFFFFFFU
+
+#define LV_X86_LOAD(p)              _mm256_loadu_si256((const __m256i *)(const void *)(p))
+#define LV_X86_STORE(p, v)          _mm256_storeu_si256((__m256i *)(void *)(p), v)
+#define LV_X86_ZERO()               _mm256_setzero_si256()
+#define LV_X86_SET16(x)             _mm256_set1_epi16((short)(x))
+#define LV_X86_SET32(x)             _mm256_set1_epi32((int)(x))
+
+#define LV_X86_AND(a, b)            _mm256_and_si256(a, b)
+#define LV_X86_OR(a, b)             _mm256_or_si256(a, b)
+#define LV_X86_ANDNOT(a, b)         _mm256_andnot_si256(a, b)
+
+#define LV_X86_ADD16(a, b)          _mm256_add_epi16(a, b)
+#define LV_X86_SUB16(a, b)          _mm256_sub_epi16(a, b)
+#define LV_X86_MULLO16(a, b)        _mm256_mullo_epi16(a, b)
+#define LV_X86_MULHI16(a, b)        _mm256_mulhi_epu16(a, b)
+#define LV_X86_SRL16(v, n)          _mm256_srli_epi16(v, n)
+#define LV_X86_SLL16(v, n)          _mm256_slli_epi16(v, n)
+#define LV_X86_CMPEQ16(a, b)        _mm256_cmpeq_epi16(a, b)
+#define LV_X86_CMPGT16(a, b)        _mm256_cmpgt_epi16(a, b)
+
+#define LV_X86_ADD32(a, b)          _mm256_add_epi32(a, b)
+#define LV_X86_SUB32(a, b)          _mm256_sub_epi32(a, b)
+#define LV_X86_SRL32(v, n)          _mm256_srli_epi32(v, n)
+#define LV_X86_SLL32(v, n)          _mm256_slli_epi32(v, n)
+#define LV_X86_SRA32(v, n)          _mm256_srai_epi32(v, n)
+#define LV_X86_CMPEQ32(a, b)        _mm256_cmpeq_epi32(a, b)
+#define LV_X86_CMPGT32(a, b)        _mm256_cmpgt_epi32(a, b)
+
+#define LV_X86_MOVEMASK(v)          ((uint32_t)_mm256_movemask_epi8(v))
+
+/*Truncated `a / b` of non-negative integers below 2^24 that are exact in float*/
+#define LV_X86_DIV32(a, b)          _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(a), _mm256_cvtepi32_ps(b)))
+
+/*`LV_X86_PX16` bytes to 16 bit lanes*/
+#define LV_X86_LOAD_U8_16(p)        _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(const void *)(p)))
+/*`LV_X86_PX32` bytes to 32 bit lanes*/
+#define LV_X86_LOAD_U8_32(p)        _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(const void *)(p)))
+/*`LV_X86_PX32` halfwords to 32 bit lanes*/
+#define LV_X86_LOAD_U16_32(p)       _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(const void *)(p)))
+
+/*Store 16 bit lanes of 0..255 as `LV_X86_PX16` bytes*/
+#define LV_X86_STORE_16_U8(p, v)    \
+    _mm_storeu_si128((__m128i *)(void *)(p), _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0x08)))
+/*Store 32 bit lanes of 0..65535 as `LV_X86_PX32` halfwords*/
+#define LV_X86_STORE_32_U16(p, v)   \
+    _mm_storeu_si128((__m128i *)(void *)(p), _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packs_epi32(lv_x86_sext16(v), lv_x86_sext16(v)), 0x08)))
+
+#else
+
+typedef __m128i lv_x86_vec_t;
+
+#define LV_X86_PX16                 8
+#define LV_X86_PX32                 4
+#define LV_X86_MOVEMASK_ALL         0xFFFFU
+
+#define LV_X86_LOAD(p)              _mm_loadu_si128((const __m128i *)(const void *)(p))
+#define LV_X86_STORE(p, v)          _mm_storeu_si128((__m128i *)(void *)(p), v)
+#define LV_X86_ZERO()               _mm_setzero_si128()
+#define LV_X86_SET16(x)             _mm_set1_epi16((short)(x))
+#define LV_X86_SET32(x)             _mm_set1_epi32((int)(x))
+
+#define LV_X86_AND(a, b)            _mm_and_si128(a, b)
+#define LV_X86_OR(a, b)             _mm_or_si128(a, b)
+#define LV_X86_ANDNOT(a, b)         _mm_andnot_si128(a, b)
+
+#define LV_X86_ADD16(a, b)          _mm_add_epi16(a, b)
+#define LV_X86_SUB16(a, b)          _mm_sub_epi16(a, b)
+#define LV_X86_MULLO16(a, b)        _mm_mullo_epi16(a, b)
+#define LV_X86_MULHI16(a, b)        _mm_mulhi_epu16(a, b)
+#define LV_X86_SRL16(v, n)          _mm_srli_epi16(v, n)
+#define LV_X86_SLL16(v, n)          _mm_slli_epi16(v, n)
+#define LV_X86_CMPEQ16(a, b)        _mm_cmpeq_epi16(a, b)
+#define LV_X86_CMPGT16(a, b)        _mm_cmpgt_epi16(a, b)
+
+#define LV_X86_ADD32(a, b)          _mm_add_epi32(a, b)
+#define LV_X86_SUB32(a, b)          _mm_sub_epi32(a, b)
+#define LV_X86_SRL32(v, n)          _mm_srli_epi32(v, n)
+#define LV_X86_SLL32(v, n)          _mm_slli_epi32(v, n)
+#define LV_X86_SRA32(v, n)          _mm_srai_epi32(v, n)
+#define LV_X86_CMPEQ32(a, b)        _mm_cmpeq_epi32(a, b)
+#define LV_X86_CMPGT32(a, b)        _mm_cmpgt_epi32(a, b)
+
+#define LV_X86_MOVEMASK(v)          ((uint32_t)_mm_movemask_epi8(v))
+
+#define LV_X86_DIV32(a, b)          _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(a), _mm_cvtepi32_ps(b)))
+
+#define LV_X86_LOAD_U8_16(p)        _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(const void *)(p)), _mm_setzero_si128())
+#define LV_X86_LOAD_U8_32(p)        \
+    _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)lv_x86_get_u32(p)), _mm_setzero_si128()), _mm_setzero_si128())
+#define LV_X86_LOAD_U16_32(p)       _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)(const void *)(p)), _mm_setzero_si128())
+
+#define LV_X86_STORE_16_U8(p, v)    _mm_storel_epi64((__m128i *)(void *)(p), _mm_packus_epi16(v, v))
+#define LV_X86_STORE_32_U16(p, v)   _mm_storel_epi64((__m128i *)(void *)(p), _mm_packs_epi32(lv_x86_sext16(v), lv_x86_sext16(v)))
+
+#endif
+
+/*`mask ? a : b` for each lane. `mask` has to be all 0 or all 1 bits in each lane.*/
+#define LV_X86_SELECT(mask, a, b)   LV_X86_OR(LV_X86_AND(mask, a), LV_X86_ANDNOT(mask, b))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Sign extend the low halfword of the 32 bit lanes. Saturating packing is signed
+ * in SSE2 so this way the halfwords are packed unchanged.
+ */
+static inline lv_x86_vec_t lv_x86_sext16(lv_x86_vec_t v)
+{
+    return LV_X86_SRA32(LV_X86_SLL32(v, 16), 16);
+}
+
+static inline uint32_t lv_x86_get_u32(const void * p)
+{
+    const uint8_t * p8 = p;
+    return (uint32_t)p8[0] | ((uint32_t)p8[1] << 8) | ((uint32_t)p8[2] << 16) | ((uint32_t)p8[3] << 24);
+}
+
+/**
+ * Mix the RGB channels of ARGB8888 colors the same way as `lv_color_mix32`
+ * without checking `mix` for the fully transparent and fully opaque cases.
+ * @param fg        the foreground colors
+ * @param bg        the background colors
+ * @param mix       0..255 opacity of the foreground in the 32 bit lanes
+ * @return          the mixed colors, the alpha channel is 0
+ */
+static inline lv_x86_vec_t lv_x86_mix_rgb888(lv_x86_vec_t fg, lv_x86_vec_t bg, lv_x86_vec_t mix)
+{
+    /*Red and blue are mixed in the two halfwords, green in the lower one. 255 * 255 fits into 16 bits.*/
+    lv_x86_vec_t mask_rb = LV_X86_SET32(0x00FF00FF);
+    lv_x86_vec_t mask_g = LV_X86_SET32(0x000000FF);
+    lv_x86_vec_t mix2 = LV_X86_OR(mix, LV_X86_SLL32(mix, 16));
+    lv_x86_vec_t mix2_inv = LV_X86_SUB16(mask_rb, mix2);
+
+    lv_x86_vec_t rb = LV_X86_ADD16(LV_X86_MULLO16(LV_X86_AND(fg, mask_rb), mix2),
+                                   LV_X86_MULLO16(LV_X86_AND(bg, mask_rb), mix2_inv));
+    lv_x86_vec_t g = LV_X86_ADD16(LV_X86_MULLO16(LV_X86_AND(LV_X86_SRL32(fg, 8), mask_g), mix2),
+                                  LV_X86_MULLO16(LV_X86_AND(LV_X86_SRL32(bg, 8), mask_g), mix2_inv));
+
+    return LV_X86_OR(LV_X86_SRL16(rb, 8), LV_X86_SLL32(LV_X86_SRL16(g, 8), 8));
+}
+
+/**
+ * Mix ARGB8888 colors the same way as `lv_color_32_32_mix` of `lv_draw_sw_blend_to_argb8888.c`
+ * @param fg        the foreground colors
+ * @param bg        the background colors
+ * @return          the mixed colors
+ */
+static inline lv_x86_vec_t lv_x86_mix_argb8888(lv_x86_vec_t fg, lv_x86_vec_t bg)
+{
+    lv_x86_vec_t v255 = LV_X86_SET32(255);
+    lv_x86_vec_t fg_alpha = LV_X86_SRL32(fg, 24);
+    lv_x86_vec_t bg_alpha = LV_X86_SRL32(bg, 24);
+
+    lv_x86_vec_t use_fg = LV_X86_OR(LV_X86_CMPGT32(fg_alpha, LV_X86_SET32(LV_OPA_MAX - 1)),
+                                    LV_X86_CMPGT32(LV_X86_SET32(LV_OPA_MIN + 1), bg_alpha));
+    /*The most common case: opaque images and fills*/
+    if(LV_X86_MOVEMASK(use_fg) == LV_X86_MOVEMASK_ALL) return fg;
+
+    lv_x86_vec_t use_bg = LV_X86_CMPGT32(LV_X86_SET32(LV_OPA_MIN + 1), fg_alpha);
+    lv_x86_vec_t bg_opaque = LV_X86_CMPEQ32(bg_alpha, v255);
+
+    lv_x86_vec_t res = LV_X86_OR(lv_x86_mix_rgb888(fg, bg, fg_alpha), LV_X86_SET32(0xFF000000));
+
+    /*Both colors have alpha*/
+    lv_x86_vec_t both_alpha = LV_X86_ANDNOT(LV_X86_OR(LV_X86_OR(use_fg, use_bg), bg_opaque), LV_X86_SET32(-1));
+    if(LV_X86_MOVEMASK(both_alpha)) {
+        lv_x86_vec_t res_alpha = LV_X86_SUB32(v255, LV_X86_SRL32(LV_X86_MULLO16(LV_X86_SUB32(v255, fg_alpha),
+                                                                                LV_X86_SUB32(v255, bg_alpha)), 8));
+        /*`res_alpha` can be 0 only in the lanes which are not used*/
+        lv_x86_vec_t ratio = LV_X86_DIV32(LV_X86_MULLO16(fg_alpha, v255), res_alpha);
+        lv_x86_vec_t rgb = lv_x86_mix_rgb888(fg, bg, ratio);
+        rgb = LV_X86_SELECT(LV_X86_CMPGT32(ratio, LV_X86_SET32(LV_OPA_MAX - 1)), fg, rgb);
+        rgb = LV_X86_SELECT(LV_X86_CMPGT32(LV_X86_SET32(LV_OPA_MIN + 1), ratio), bg, rgb);
+        rgb = LV_X86_OR(LV_X86_AND(rgb, LV_X86_SET32(0x00FFFFFF)), LV_X86_SLL32(res_alpha, 24));
+        res = LV_X86_SELECT(both_alpha, rgb, res);
+    }
+
+    res = LV_X86_SELECT(use_bg, bg, res);
+    return LV_X86_SELECT(use_fg, fg, res);
+}
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_SIMD*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_X86_PRIVATE_H*/
@@ -121,6 +121,12 @@ void lv_binfont_destroy(lv_font_t * font)
     const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
     if(dsc == NULL) return;
 
+    /*A new font can be loaded to the same address*/
+    lv_text_cache_drop_all();
+#if LV_USE_FONT_COMPRESSED
+    lv_font_compressed_cache_drop_all();
+#endif
+
     if(dsc->kern_classes == 0) {
         const lv_font_fmt_txt_kern_pair_t * kern_dsc = dsc->kern_dsc;
         if(NULL != kern_dsc) {
@@ -558,6 +564,22 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 
     int32_t kern_length = load_kern(fp, font_dsc, font_header.glyph_id_format, kern_start);
 
+#if LV_BINFONT_KERN_CLASSES
+    if(kern_length >= 0 && font_dsc->kern_dsc && font_dsc->kern_classes == 0) {
+        /*Read the kerning values from a class matrix instead of searching the pairs.
+         *If the pairs can't be converted they are kept.*/
+        lv_font_fmt_txt_kern_pair_t * kern_pair = (lv_font_fmt_txt_kern_pair_t *)font_dsc->kern_dsc;
+        lv_font_fmt_txt_kern_classes_t * kern_classes = lv_font_fmt_txt_kern_classes_create(kern_pair, loca_count);
+        if(kern_classes) {
+            lv_free((void *)kern_pair->glyph_ids);
+            lv_free((void *)kern_pair->values);
+            lv_free(kern_pair);
+            font_dsc->kern_dsc = kern_classes;
+            font_dsc->kern_classes = 1;
+        }
+    }
+#endif
+
     return kern_length >= 0;
 }
 
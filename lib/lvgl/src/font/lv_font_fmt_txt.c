@@ -14,14 +14,21 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../misc/cache/lv_cache.h"
+#include "../misc/cache/lv_cache_private.h"
 
 /*********************
  *      DEFINES
  *********************/
 #if LV_USE_FONT_COMPRESSED
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
+    #define font_compressed_cache_p LV_GLOBAL_DEFAULT()->font_compressed_cache
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+/*Kerning pairs are converted to classes only if the class matrix fits into this many bytes*/
+#define KERN_CLASSES_VALUES_MAX 4096
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -30,6 +37,16 @@ typedef struct {
     uint32_t gid_right;
 } kern_pair_ref_t;
 
+#if LV_USE_FONT_COMPRESSED
+/*A decompressed glyph bitmap in the cache*/
+typedef struct {
+    lv_cache_slot_size_t slot;
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    uint32_t gid;
+    uint8_t * bitmap;       /*A8 bitmap with the stride of the draw buffers*/
+} compressed_cache_data_t;
+#endif /*LV_USE_FONT_COMPRESSED*/
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -39,7 +56,16 @@ static int unicode_list_compare(const void * ref, const void * element);
 static int kern_pair_8_compare(const void * ref, const void * element);
 static int kern_pair_16_compare(const void * ref, const void * element);
 
+static bool kern_rows_equal(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t a, uint32_t b, uint32_t len);
+static void kern_pair_get(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t i, uint32_t * left, uint32_t * right);
+
 #if LV_USE_FONT_COMPRESSED
+    static bool compressed_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint8_t * out, uint32_t size);
+    static void compressed_cache_add(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, const uint8_t * bitmap,
+                                     uint32_t size);
+    static lv_cache_compare_res_t compressed_cache_compare_cb(const compressed_cache_data_t * lhs,
+                                                              const compressed_cache_data_t * rhs);
+    static void compressed_cache_free_cb(compressed_cache_data_t * entry, void * user_data);
     static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint8_t bpp, bool prefilter);
     static inline void decompress_line(uint8_t * out, int32_t w);
     static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len);
@@ -151,9 +177,14 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
     /*Handle compressed bitmap*/
     else {
 #if LV_USE_FONT_COMPRESSED
+        uint32_t size = lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8) * gdsc->box_h;
+        if(compressed_cache_get(fdsc, gid, bitmap_out, size)) return draw_buf;
+
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
         decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out, gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
+
+        compressed_cache_add(fdsc, gid, bitmap_out, size);
         return draw_buf;
 #else /*!LV_USE_FONT_COMPRESSED*/
         LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
@@ -210,6 +241,221 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+#if LV_USE_FONT_COMPRESSED
+
+lv_result_t lv_font_compressed_cache_init(uint32_t size)
+{
+    if(font_compressed_cache_p != NULL) {
+        return LV_RESULT_OK;
+    }
+
+    font_compressed_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(compressed_cache_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) compressed_cache_compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t) compressed_cache_free_cb
+    });
+
+    lv_cache_set_name(font_compressed_cache_p, "FONT_COMPRESSED");
+    return font_compressed_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+void lv_font_compressed_cache_deinit(void)
+{
+    if(font_compressed_cache_p == NULL) return;
+
+    lv_cache_destroy(font_compressed_cache_p, NULL);
+    font_compressed_cache_p = NULL;
+}
+
+void lv_font_compressed_cache_drop_all(void)
+{
+    if(font_compressed_cache_p == NULL) return;
+
+    lv_cache_drop_all(font_compressed_cache_p, NULL);
+}
+
+#endif /*LV_USE_FONT_COMPRESSED*/
+
+lv_font_fmt_txt_kern_classes_t * lv_font_fmt_txt_kern_classes_create(const lv_font_fmt_txt_kern_pair_t * kdsc,
+                                                                      uint32_t glyph_cnt)
+{
+    LV_ASSERT_NULL(kdsc);
+
+    uint32_t pair_cnt = kdsc->pair_cnt;
+    /*With 16 bit glyph ids the class arrays and the temporary column index could take hundreds of kB*/
+    if(pair_cnt == 0 || kdsc->glyph_ids_size != 0) return NULL;
+
+    uint32_t gid_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < pair_cnt; i++) {
+        uint32_t left;
+        uint32_t right;
+        kern_pair_get(kdsc, i, &left, &right);
+        gid_cnt = LV_MAX3(gid_cnt, left + 1, right + 1);
+    }
+
+    if(gid_cnt > glyph_cnt) {
+        LV_LOG_WARN("kerning pair with an invalid glyph id");
+        return NULL;
+    }
+
+    /*The class of every glyph of the font is read, not only of the glyphs in the pairs*/
+    uint8_t * left_classes = lv_malloc_zeroed(glyph_cnt);
+    uint8_t * right_classes = lv_malloc_zeroed(glyph_cnt);
+    uint32_t * rows = lv_malloc(UINT8_MAX * 2 * sizeof(uint32_t));  /*Start and length of a row of each left class*/
+    uint32_t * col_starts = lv_malloc_zeroed((gid_cnt + 1) * sizeof(uint32_t));
+    uint8_t * col_classes = lv_malloc(pair_cnt);
+    int8_t * col_values = lv_malloc(pair_cnt);
+    int8_t * values = NULL;
+    lv_font_fmt_txt_kern_classes_t * classes = NULL;
+    LV_ASSERT_MALLOC(left_classes);
+    LV_ASSERT_MALLOC(right_classes);
+    LV_ASSERT_MALLOC(rows);
+    LV_ASSERT_MALLOC(col_starts);
+    LV_ASSERT_MALLOC(col_classes);
+    LV_ASSERT_MALLOC(col_values);
+    bool ok = left_classes && right_classes && rows && col_starts && col_classes && col_values;
+
+    /*Left classes: the pairs are ordered by left glyph id so the pairs of a left glyph form a row*/
+    uint32_t left_cnt = 0;
+    uint32_t row_start = 0;
+    while(ok && row_start < pair_cnt) {
+        uint32_t left;
+        uint32_t right;
+        kern_pair_get(kdsc, row_start, &left, &right);
+        uint32_t row_end = row_start + 1;
+        while(row_end < pair_cnt) {
+            uint32_t next_left;
+            kern_pair_get(kdsc, row_end, &next_left, &right);
+            if(next_left != left) break;
+            row_end++;
+        }
+
+        uint32_t len = row_end - row_start;
+        uint32_t c;
+        for(c = 0; c < left_cnt; c++) {
+            if(rows[c * 2 + 1] == len && kern_rows_equal(kdsc, rows[c * 2], row_start, len)) break;
+        }
+
+        if(c == left_cnt) {
+            if(left_cnt == UINT8_MAX) {
+                ok = false;
+                break;
+            }
+            rows[c * 2] = row_start;
+            rows[c * 2 + 1] = len;
+            left_cnt++;
+        }
+        left_classes[left] = (uint8_t)(c + 1);
+        row_start = row_end;
+    }
+
+    /*Column of each right glyph: its (left class, value) pairs ordered by left class*/
+    uint32_t c;
+    uint32_t k;
+    for(c = 0; ok && c < left_cnt; c++) {
+        for(k = rows[c * 2]; k < rows[c * 2] + rows[c * 2 + 1]; k++) {
+            uint32_t left;
+            uint32_t right;
+            kern_pair_get(kdsc, k, &left, &right);
+            col_starts[right + 1]++;
+        }
+    }
+    for(i = 0; ok && i < gid_cnt; i++) col_starts[i + 1] += col_starts[i];
+    for(c = 0; ok && c < left_cnt; c++) {
+        for(k = rows[c * 2]; k < rows[c * 2] + rows[c * 2 + 1]; k++) {
+            uint32_t left;
+            uint32_t right;
+            kern_pair_get(kdsc, k, &left, &right);
+            /*`col_starts[right]` is used as a write index and restored below*/
+            uint32_t pos = col_starts[right]++;
+            col_classes[pos] = (uint8_t)c;
+            col_values[pos] = kdsc->values[k];
+        }
+    }
+    for(i = gid_cnt; ok && i > 0; i--) col_starts[i] = col_starts[i - 1];
+    if(ok) col_starts[0] = 0;
+
+    /*Right classes: right glyphs with the same columns. `right_first` is the first glyph of each class*/
+    uint32_t right_cnt = 0;
+    uint16_t right_first[UINT8_MAX];
+    for(i = 0; ok && i < gid_cnt; i++) {
+        uint32_t len = col_starts[i + 1] - col_starts[i];
+        if(len == 0) continue;
+
+        for(c = 0; c < right_cnt; c++) {
+            uint32_t first = right_first[c];
+            if(col_starts[first + 1] - col_starts[first] != len) continue;
+            if(lv_memcmp(&col_classes[col_starts[first]], &col_classes[col_starts[i]], len) != 0) continue;
+            if(lv_memcmp(&col_values[col_starts[first]], &col_values[col_starts[i]], len) != 0) continue;
+            break;
+        }
+
+        if(c == right_cnt) {
+            if(right_cnt == UINT8_MAX) {
+                ok = false;
+                break;
+            }
+            right_first[c] = (uint16_t)i;
+            right_cnt++;
+        }
+        right_classes[i] = (uint8_t)(c + 1);
+    }
+
+    if(ok && left_cnt * right_cnt > KERN_CLASSES_VALUES_MAX) ok = false;
+
+    if(ok) {
+        values = lv_malloc_zeroed(left_cnt * right_cnt);
+        LV_ASSERT_MALLOC(values);
+        if(values == NULL) ok = false;
+    }
+
+    if(ok) {
+        for(c = 0; c < left_cnt; c++) {
+            for(k = rows[c * 2]; k < rows[c * 2] + rows[c * 2 + 1]; k++) {
+                uint32_t left;
+                uint32_t right;
+                kern_pair_get(kdsc, k, &left, &right);
+                values[c * right_cnt + right_classes[right] - 1] = kdsc->values[k];
+            }
+        }
+
+        classes = lv_malloc(sizeof(lv_font_fmt_txt_kern_classes_t));
+        LV_ASSERT_MALLOC(classes);
+    }
+
+    if(classes) {
+        classes->class_pair_values = values;
+        classes->left_class_mapping = left_classes;
+        classes->right_class_mapping = right_classes;
+        classes->left_class_cnt = (uint8_t)left_cnt;
+        classes->right_class_cnt = (uint8_t)right_cnt;
+    }
+    else {
+        lv_free(values);
+        lv_free(left_classes);
+        lv_free(right_classes);
+    }
+
+    lv_free(rows);
+    lv_free(col_starts);
+    lv_free(col_classes);
+    lv_free(col_values);
+
+    return classes;
+}
+
+void lv_font_fmt_txt_kern_classes_delete(lv_font_fmt_txt_kern_classes_t * classes)
+{
+    if(classes == NULL) return;
+
+    lv_free((void *)classes->class_pair_values);
+    lv_free((void *)classes->left_class_mapping);
+    lv_free((void *)classes->right_class_mapping);
+    lv_free(classes);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -263,6 +509,38 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
 }
 
+/**
+ * Compare two rows of kerning pairs
+ * @param kdsc      the kerning pairs
+ * @param a         index of the first pair of a row
+ * @param b         index of the first pair of the other row
+ * @param len       number of pairs in the rows
+ * @return          true: the rows have the same right glyphs and values
+ */
+static bool kern_rows_equal(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t a, uint32_t b, uint32_t len)
+{
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        uint32_t left_a;
+        uint32_t right_a;
+        uint32_t left_b;
+        uint32_t right_b;
+        kern_pair_get(kdsc, a + i, &left_a, &right_a);
+        kern_pair_get(kdsc, b + i, &left_b, &right_b);
+        if(right_a != right_b || kdsc->values[a + i] != kdsc->values[b + i]) return false;
+    }
+
+    return true;
+}
+
+static void kern_pair_get(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t i, uint32_t * left, uint32_t * right)
+{
+    /*Only the pairs with 8 bit glyph ids are converted*/
+    const uint8_t * g_ids = kdsc->glyph_ids;
+    *left = g_ids[i * 2];
+    *right = g_ids[i * 2 + 1];
+}
+
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
@@ -341,6 +619,81 @@ static int kern_pair_16_compare(const void * ref, const void * element)
 
 #if LV_USE_FONT_COMPRESSED
 
+/**
+ * Copy a decompressed glyph bitmap from the cache
+ * @param fdsc      the font descriptor
+ * @param gid       the glyph id
+ * @param out       copy the bitmap here
+ * @param size      size of the bitmap in bytes
+ * @return          true: the bitmap was cached and copied
+ */
+static bool compressed_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint8_t * out, uint32_t size)
+{
+    if(font_compressed_cache_p == NULL || !lv_cache_is_enabled(font_compressed_cache_p)) return false;
+
+    compressed_cache_data_t search_key;
+    search_key.fdsc = fdsc;
+    search_key.gid = gid;
+
+    lv_cache_entry_t * entry = lv_cache_acquire(font_compressed_cache_p, &search_key, NULL);
+    if(entry == NULL) return false;
+
+    compressed_cache_data_t * data = lv_cache_entry_get_data(entry);
+    lv_memcpy(out, data->bitmap, size);
+    lv_cache_release(font_compressed_cache_p, entry, NULL);
+    return true;
+}
+
+/**
+ * Add a copy of a decompressed glyph bitmap to the cache
+ * @param fdsc      the font descriptor
+ * @param gid       the glyph id
+ * @param bitmap    the decompressed bitmap
+ * @param size      size of the bitmap in bytes
+ */
+static void compressed_cache_add(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, const uint8_t * bitmap,
+                                 uint32_t size)
+{
+    if(font_compressed_cache_p == NULL || !lv_cache_is_enabled(font_compressed_cache_p)) return;
+
+    /*Don't evict everything for a glyph larger than the whole cache*/
+    if(size > lv_cache_get_max_size(font_compressed_cache_p, NULL)) return;
+
+    compressed_cache_data_t search_key;
+    search_key.slot.size = size;
+    search_key.fdsc = fdsc;
+    search_key.gid = gid;
+    search_key.bitmap = lv_malloc(size);
+    LV_ASSERT_MALLOC(search_key.bitmap);
+    if(search_key.bitmap == NULL) return;
+    lv_memcpy(search_key.bitmap, bitmap, size);
+
+    lv_cache_entry_t * entry = lv_cache_add(font_compressed_cache_p, &search_key, NULL);
+    if(entry == NULL) {
+        lv_free(search_key.bitmap);
+        return;
+    }
+
+    lv_cache_release(font_compressed_cache_p, entry, NULL);
+}
+
+static lv_cache_compare_res_t compressed_cache_compare_cb(const compressed_cache_data_t * lhs,
+                                                          const compressed_cache_data_t * rhs)
+{
+    if(lhs->fdsc != rhs->fdsc) return lhs->fdsc > rhs->fdsc ? 1 : -1;
+    if(lhs->gid != rhs->gid) return lhs->gid > rhs->gid ? 1 : -1;
+
+    return 0;
+}
+
+static void compressed_cache_free_cb(compressed_cache_data_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(entry->bitmap);
+    entry->bitmap = NULL;
+}
+
 /**
  * The compress a glyph's bitmap
  * @param in the compressed bitmap
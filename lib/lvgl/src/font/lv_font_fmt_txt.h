@@ -209,6 +209,25 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+/**
+ * Convert kerning pairs to kerning classes, so a kerning value is read with two class lookups and
+ * one matrix read instead of a binary search. Left glyphs with the same pairs get the same left class,
+ * right glyphs with the same values for each left class get the same right class.
+ * Use the result as `kern_dsc` with `kern_classes = 1`, e.g. when a font is registered.
+ * @param kdsc          kerning pairs with 8 bit glyph ids
+ * @param glyph_cnt     number of glyphs of the font (the class arrays have this size)
+ * @return              the kerning classes allocated with `lv_malloc`, or NULL if the glyph ids are 16 bit,
+ *                      a side has more than 255 classes or the class matrix would be larger than 4 kB
+ */
+lv_font_fmt_txt_kern_classes_t * lv_font_fmt_txt_kern_classes_create(const lv_font_fmt_txt_kern_pair_t * kdsc,
+                                                                      uint32_t glyph_cnt);
+
+/**
+ * Free kerning classes created by `lv_font_fmt_txt_kern_classes_create()`
+ * @param classes       the kerning classes
+ */
+void lv_font_fmt_txt_kern_classes_delete(lv_font_fmt_txt_kern_classes_t * classes);
+
 /**********************
  *      MACROS
  **********************/
@@ -45,6 +45,26 @@ typedef struct {
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_USE_FONT_COMPRESSED
+/**
+ * Initialize the cache of decompressed glyph bitmaps.
+ * @param size      max size of the cache in bytes. 0: disable caching
+ * @return          LV_RESULT_OK: initialization succeeded, LV_RESULT_INVALID: failed.
+ */
+lv_result_t lv_font_compressed_cache_init(uint32_t size);
+
+/**
+ * Free the cache of decompressed glyph bitmaps.
+ */
+void lv_font_compressed_cache_deinit(void);
+
+/**
+ * Drop all decompressed glyph bitmaps. Call it before freeing a font descriptor
+ * as a new one could be created at the same address.
+ */
+void lv_font_compressed_cache_drop_all(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
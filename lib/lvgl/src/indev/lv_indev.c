@@ -12,6 +12,7 @@
  *      INCLUDES
  ********************/
 #include "lv_indev_scroll.h"
+#include "lv_indev_hit_index_private.h"
 #include "../display/lv_display_private.h"
 #include "../core/lv_global.h"
 #include "../core/lv_obj_private.h"
@@ -58,6 +59,12 @@
 #define indev_obj_act LV_GLOBAL_DEFAULT()->indev_obj_active
 #define indev_ll_head &(LV_GLOBAL_DEFAULT()->indev_ll)
 
+#if LV_USE_INDEV_HIT_INDEX
+    #define search_obj(root, p) lv_indev_hit_index_search(root, p)
+#else
+    #define search_obj(root, p) lv_indev_search_obj(root, p)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -1437,17 +1444,17 @@ static void indev_proc_pointer_diff(lv_indev_t * indev)
 
 static lv_obj_t * pointer_search_obj(lv_display_t * disp, lv_point_t * p)
 {
-    indev_obj_act = lv_indev_search_obj(lv_display_get_layer_sys(disp), p);
+    indev_obj_act = search_obj(lv_display_get_layer_sys(disp), p);
     if(indev_obj_act) return indev_obj_act;
 
-    indev_obj_act = lv_indev_search_obj(lv_display_get_layer_top(disp), p);
+    indev_obj_act = search_obj(lv_display_get_layer_top(disp), p);
     if(indev_obj_act) return indev_obj_act;
 
     /* Search the object in the active screen */
-    indev_obj_act = lv_indev_search_obj(lv_display_get_screen_active(disp), p);
+    indev_obj_act = search_obj(lv_display_get_screen_active(disp), p);
     if(indev_obj_act) return indev_obj_act;
 
-    indev_obj_act = lv_indev_search_obj(lv_display_get_layer_bottom(disp), p);
+    indev_obj_act = search_obj(lv_display_get_layer_bottom(disp), p);
     return indev_obj_act;
 }
 
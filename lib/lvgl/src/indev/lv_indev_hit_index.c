@@ -0,0 +1,284 @@
+/**
+ * @file lv_indev_hit_index.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_indev_hit_index_private.h"
+#if LV_USE_INDEV_HIT_INDEX
+
+#include "lv_indev.h"
+#include "../core/lv_global.h"
+#include "../core/lv_obj_private.h"
+#include "../core/lv_obj_draw_private.h"
+#include "../misc/lv_area_private.h"
+#include "../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define hit_index LV_GLOBAL_DEFAULT()->indev_hit_index
+
+#define CELL_SIZE LV_INDEV_HIT_INDEX_CELL_SIZE
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_indev_hit_index_t * get_index(lv_obj_t * root);
+static void build(lv_indev_hit_index_t * idx);
+static void collect(lv_indev_hit_index_t * idx, lv_obj_t * obj, const lv_area_t * clip);
+static bool reserve(void ** buf, uint32_t * size, uint32_t req, uint32_t item_size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_indev_hit_index_deinit(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_INDEV_HIT_INDEX_SLOT_CNT; i++) {
+        lv_indev_hit_index_t * idx = &hit_index.slots[i];
+        lv_free(idx->objs);
+        lv_free(idx->boxes);
+        lv_free(idx->cell_start);
+        lv_free(idx->entries);
+    }
+    lv_memzero(&hit_index, sizeof(hit_index));
+}
+
+void lv_indev_hit_index_invalidate(void)
+{
+    hit_index.generation++;
+}
+
+lv_obj_t * lv_indev_hit_index_search(lv_obj_t * root, lv_point_t * point)
+{
+    lv_indev_hit_index_t * idx = get_index(root);
+    if(idx == NULL) return lv_indev_search_obj(root, point);
+
+    /*Outside of the display the objects are not indexed*/
+    if(!lv_area_is_point_on(&idx->area, point, 0)) return lv_indev_search_obj(root, point);
+
+    uint32_t col = (point->x - idx->area.x1) / CELL_SIZE;
+    uint32_t row = (point->y - idx->area.y1) / CELL_SIZE;
+    uint32_t cell = row * idx->col_cnt + col;
+
+    /*The entries are in pre-order, so the last one under the point is found first
+     *by the recursive search too*/
+    uint32_t i;
+    for(i = idx->cell_start[cell + 1]; i > idx->cell_start[cell]; i--) {
+        uint32_t k = idx->entries[i - 1];
+        const lv_area_t * box = &idx->boxes[k];
+        if(point->x < box->x1 || point->x > box->x2 || point->y < box->y1 || point->y > box->y2) continue;
+
+        lv_obj_t * obj = idx->objs[k];
+        if(!lv_obj_has_flag(obj, LV_OBJ_FLAG_ADV_HITTEST)) return obj;
+
+        /*The hit test event can change the tree. Start over in this case.*/
+        uint32_t generation = hit_index.generation;
+        bool res = lv_obj_hit_test(obj, point);
+        if(generation != hit_index.generation) return lv_indev_search_obj(root, point);
+        if(res) return obj;
+    }
+
+    return NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the up to date index of a root.
+ * @param root      a screen or a layer
+ * @return          the index or NULL if the recursive search should be used
+ */
+static lv_indev_hit_index_t * get_index(lv_obj_t * root)
+{
+    uint32_t generation = hit_index.generation;
+    lv_indev_hit_index_t * idx = NULL;
+    uint32_t i;
+    for(i = 0; i < LV_INDEV_HIT_INDEX_SLOT_CNT; i++) {
+        if(hit_index.slots[i].root == root) {
+            idx = &hit_index.slots[i];
+            break;
+        }
+    }
+
+    if(idx == NULL) {
+        idx = &hit_index.slots[hit_index.slot_next];
+        hit_index.slot_next = (hit_index.slot_next + 1) % LV_INDEV_HIT_INDEX_SLOT_CNT;
+        idx->root = root;
+        idx->built = 0;
+        idx->seen_generation = generation - 1;
+    }
+
+    if(idx->built && idx->generation == generation) return idx->usable ? idx : NULL;
+
+    /*Build the grid only if the tree stays the same for at least two searches.
+     *While scrolling or animating the objects change before every search so building it would be wasted.*/
+    if(idx->seen_generation != generation) {
+        idx->seen_generation = generation;
+        return NULL;
+    }
+
+    build(idx);
+    idx->built = 1;
+    idx->generation = generation;
+    return idx->usable ? idx : NULL;
+}
+
+static void build(lv_indev_hit_index_t * idx)
+{
+    lv_display_t * disp = lv_obj_get_display(idx->root);
+    lv_area_set(&idx->area, 0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                lv_display_get_vertical_resolution(disp) - 1);
+    idx->col_cnt = (lv_area_get_width(&idx->area) + CELL_SIZE - 1) / CELL_SIZE;
+    idx->row_cnt = (lv_area_get_height(&idx->area) + CELL_SIZE - 1) / CELL_SIZE;
+    idx->obj_cnt = 0;
+    idx->usable = 1;
+
+    collect(idx, idx->root, &idx->area);
+    if(!idx->usable) return;
+
+    uint32_t cell_cnt = idx->col_cnt * idx->row_cnt;
+    if(!reserve((void **)&idx->cell_start, &idx->cell_size, cell_cnt + 1, sizeof(uint32_t))) {
+        idx->usable = 0;
+        return;
+    }
+
+    /*Count the entries of each cell, then turn the counts into end offsets*/
+    lv_memzero(idx->cell_start, (cell_cnt + 1) * sizeof(uint32_t));
+    uint32_t k;
+    for(k = 0; k < idx->obj_cnt; k++) {
+        const lv_area_t * box = &idx->boxes[k];
+        uint32_t c1 = (box->x1 - idx->area.x1) / CELL_SIZE;
+        uint32_t c2 = (box->x2 - idx->area.x1) / CELL_SIZE;
+        uint32_t r1 = (box->y1 - idx->area.y1) / CELL_SIZE;
+        uint32_t r2 = (box->y2 - idx->area.y1) / CELL_SIZE;
+        uint32_t r, c;
+        for(r = r1; r <= r2; r++) {
+            for(c = c1; c <= c2; c++) idx->cell_start[r * idx->col_cnt + c]++;
+        }
+    }
+
+    uint32_t entry_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < cell_cnt; i++) {
+        entry_cnt += idx->cell_start[i];
+        idx->cell_start[i] = entry_cnt;
+    }
+    idx->cell_start[cell_cnt] = entry_cnt;
+
+    if(!reserve((void **)&idx->entries, &idx->entry_size, entry_cnt, sizeof(uint16_t))) {
+        idx->usable = 0;
+        return;
+    }
+
+    /*Fill the cells backwards so the entries are ascending and the offsets become start offsets*/
+    for(k = idx->obj_cnt; k > 0; k--) {
+        const lv_area_t * box = &idx->boxes[k - 1];
+        uint32_t c1 = (box->x1 - idx->area.x1) / CELL_SIZE;
+        uint32_t c2 = (box->x2 - idx->area.x1) / CELL_SIZE;
+        uint32_t r1 = (box->y1 - idx->area.y1) / CELL_SIZE;
+        uint32_t r2 = (box->y2 - idx->area.y1) / CELL_SIZE;
+        uint32_t r, c;
+        for(r = r1; r <= r2; r++) {
+            for(c = c1; c <= c2; c++) {
+                uint32_t cell = r * idx->col_cnt + c;
+                idx->cell_start[cell]--;
+                idx->entries[idx->cell_start[cell]] = (uint16_t)(k - 1);
+            }
+        }
+    }
+}
+
+/**
+ * Add the clickable objects of a subtree in pre-order, as `lv_indev_search_obj` visits them in reverse.
+ * @param idx       the index to fill
+ * @param obj       root of the subtree
+ * @param clip      the area where `obj` can be reached: its ancestors' areas intersected
+ */
+static void collect(lv_indev_hit_index_t * idx, lv_obj_t * obj, const lv_area_t * clip)
+{
+    if(!idx->usable) return;
+
+    /*Hidden objects and their children are skipped by the search*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+    /*The search transforms the point for these objects. Don't index them.*/
+    if(lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_TRANSFORM) {
+        idx->usable = 0;
+        return;
+    }
+
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CLICKABLE)) {
+        lv_area_t box;
+        lv_obj_get_click_area(obj, &box);
+        if(lv_area_intersect(&box, &box, clip)) {
+            if(idx->obj_cnt > UINT16_MAX ||
+               !reserve((void **)&idx->objs, &idx->obj_size, idx->obj_cnt + 1, sizeof(lv_obj_t *)) ||
+               !reserve((void **)&idx->boxes, &idx->box_size, idx->obj_cnt + 1, sizeof(lv_area_t))) {
+                idx->usable = 0;
+                return;
+            }
+            idx->objs[idx->obj_cnt] = obj;
+            idx->boxes[idx->obj_cnt] = box;
+            idx->obj_cnt++;
+        }
+    }
+
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    if(child_cnt == 0) return;
+
+    /*The children are searched only if the point is on the parent*/
+    lv_area_t child_clip = obj->coords;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+        int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+        lv_area_increase(&child_clip, ext_draw_size, ext_draw_size);
+    }
+    if(!lv_area_intersect(&child_clip, &child_clip, clip)) return;
+
+    uint32_t i;
+    for(i = 0; i < child_cnt; i++) {
+        collect(idx, obj->spec_attr->children[i], &child_clip);
+    }
+}
+
+/**
+ * Grow a buffer to hold at least `req` items.
+ * @param buf           pointer to the buffer
+ * @param size          the capacity of the buffer in items, updated on growth
+ * @param req           the required number of items
+ * @param item_size     size of an item in bytes
+ * @return              false if the allocation failed
+ */
+static bool reserve(void ** buf, uint32_t * size, uint32_t req, uint32_t item_size)
+{
+    if(req <= *size && *buf != NULL) return true;
+
+    uint32_t new_size = *size ? *size : 16;
+    while(new_size < req) new_size *= 2;
+
+    void * new_buf = lv_realloc(*buf, new_size * item_size);
+    if(new_buf == NULL) return false;
+    *buf = new_buf;
+    *size = new_size;
+    return true;
+}
+
+#endif /*LV_USE_INDEV_HIT_INDEX*/
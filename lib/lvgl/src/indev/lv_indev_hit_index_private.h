@@ -0,0 +1,98 @@
+/**
+ * @file lv_indev_hit_index_private.h
+ *
+ */
+
+#ifndef LV_INDEV_HIT_INDEX_PRIVATE_H
+#define LV_INDEV_HIT_INDEX_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../misc/lv_types.h"
+#include "../misc/lv_area.h"
+
+#if LV_USE_INDEV_HIT_INDEX
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*One index for each root searched by the pointer: system, top and bottom layers and the active screen*/
+#define LV_INDEV_HIT_INDEX_SLOT_CNT 4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Uniform grid of the clickable objects of a root (screen or layer).
+ * Objects are stored in the order `lv_indev_search_obj` would prefer them last,
+ * i.e. in pre-order of the object tree, so the latest matching entry of a cell wins.
+ */
+typedef struct {
+    lv_obj_t * root;
+    uint32_t generation;        /**< Value of the global generation when the grid was built*/
+    uint32_t seen_generation;   /**< Generation of the last query, the grid is built only on reuse*/
+    uint8_t built : 1;          /**< The grid was built for `generation`*/
+    uint8_t usable : 1;         /**< 0: transformed objects or too many objects, use the recursive search*/
+    lv_area_t area;             /**< Area covered by the grid (the display)*/
+    uint32_t col_cnt;
+    uint32_t row_cnt;
+    uint32_t obj_cnt;
+    uint32_t obj_size;
+    lv_obj_t ** objs;           /**< Clickable objects in pre-order*/
+    uint32_t box_size;
+    lv_area_t * boxes;          /**< Click area of `objs[i]` clipped by its ancestors*/
+    uint32_t cell_size;
+    uint32_t * cell_start;      /**< `col_cnt * row_cnt + 1` offsets into `entries`*/
+    uint32_t entry_size;
+    uint16_t * entries;         /**< Indices into `objs`, ascending in each cell*/
+} lv_indev_hit_index_t;
+
+typedef struct {
+    lv_indev_hit_index_t slots[LV_INDEV_HIT_INDEX_SLOT_CNT];
+    uint32_t slot_next;
+    uint32_t generation;        /**< Incremented on every geometry, flag or tree change*/
+} lv_indev_hit_index_state_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Free the memory of the hit-test indices
+ */
+void lv_indev_hit_index_deinit(void);
+
+/**
+ * Mark all hit-test indices as outdated. Called when the coordinates, the flags
+ * or the position in the tree of an object change.
+ */
+void lv_indev_hit_index_invalidate(void);
+
+/**
+ * Find the clickable object under a point. Gives the same result as `lv_indev_search_obj(root, point)`
+ * but uses a grid of the clickable objects if the tree hasn't changed since the previous search.
+ * @param root      a screen or a layer
+ * @param point     the point in absolute coordinates
+ * @return          the found object or NULL
+ */
+lv_obj_t * lv_indev_hit_index_search(lv_obj_t * root, lv_point_t * point);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_INDEV_HIT_INDEX*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_INDEV_HIT_INDEX_PRIVATE_H*/
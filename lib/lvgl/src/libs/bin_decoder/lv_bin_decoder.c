@@ -352,8 +352,9 @@ lv_result_t lv_bin_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 
     lv_cache_entry_t * cache_entry = lv_image_decoder_add_to_cache(decoder, &search_key, dsc->decoded, dsc->user_data);
     if(cache_entry == NULL) {
-        free_decoder_data(dsc);
-        return LV_RESULT_INVALID;
+        /*Too large or the others can't be evicted. Use it this time, it's freed in `lv_bin_decoder_close()`.*/
+        LV_LOG_INFO("The decoded image is not cached");
+        return LV_RESULT_OK;
     }
     dsc->cache_entry = cache_entry;
     decoder_data_t * decoder_data = get_decoder_data(dsc);
@@ -627,14 +628,28 @@ static lv_result_t decode_indexed(lv_image_decoder_t * decoder, lv_image_decoder
     dsc->palette = palette;
     dsc->palette_size = LV_COLOR_INDEXED_PALETTE_SIZE(cf);
 
-#if LV_BIN_DECODER_RAM_LOAD
+#if LV_BIN_DECODER_RAM_LOAD == 0
+    /*It needs to be read by get_area_cb later, unless the indices are in RAM and
+     *the converted image can be kept in the image cache to convert it only once*/
+    uint32_t decoded_size = lv_draw_buf_width_to_stride(dsc->header.w, LV_COLOR_FORMAT_ARGB8888) * dsc->header.h;
+    if(indexed_data == NULL || dsc->args.no_cache || !lv_image_cache_is_cacheable(decoded_size)) {
+        return LV_RESULT_OK;
+    }
+#endif
+
     /*Convert to ARGB8888, since sw renderer cannot render it directly even it's in RAM*/
     lv_draw_buf_t * decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, dsc->header.w, dsc->header.h,
                                                     LV_COLOR_FORMAT_ARGB8888,
                                                     0);
     if(decoded == NULL) {
+#if LV_BIN_DECODER_RAM_LOAD == 0
+        /*Not enough memory to convert it at once, read it line by line as without cache*/
+        LV_LOG_INFO("No memory to convert the indexed image, it's read line by line");
+        return LV_RESULT_OK;
+#else
         LV_LOG_ERROR("No memory for indexed image");
         goto exit_with_buf;
+#endif
     }
 
     stride = decoded->header.stride;
@@ -656,6 +671,7 @@ static lv_result_t decode_indexed(lv_image_decoder_t * decoder, lv_image_decoder
     }
 
     return LV_RESULT_OK;
+#if LV_BIN_DECODER_RAM_LOAD
 exit_with_buf:
     if(dsc->src_type == LV_IMAGE_SRC_FILE && !is_compressed) {
         lv_free((void *)palette);
@@ -664,12 +680,6 @@ exit_with_buf:
 
     if(draw_buf_indexed) lv_draw_buf_destroy(draw_buf_indexed);
     return LV_RESULT_INVALID;
-#else
-    LV_UNUSED(stride);
-    LV_UNUSED(indexed_data);
-    LV_UNUSED(draw_buf_indexed);
-    /*It needs to be read by get_area_cb later*/
-    return LV_RESULT_OK;
 #endif
 }
 
@@ -202,7 +202,9 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
     lv_cache_entry_t * entry = lv_image_decoder_add_to_cache(decoder, &search_key, decoded, NULL);
 
     if(entry == NULL) {
-        return LV_RESULT_INVALID;
+        /*Too large or the others can't be evicted. Use it this time, it's freed in `decoder_close()`.*/
+        LV_LOG_INFO("The decoded image is not cached");
+        return LV_RESULT_OK;
     }
     dsc->cache_entry = entry;
 
@@ -219,8 +221,8 @@ static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t *
 {
     LV_UNUSED(decoder);
 
-    if(dsc->args.no_cache ||
-       !lv_image_cache_is_enabled()) lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
+    /*Not in the cache*/
+    if(dsc->cache_entry == NULL) lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
 }
 
 static lv_draw_buf_t * decode_png_data(const void * png_data, size_t png_data_size)
@@ -146,12 +146,15 @@ void lv_tiny_ttf_set_size(lv_font_t * font, int32_t font_size)
     }
 
     lv_tiny_ttf_cache_create(dsc);
+    lv_text_cache_drop_all();
 }
 
 void lv_tiny_ttf_destroy(lv_font_t * font)
 {
     LV_ASSERT_NULL(font);
 
+    lv_text_cache_drop_all();
+
     if(font->dsc != NULL) {
         ttf_font_desc_t * ttf = (ttf_font_desc_t *)font->dsc;
 #if LV_TINY_TTF_FILE_SUPPORT != 0
@@ -12,6 +12,7 @@
 #include "misc/lv_anim_private.h"
 #include "draw/lv_image_decoder_private.h"
 #include "draw/lv_draw_buf_private.h"
+#include "misc/cache/lv_text_cache.h"
 #include "core/lv_refr_private.h"
 #include "core/lv_obj_style_private.h"
 #include "core/lv_group_private.h"
@@ -118,11 +119,6 @@ static inline void lv_global_init(lv_global_t * global)
     void LV_LOG_PRINT_CB(lv_log_level_t, const char * txt);
     global->custom_log_print_cb = LV_LOG_PRINT_CB;
 #endif
-
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    global->sw_shadow_cache.cache_size = -1;
-    global->sw_shadow_cache.cache_r = -1;
-#endif
 }
 
 static inline void lv_cleanup_devices(lv_global_t * global)
@@ -230,6 +226,12 @@ void lv_init(void)
     lv_image_decoder_init(LV_CACHE_DEF_SIZE, LV_IMAGE_HEADER_CACHE_DEF_CNT);
     lv_bin_decoder_init();  /*LVGL built-in binary image decoder*/
 
+    lv_text_cache_init(LV_TEXT_CACHE_DEF_SIZE);
+
+#if LV_USE_FONT_COMPRESSED
+    lv_font_compressed_cache_init(LV_FONT_COMPRESSED_CACHE_SIZE);
+#endif
+
 #if LV_USE_DRAW_VG_LITE
     lv_draw_vg_lite_init();
 #endif
@@ -385,10 +387,20 @@ void lv_deinit(void)
 
     lv_image_decoder_deinit();
 
+    lv_text_cache_deinit();
+
+#if LV_USE_FONT_COMPRESSED
+    lv_font_compressed_cache_deinit();
+#endif
+
     lv_refr_deinit();
 
     lv_obj_style_deinit();
 
+#if LV_USE_INDEV_HIT_INDEX
+    lv_indev_hit_index_deinit();
+#endif
+
 #if LV_USE_PXP
 #if LV_USE_DRAW_PXP || LV_USE_ROTATE_PXP
     lv_draw_pxp_deinit();
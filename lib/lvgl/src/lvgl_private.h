@@ -17,9 +17,11 @@ extern "C" {
 
 #include "display/lv_display_private.h"
 #include "indev/lv_indev_private.h"
+#include "indev/lv_indev_hit_index_private.h"
 #include "misc/lv_text_private.h"
 #include "misc/cache/lv_cache_entry_private.h"
 #include "misc/cache/lv_cache_private.h"
+#include "misc/cache/lv_text_cache_private.h"
 #include "layouts/lv_layout_private.h"
 #include "stdlib/lv_mem_private.h"
 #include "others/file_explorer/lv_file_explorer_private.h"
@@ -39,6 +41,7 @@ extern "C" {
 #include "draw/lv_draw_label_private.h"
 #include "draw/lv_draw_vector_private.h"
 #include "draw/lv_draw_buf_private.h"
+#include "draw/lv_draw_layer_pool_private.h"
 #include "draw/lv_draw_mask_private.h"
 #include "draw/sw/lv_draw_sw_gradient_private.h"
 #include "draw/sw/lv_draw_sw_private.h"
@@ -9,7 +9,11 @@
 
 #include "../../draw/lv_image_decoder_private.h"
 #include "../lv_assert.h"
+#include "../lv_ll.h"
 #include "../../core/lv_global.h"
+#include "../../stdlib/lv_string.h"
+#include "../../stdlib/lv_sprintf.h"
+#include "lv_cache_entry_private.h"
 
 #include "lv_image_cache.h"
 #include "lv_image_header_cache.h"
@@ -20,9 +24,20 @@
 
 #define CACHE_NAME  "IMAGE"
 
+/*Images larger than this part of the cache are not cached*/
+#define CACHE_MAX_ENTRY_DIV     4
+
 #define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
+#define img_cache_ll_p &(LV_GLOBAL_DEFAULT()->img_cache_ll)
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
 
+#if LV_CACHE_DEF_SIZE && LV_IMAGE_CACHE_ADR
+#if LV_USE_STDLIB_MALLOC != LV_STDLIB_BUILTIN
+#error "LV_IMAGE_CACHE_ADR requires LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN"
+#endif
+#define img_cache_tlsf (LV_GLOBAL_DEFAULT()->img_cache_tlsf)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -34,6 +49,11 @@
 static lv_cache_compare_res_t image_cache_compare_cb(const lv_image_cache_data_t * lhs,
                                                      const lv_image_cache_data_t * rhs);
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data);
+static void unpin_all(void);
+#if LV_CACHE_DEF_SIZE && LV_IMAGE_CACHE_ADR
+    static void * image_cache_buf_malloc_cb(size_t size, lv_color_format_t color_format);
+    static void image_cache_buf_free_cb(void * buf);
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -64,8 +84,41 @@ lv_result_t lv_image_cache_init(uint32_t size)
         .free_cb = (lv_cache_free_cb_t) image_cache_free_cb,
     });
 
+    if(img_cache_p == NULL) return LV_RESULT_INVALID;
+
     lv_cache_set_name(img_cache_p, CACHE_NAME);
-    return img_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
+    lv_ll_init(img_cache_ll_p, sizeof(lv_image_cache_data_t *));
+
+#if LV_CACHE_DEF_SIZE && LV_IMAGE_CACHE_ADR
+    /*All the buffers of the decoders are allocated with these handlers, not only the cached ones*/
+    img_cache_tlsf = lv_tlsf_create_with_pool((void *)LV_IMAGE_CACHE_ADR, LV_CACHE_DEF_SIZE);
+    if(img_cache_tlsf) {
+        lv_draw_buf_handlers_t * handlers = image_cache_draw_buf_handlers;
+        handlers->buf_malloc_cb = image_cache_buf_malloc_cb;
+        handlers->buf_free_cb = image_cache_buf_free_cb;
+    }
+    else {
+        LV_LOG_WARN("Couldn't create the image cache region at %p", (void *)LV_IMAGE_CACHE_ADR);
+    }
+#endif
+
+    return LV_RESULT_OK;
+}
+
+void lv_image_cache_deinit(void)
+{
+    if(img_cache_p == NULL) return;
+
+    /*Pinned images would be kept as they were used*/
+    unpin_all();
+    lv_cache_destroy(img_cache_p, NULL);
+    img_cache_p = NULL;
+    lv_ll_clear(img_cache_ll_p);
+
+#if LV_CACHE_DEF_SIZE && LV_IMAGE_CACHE_ADR
+    if(img_cache_tlsf) lv_tlsf_destroy(img_cache_tlsf);
+    img_cache_tlsf = NULL;
+#endif
 }
 
 void lv_image_cache_resize(uint32_t new_size, bool evict_now)
@@ -82,10 +135,16 @@ void lv_image_cache_drop(const void * src)
     lv_image_header_cache_drop(src);
 
     if(src == NULL) {
+        unpin_all();
         lv_cache_drop_all(img_cache_p, NULL);
+
+        /*Only the entries still being drawn are left here and they are gone from the cache too*/
+        lv_ll_clear(img_cache_ll_p);
         return;
     }
 
+    lv_image_cache_unpin(src);
+
     lv_image_cache_data_t search_key = {
         .src = src,
         .src_type = lv_image_src_get_type(src),
@@ -99,6 +158,107 @@ bool lv_image_cache_is_enabled(void)
     return lv_cache_is_enabled(img_cache_p);
 }
 
+bool lv_image_cache_is_cacheable(uint32_t size)
+{
+    /*A large image would evict most of the others and they would evict it again on the next use,
+     *e.g. in each strip of a partial render. It's cheaper to decode only the large one for each use.*/
+    return size <= lv_cache_get_max_size(img_cache_p, NULL) / CACHE_MAX_ENTRY_DIV;
+}
+
+lv_result_t lv_image_cache_pin(const void * src)
+{
+    if(!lv_image_cache_is_enabled()) return LV_RESULT_INVALID;
+
+    /*Decode it now or find it in the cache*/
+    lv_image_decoder_dsc_t dsc;
+    lv_result_t res = lv_image_decoder_open(&dsc, src, NULL);
+    if(res != LV_RESULT_OK) return res;
+
+    lv_cache_entry_t * entry = dsc.cache_entry;
+    if(entry) {
+        lv_mutex_lock(&img_cache_p->lock);
+        lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+        if(!cached_data->pinned) {
+            /*Referenced entries are never evicted*/
+            cached_data->pinned = true;
+            lv_cache_entry_acquire_data(entry);
+        }
+        lv_mutex_unlock(&img_cache_p->lock);
+    }
+    else {
+        LV_LOG_INFO("The image is not in the cache, it's used directly or it doesn't fit");
+    }
+
+    lv_image_decoder_close(&dsc);
+
+    return entry ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+void lv_image_cache_unpin(const void * src)
+{
+    lv_image_cache_data_t search_key = {
+        .src = src,
+        .src_type = lv_image_src_get_type(src),
+    };
+
+    lv_cache_entry_t * entry = lv_cache_acquire(img_cache_p, &search_key, NULL);
+    if(entry == NULL) return;
+
+    lv_mutex_lock(&img_cache_p->lock);
+    lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+    bool pinned = cached_data->pinned;
+    cached_data->pinned = false;
+    lv_mutex_unlock(&img_cache_p->lock);
+
+    /*Release the reference of the pin too*/
+    if(pinned) lv_cache_release(img_cache_p, entry, NULL);
+    lv_cache_release(img_cache_p, entry, NULL);
+}
+
+void lv_image_cache_get_info(lv_image_cache_info_t * info)
+{
+    lv_memzero(info, sizeof(lv_image_cache_info_t));
+
+    lv_mutex_lock(&img_cache_p->lock);
+    info->hit_cnt = LV_GLOBAL_DEFAULT()->img_cache_hit_cnt;
+    info->miss_cnt = LV_GLOBAL_DEFAULT()->img_cache_miss_cnt;
+    info->size = lv_cache_get_size(img_cache_p, NULL);
+    info->max_size = lv_cache_get_max_size(img_cache_p, NULL);
+
+    lv_image_cache_data_t ** node;
+    LV_LL_READ(img_cache_ll_p, node) {
+        info->entry_cnt++;
+        if((*node)->pinned) {
+            info->pinned_cnt++;
+            info->pinned_size += (*node)->slot.size;
+        }
+    }
+    lv_mutex_unlock(&img_cache_p->lock);
+}
+
+void lv_image_cache_dump(void)
+{
+    lv_image_cache_info_t info;
+    lv_image_cache_get_info(&info);
+    LV_LOG_USER("%" LV_PRIu32 " images, %" LV_PRIu32 "/%" LV_PRIu32 " bytes (%" LV_PRIu32 " pinned), "
+                "%" LV_PRIu32 " hits, %" LV_PRIu32 " misses",
+                info.entry_cnt, info.size, info.max_size, info.pinned_size, info.hit_cnt, info.miss_cnt);
+
+    lv_mutex_lock(&img_cache_p->lock);
+    lv_image_cache_data_t ** node;
+    LV_LL_READ(img_cache_ll_p, node) {
+        char src_name[32];
+        if((*node)->src_type == LV_IMAGE_SRC_FILE) lv_snprintf(src_name, sizeof(src_name), "%s", (const char *)(*node)->src);
+        else lv_snprintf(src_name, sizeof(src_name), "%p", (*node)->src);
+
+        LV_LOG_USER("%s (%s) %" LV_PRId32 "x%" LV_PRId32 ", %" LV_PRIu32 " bytes, %" LV_PRIu32 " hits%s",
+                    src_name, (*node)->decoder->name ? (*node)->decoder->name : "",
+                    (int32_t)(*node)->decoded->header.w, (int32_t)(*node)->decoded->header.h,
+                    (uint32_t)(*node)->slot.size, (*node)->hit_cnt, (*node)->pinned ? ", pinned" : "");
+    }
+    lv_mutex_unlock(&img_cache_p->lock);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -142,4 +302,68 @@ static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data)
 
     /*Free the duplicated file name*/
     if(entry->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)entry->src);
+
+    /*Called with the cache locked*/
+    if(entry->ll_node) {
+        lv_ll_remove(img_cache_ll_p, entry->ll_node);
+        lv_free(entry->ll_node);
+    }
+}
+
+static void unpin_all(void)
+{
+    lv_mutex_lock(&img_cache_p->lock);
+    lv_image_cache_data_t ** node;
+    LV_LL_READ(img_cache_ll_p, node) {
+        if((*node)->pinned) {
+            /*Only drop the reference of the pin. The entry is still valid so it's not freed here.*/
+            (*node)->pinned = false;
+            lv_cache_entry_release_data(lv_cache_entry_get_entry(*node, img_cache_p->node_size), NULL);
+        }
+    }
+    lv_mutex_unlock(&img_cache_p->lock);
 }
+
+#if LV_CACHE_DEF_SIZE && LV_IMAGE_CACHE_ADR
+
+static void * image_cache_buf_malloc_cb(size_t size, lv_color_format_t color_format)
+{
+    LV_UNUSED(color_format);
+
+    /*Allocate larger memory to be sure it can be aligned as needed*/
+    size += LV_DRAW_BUF_ALIGN - 1;
+
+    lv_mutex_lock(&img_cache_p->lock);
+    void * buf = lv_tlsf_malloc(img_cache_tlsf, size);
+
+    /*The region can be fragmented even if the cache is not full.
+     *Evict the least recently used images until the buffer fits, unless the buffer is too large to be cached.*/
+    if(lv_image_cache_is_cacheable(size)) {
+        while(buf == NULL && lv_cache_get_size(img_cache_p, NULL) > 0 && lv_cache_evict_one(img_cache_p, NULL)) {
+            buf = lv_tlsf_malloc(img_cache_tlsf, size);
+        }
+    }
+    lv_mutex_unlock(&img_cache_p->lock);
+
+    /*Too large or the pinned images and the images being drawn fill the region*/
+    if(buf == NULL) buf = lv_malloc(size);
+
+    return buf;
+}
+
+static void image_cache_buf_free_cb(void * buf)
+{
+    if((lv_uintptr_t)buf < LV_IMAGE_CACHE_ADR || (lv_uintptr_t)buf >= LV_IMAGE_CACHE_ADR + LV_CACHE_DEF_SIZE) {
+        lv_free(buf);
+        return;
+    }
+
+    /*The region is released already by `lv_image_cache_deinit()`*/
+    if(img_cache_p == NULL) return;
+
+    lv_mutex_lock(&img_cache_p->lock);
+    lv_tlsf_free(img_cache_tlsf, buf);
+    lv_mutex_unlock(&img_cache_p->lock);
+}
+
+#endif /*LV_CACHE_DEF_SIZE && LV_IMAGE_CACHE_ADR*/
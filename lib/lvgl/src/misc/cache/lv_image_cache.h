@@ -25,6 +25,16 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    uint32_t hit_cnt;           /**< Opened images which were found in the cache*/
+    uint32_t miss_cnt;          /**< Decoded images which were added or tried to be added to the cache*/
+    uint32_t entry_cnt;         /**< Number of images in the cache*/
+    uint32_t pinned_cnt;        /**< Number of images pinned with `lv_image_cache_pin()`*/
+    uint32_t size;              /**< Bytes of the decoded images in the cache*/
+    uint32_t pinned_size;       /**< Bytes of the pinned images*/
+    uint32_t max_size;          /**< Size of the cache in bytes*/
+} lv_image_cache_info_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -36,6 +46,11 @@ extern "C" {
  */
 lv_result_t lv_image_cache_init(uint32_t size);
 
+/**
+ * Deinitialize the image cache and free the cached images.
+ */
+void lv_image_cache_deinit(void);
+
 /**
  * Resize image cache.
  * If set to 0, the cache will be disabled.
@@ -46,6 +61,7 @@ void lv_image_cache_resize(uint32_t new_size, bool evict_now);
 
 /**
  * Invalidate image cache. Use NULL to invalidate all images.
+ * The invalidated images are unpinned too.
  * @param src pointer to an image source.
  */
 void lv_image_cache_drop(const void * src);
@@ -56,6 +72,43 @@ void lv_image_cache_drop(const void * src);
  */
 bool lv_image_cache_is_enabled(void);
 
+/**
+ * Check if a decoded image would be kept in the image cache.
+ * Images larger than 1/4 of the cache are not cached not to evict most of the others.
+ * Decoders can use it to decode an image at once only if it's cached.
+ * @param size  size of the decoded image in bytes
+ * @return      true: the cache is enabled and the image is not too large for it
+ */
+bool lv_image_cache_is_cacheable(uint32_t size);
+
+/**
+ * Decode an image and keep it in the cache until `lv_image_cache_unpin()`.
+ * Useful for the always visible images (logos, pictograms) not to decode them again
+ * when other images evict them. The pinned images are counted in the size of the cache.
+ * @param src   pointer to an image source
+ * @return      LV_RESULT_OK: the decoded image is pinned;
+ *              LV_RESULT_INVALID: the image can't be decoded, doesn't fit into the cache
+ *              or it's used directly from its source without decoding
+ */
+lv_result_t lv_image_cache_pin(const void * src);
+
+/**
+ * Let the cache evict an image pinned by `lv_image_cache_pin()` again.
+ * @param src   pointer to an image source
+ */
+void lv_image_cache_unpin(const void * src);
+
+/**
+ * Get the statistics of the image cache.
+ * @param info  store the result here
+ */
+void lv_image_cache_get_info(lv_image_cache_info_t * info);
+
+/**
+ * Log the images of the cache with their size and number of hits, the most recently added first.
+ */
+void lv_image_cache_dump(void);
+
 /*************************
  *    GLOBAL VARIABLES
  *************************/
@@ -0,0 +1,259 @@
+/**
+* @file lv_text_cache.c
+*
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_text_cache_private.h"
+#include "lv_cache.h"
+#include "../lv_text_private.h"
+#include "../lv_assert.h"
+#include "../../core/lv_global.h"
+#include "../../stdlib/lv_mem.h"
+#include "../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define CACHE_NAME  "TEXT"
+
+#define text_cache_p (LV_GLOBAL_DEFAULT()->text_cache)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static lv_cache_compare_res_t text_cache_compare_cb(const lv_text_cache_data_t * lhs,
+                                                    const lv_text_cache_data_t * rhs);
+static void text_cache_free_cb(lv_text_cache_data_t * entry, void * user_data);
+static void init_key(lv_text_cache_data_t * key, const char * text, const lv_font_t * font, int32_t letter_space,
+                     int32_t line_space, int32_t max_width, lv_text_flag_t flag);
+static void free_data(lv_text_cache_data_t * data);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_text_cache_init(uint32_t size)
+{
+    if(text_cache_p != NULL) {
+        return LV_RESULT_OK;
+    }
+
+    text_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(lv_text_cache_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) text_cache_compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t) text_cache_free_cb
+    });
+
+    lv_cache_set_name(text_cache_p, CACHE_NAME);
+    return text_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+void lv_text_cache_deinit(void)
+{
+    if(text_cache_p == NULL) return;
+
+    lv_cache_destroy(text_cache_p, NULL);
+    text_cache_p = NULL;
+}
+
+void lv_text_cache_resize(uint32_t size, bool evict_now)
+{
+    lv_cache_set_max_size(text_cache_p, size, NULL);
+    if(evict_now) {
+        lv_cache_reserve(text_cache_p, size, NULL);
+    }
+}
+
+void lv_text_cache_drop_all(void)
+{
+    if(text_cache_p == NULL) return;
+
+    lv_cache_drop_all(text_cache_p, NULL);
+}
+
+bool lv_text_cache_is_enabled(void)
+{
+    return text_cache_p != NULL && lv_cache_is_enabled(text_cache_p);
+}
+
+lv_cache_entry_t * lv_text_cache_acquire(const char * text, const lv_font_t * font, int32_t letter_space,
+                                         int32_t line_space, int32_t max_width, lv_text_flag_t flag)
+{
+    if(!lv_text_cache_is_enabled()) return NULL;
+
+    lv_text_cache_data_t search_key;
+    init_key(&search_key, text, font, letter_space, line_space, max_width, flag);
+
+    return lv_cache_acquire(text_cache_p, &search_key, NULL);
+}
+
+lv_cache_entry_t * lv_text_cache_acquire_or_create(const char * text, const lv_font_t * font, int32_t letter_space,
+                                                   int32_t line_space, int32_t max_width, lv_text_flag_t flag)
+{
+    if(!lv_text_cache_is_enabled()) return NULL;
+
+    lv_text_cache_data_t search_key;
+    init_key(&search_key, text, font, letter_space, line_space, max_width, flag);
+
+    lv_cache_entry_t * entry = lv_cache_acquire(text_cache_p, &search_key, NULL);
+    if(entry) return entry;
+
+    /*Don't let a long text evict many short ones: skip it if it would take more than a quarter of the cache*/
+    if(sizeof(lv_text_cache_data_t) + search_key.text_len + 1 > lv_cache_get_max_size(text_cache_p, NULL) / 4) {
+        return NULL;
+    }
+
+    lv_text_cache_data_t lines;
+    if(!lv_text_measure(&search_key.size, text, font, letter_space, line_space, search_key.max_width, flag, &lines)) {
+        lv_free(lines.line_ends);
+        lv_free(lines.line_widths);
+        return NULL;
+    }
+
+    /*Store the line breaks, the line widths and the copy of the text in one block*/
+    uint32_t lines_size = lines.line_cnt * (sizeof(uint32_t) + sizeof(int32_t));
+    uint8_t * block = lv_malloc(lines_size + search_key.text_len + 1);
+    LV_ASSERT_MALLOC(block);
+    if(block) {
+        search_key.line_cnt = lines.line_cnt;
+        search_key.line_ends = (uint32_t *)block;
+        search_key.line_widths = (int32_t *)(block + lines.line_cnt * sizeof(uint32_t));
+        if(lines.line_cnt) {
+            lv_memcpy(search_key.line_ends, lines.line_ends, lines.line_cnt * sizeof(uint32_t));
+            lv_memcpy(search_key.line_widths, lines.line_widths, lines.line_cnt * sizeof(int32_t));
+        }
+        lv_memcpy(block + lines_size, text, search_key.text_len + 1);
+        search_key.text = (const char *)(block + lines_size);
+        search_key.slot.size = sizeof(lv_text_cache_data_t) + lines_size + search_key.text_len + 1;
+    }
+    lv_free(lines.line_ends);
+    lv_free(lines.line_widths);
+    if(block == NULL) return NULL;
+
+    entry = lv_cache_add(text_cache_p, &search_key, NULL);
+    if(entry == NULL) {
+        free_data(&search_key);
+        return NULL;
+    }
+
+    return entry;
+}
+
+void lv_text_cache_release(lv_cache_entry_t * entry)
+{
+    lv_cache_release(text_cache_p, entry, NULL);
+}
+
+uint32_t lv_text_cache_get_next_line(const lv_text_cache_data_t * data, uint32_t line_start, int32_t * width)
+{
+    if(line_start >= data->text_len) {
+        if(width) *width = 0;
+        return 0;
+    }
+
+    /*Find the line starting at `line_start`. Line `i` starts where line `i - 1` ends.*/
+    uint32_t low = 0;
+    uint32_t high = data->line_cnt;
+    while(low < high) {
+        uint32_t mid = (low + high) / 2;
+        uint32_t mid_start = mid == 0 ? 0 : data->line_ends[mid - 1];
+        if(mid_start < line_start) low = mid + 1;
+        else high = mid;
+    }
+
+    if(low >= data->line_cnt) return UINT32_MAX;
+    uint32_t found_start = low == 0 ? 0 : data->line_ends[low - 1];
+    if(found_start != line_start) return UINT32_MAX;
+
+    if(width) *width = data->line_widths[low];
+    return data->line_ends[low] - line_start;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_cache_compare_res_t text_cache_compare_cb(const lv_text_cache_data_t * lhs,
+                                                    const lv_text_cache_data_t * rhs)
+{
+    if(lhs->text_hash != rhs->text_hash) return lhs->text_hash > rhs->text_hash ? 1 : -1;
+    if(lhs->text_len != rhs->text_len) return lhs->text_len > rhs->text_len ? 1 : -1;
+    if(lhs->font != rhs->font) return lhs->font > rhs->font ? 1 : -1;
+    if(lhs->max_width != rhs->max_width) return lhs->max_width > rhs->max_width ? 1 : -1;
+    if(lhs->letter_space != rhs->letter_space) return lhs->letter_space > rhs->letter_space ? 1 : -1;
+    if(lhs->line_space != rhs->line_space) return lhs->line_space > rhs->line_space ? 1 : -1;
+    if(lhs->flag != rhs->flag) return lhs->flag > rhs->flag ? 1 : -1;
+
+    /*`lv_memcmp` can't compare 0 bytes*/
+    if(lhs->text_len == 0) return 0;
+
+    int cmp_res = lv_memcmp(lhs->text, rhs->text, lhs->text_len);
+    if(cmp_res != 0) return cmp_res > 0 ? 1 : -1;
+
+    return 0;
+}
+
+static void text_cache_free_cb(lv_text_cache_data_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data); /*Unused*/
+
+    free_data(entry);
+}
+
+/**
+ * Set the key fields of a search key and clear the others
+ */
+static void init_key(lv_text_cache_data_t * key, const char * text, const lv_font_t * font, int32_t letter_space,
+                     int32_t line_space, int32_t max_width, lv_text_flag_t flag)
+{
+    if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
+
+    /*FNV-1a hash of the text*/
+    uint32_t hash = 2166136261u;
+    uint32_t len;
+    for(len = 0; text[len] != '\0'; len++) {
+        hash = (hash ^ (uint8_t)text[len]) * 16777619u;
+    }
+
+    lv_memzero(key, sizeof(lv_text_cache_data_t));
+    key->text_hash = hash;
+    key->text_len = len;
+    key->text = text;
+    key->font = font;
+    key->letter_space = letter_space;
+    key->line_space = line_space;
+    key->max_width = max_width;
+    key->flag = flag;
+}
+
+static void free_data(lv_text_cache_data_t * data)
+{
+    /*The line breaks, the line widths and the text are in the same block*/
+    lv_free(data->line_ends);
+    data->text = NULL;
+    data->line_ends = NULL;
+    data->line_widths = NULL;
+}
@@ -0,0 +1,76 @@
+/**
+* @file lv_text_cache.h
+*
+ */
+
+#ifndef LV_TEXT_CACHE_H
+#define LV_TEXT_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../lv_conf_internal.h"
+#include "../lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the text measurement cache.
+ * @param  size initial size of the cache in bytes, with the copies of the texts and their line breaks.
+ * @return LV_RESULT_OK: initialization succeeded, LV_RESULT_INVALID: failed.
+ */
+lv_result_t lv_text_cache_init(uint32_t size);
+
+/**
+ * Free the text measurement cache.
+ */
+void lv_text_cache_deinit(void);
+
+/**
+ * Resize the text measurement cache.
+ * If set to 0, the cache is disabled.
+ * @param size  new max size of the cache in bytes.
+ * @param evict_now true: evict the texts should be removed by the eviction policy, false: wait for the next cache cleanup.
+ */
+void lv_text_cache_resize(uint32_t size, bool evict_now);
+
+/**
+ * Invalidate all cached text measurements.
+ * It's automatically called when a font is destroyed as a new font could be created at the same address.
+ */
+void lv_text_cache_drop_all(void);
+
+/**
+ * Return true if the text measurement cache is enabled.
+ * @return true: enabled, false: disabled.
+ */
+bool lv_text_cache_is_enabled(void);
+
+/*************************
+ *    GLOBAL VARIABLES
+ *************************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_TEXT_CACHE_H*/
@@ -0,0 +1,107 @@
+/**
+* @file lv_text_cache_private.h
+*
+ */
+
+#ifndef LV_TEXT_CACHE_PRIVATE_H
+#define LV_TEXT_CACHE_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_text_cache.h"
+#include "lv_cache_private.h"
+#include "../lv_area.h"
+#include "../lv_text.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A measured text. The first part is the key, the second part is the result of the measurement.
+ */
+struct lv_text_cache_data_t {
+    lv_cache_slot_size_t slot;  /**< Size of the entry with its text and line breaks*/
+    uint32_t text_hash;
+    uint32_t text_len;
+    const char * text;          /**< Copy of the measured text*/
+    const lv_font_t * font;
+    int32_t letter_space;
+    int32_t line_space;
+    int32_t max_width;
+    lv_text_flag_t flag;
+
+    lv_point_t size;            /**< The result of `lv_text_get_size`*/
+    uint32_t line_cnt;
+    uint32_t * line_ends;       /**< Byte index of the first character of the next line for each line*/
+    int32_t * line_widths;      /**< Width of each line, as `lv_text_get_width` returns it*/
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the measurement of a text from the cache.
+ * @param text          a '\0' terminated string
+ * @param font          pointer to a font
+ * @param letter_space  letter space
+ * @param line_space    line space
+ * @param max_width     max width of the lines, as for `lv_text_get_size`
+ * @param flag          settings for the text from ::lv_text_flag_t
+ * @return              the acquired cache entry, release it with `lv_text_cache_release`.
+ *                      NULL if the cache is disabled or the text is not cached.
+ */
+lv_cache_entry_t * lv_text_cache_acquire(const char * text, const lv_font_t * font, int32_t letter_space,
+                                         int32_t line_space, int32_t max_width, lv_text_flag_t flag);
+
+/**
+ * Get the measurement of a text from the cache, or measure and add it to the cache.
+ * Texts which would take more than a quarter of the cache are not added.
+ * @param text          a '\0' terminated string
+ * @param font          pointer to a font
+ * @param letter_space  letter space
+ * @param line_space    line space
+ * @param max_width     max width of the lines, as for `lv_text_get_size`
+ * @param flag          settings for the text from ::lv_text_flag_t
+ * @return              the acquired cache entry, release it with `lv_text_cache_release`.
+ *                      NULL if the cache is disabled or the text couldn't be added.
+ */
+lv_cache_entry_t * lv_text_cache_acquire_or_create(const char * text, const lv_font_t * font, int32_t letter_space,
+                                                   int32_t line_space, int32_t max_width, lv_text_flag_t flag);
+
+/**
+ * Release an entry acquired by `lv_text_cache_acquire` or `lv_text_cache_acquire_or_create`
+ * @param entry     the cache entry
+ */
+void lv_text_cache_release(lv_cache_entry_t * entry);
+
+/**
+ * Get the length of a line using the line breaks of a cached text.
+ * @param data          the cached text's data
+ * @param line_start    byte index of the first character of the line
+ * @param width         if not NULL, the width of the line is stored here
+ * @return              byte index of the first character of the next line relative to `line_start`
+ *                      as `lv_text_get_next_line` returns it, or `UINT32_MAX` if `line_start` is not the start of a line
+ */
+uint32_t lv_text_cache_get_next_line(const lv_text_cache_data_t * data, uint32_t line_start, int32_t * width);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_TEXT_CACHE_PRIVATE_H*/
@@ -9,6 +9,7 @@
 #include "lv_anim_private.h"
 
 #include "../core/lv_global.h"
+#include "../core/lv_obj_style_private.h"
 #include "../tick/lv_tick.h"
 #include "lv_assert.h"
 #include "lv_timer.h"
@@ -497,13 +498,18 @@ static void anim_timer(lv_timer_t * param)
     /*Flip the run round*/
     state.anim_run_round = state.anim_run_round ? false : true;
 
+    /*Every animation of the round sees the same time.
+     *The style changes made by the `exec_cb`s are refreshed once per object at the end of the round.*/
+    uint32_t now = lv_tick_get();
+    lv_obj_style_refresh_batch_start();
+
     lv_anim_t * a = lv_ll_get_head(anim_ll_p);
 
     while(a != NULL) {
-        uint32_t elaps = lv_tick_elaps(a->last_timer_run);
+        uint32_t elaps = now - a->last_timer_run;   /*Unsigned subtraction handles the tick overflow*/
         a->act_time += elaps;
 
-        a->last_timer_run = lv_tick_get();
+        a->last_timer_run = now;
 
         /*It can be set by `lv_anim_delete()` typically in `end_cb`. If set then an animation delete
          * happened in `anim_completed_handler` which could make this linked list reading corrupt
@@ -560,6 +566,7 @@ static void anim_timer(lv_timer_t * param)
             a = lv_ll_get_next(anim_ll_p, a);
     }
 
+    lv_obj_style_refresh_batch_end();
 }
 
 /**
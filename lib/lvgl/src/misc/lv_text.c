@@ -14,6 +14,8 @@
 #include "../stdlib/lv_mem.h"
 #include "../stdlib/lv_string.h"
 #include "../misc/lv_types.h"
+#include "cache/lv_cache.h"
+#include "cache/lv_text_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -100,17 +102,40 @@ void lv_text_get_size(lv_point_t * size_res, const char * text, const lv_font_t
 
     if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
 
+    lv_cache_entry_t * entry = lv_text_cache_acquire_or_create(text, font, letter_space, line_space, max_width, flag);
+    if(entry) {
+        const lv_text_cache_data_t * data = lv_cache_entry_get_data(entry);
+        *size_res = data->size;
+        lv_text_cache_release(entry);
+        return;
+    }
+
+    lv_text_measure(size_res, text, font, letter_space, line_space, max_width, flag, NULL);
+}
+
+bool lv_text_measure(lv_point_t * size_res, const char * text, const lv_font_t * font, int32_t letter_space,
+                     int32_t line_space, int32_t max_width, lv_text_flag_t flag, lv_text_cache_data_t * lines)
+{
     uint32_t line_start     = 0;
     uint32_t new_line_start = 0;
+    uint32_t line_size = 0;
     uint16_t letter_height = lv_font_get_line_height(font);
 
+    size_res->x = 0;
+    size_res->y = 0;
+    if(lines) {
+        lines->line_cnt = 0;
+        lines->line_ends = NULL;
+        lines->line_widths = NULL;
+    }
+
     /*Calc. the height and longest line*/
     while(text[line_start] != '\0') {
         new_line_start += lv_text_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
 
         if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(int32_t)) {
             LV_LOG_WARN("integer overflow while calculating text height");
-            return;
+            return false;
         }
         else {
             size_res->y += letter_height;
@@ -121,6 +146,23 @@ void lv_text_get_size(lv_point_t * size_res, const char * text, const lv_font_t
         int32_t act_line_length = lv_text_get_width(&text[line_start], new_line_start - line_start, font, letter_space);
 
         size_res->x = LV_MAX(act_line_length, size_res->x);
+
+        /*Save the line break and width*/
+        if(lines) {
+            if(lines->line_cnt >= line_size) {
+                line_size = line_size ? line_size * 2 : 4;
+                uint32_t * new_ends = lv_realloc(lines->line_ends, line_size * sizeof(uint32_t));
+                if(new_ends == NULL) return false;
+                lines->line_ends = new_ends;
+                int32_t * new_widths = lv_realloc(lines->line_widths, line_size * sizeof(int32_t));
+                if(new_widths == NULL) return false;
+                lines->line_widths = new_widths;
+            }
+            lines->line_ends[lines->line_cnt] = new_line_start;
+            lines->line_widths[lines->line_cnt] = act_line_length;
+            lines->line_cnt++;
+        }
+
         line_start  = new_line_start;
     }
 
@@ -134,6 +176,8 @@ void lv_text_get_size(lv_point_t * size_res, const char * text, const lv_font_t
         size_res->y = letter_height;
     else
         size_res->y -= line_space;
+
+    return true;
 }
 
 /**
@@ -44,6 +44,22 @@ extern "C" {
 uint32_t lv_text_get_next_line(const char * txt, const lv_font_t * font, int32_t letter_space,
                                int32_t max_width, int32_t * used_width, lv_text_flag_t flag);
 
+/**
+ * Measure a text as `lv_text_get_size` does, but without the text measurement cache.
+ * @param size_res      store the result here
+ * @param text          a '\0' terminated string
+ * @param font          pointer to a font
+ * @param letter_space  letter space
+ * @param line_space    line space
+ * @param max_width     max width of the lines, `LV_COORD_MAX` if `LV_TEXT_FLAG_EXPAND` is set
+ * @param flag          settings for the text from ::lv_text_flag_t
+ * @param lines         if not NULL, its `line_cnt`, `line_ends` and `line_widths` are set.
+ *                      The arrays are allocated here and must be freed by the caller, also on failure.
+ * @return              false on out of memory or if the text is too tall
+ */
+bool lv_text_measure(lv_point_t * size_res, const char * text, const lv_font_t * font, int32_t letter_space,
+                     int32_t line_space, int32_t max_width, lv_text_flag_t flag, lv_text_cache_data_t * lines);
+
 /**
  * Insert a string into another
  * @param txt_buf the original text (must be big enough for the result text and NULL terminated)
@@ -20,6 +20,7 @@
 
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_DEF_SIZE 8
 
 #define state LV_GLOBAL_DEFAULT()->timer_state
 #define timer_ll_p &(state.timer_ll)
@@ -31,9 +32,15 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static uint32_t time_remaining_at(const lv_timer_t * timer, uint32_t now);
 static void lv_timer_handler_resume(void);
+static void heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_update(lv_timer_t * timer);
+static void heap_sift_up(uint32_t idx, uint32_t now);
+static void heap_sift_down(uint32_t idx, uint32_t now);
 
 /**********************
  *  STATIC VARIABLES
@@ -90,43 +97,26 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    lv_timer_t * timer_active;
-    lv_ll_t * timer_head = timer_ll_p;
-    do {
-        state_p->timer_deleted             = false;
-        state_p->timer_created             = false;
-
-        timer_active = lv_ll_get_head(timer_head);
-        while(timer_active) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = lv_ll_get_next(timer_head, timer_active);
-
-            if(lv_timer_exec(timer_active)) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(state_p->timer_created || state_p->timer_deleted) {
-                    LV_TRACE_TIMER("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
+    /*Run the ready timers. The heap's root is always the timer with the least remaining time.
+     *Timers created or deleted by the callbacks are handled by the heap operations themselves.*/
+    while(state_p->heap_cnt > 0) {
+        lv_timer_t * timer_active = state_p->heap[0];
+        if(lv_timer_time_remaining(timer_active) > 0) break;
+        lv_timer_exec(timer_active);
+    }
 
-            timer_active = next; /*Load the next timer*/
-        }
-    } while(timer_active);
+    /*Schedule again the timers which were ready again right after running.
+     *They were kept out of the heap to run every timer at most once per call.*/
+    while(state_p->deferred) {
+        lv_timer_t * timer = state_p->deferred;
+        state_p->deferred = timer->deferred_next;
+        timer->deferred_next = NULL;
+        timer->heap_idx = LV_TIMER_HEAP_IDX_NONE;
+        if(!timer->paused) heap_insert(timer);
+    }
 
     uint32_t time_until_next = LV_NO_TIMER_READY;
-    next = lv_ll_get_head(timer_head);
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_until_next)
-                time_until_next = delay;
-        }
-
-        next = lv_ll_get_next(timer_head, next); /*Find the next timer*/
-    }
+    if(state_p->heap_cnt > 0) time_until_next = lv_timer_time_remaining(state_p->heap[0]);
 
     state_p->busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(state_p->idle_period_start);
@@ -167,6 +157,16 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    /*Reserve a heap slot for every timer so that scheduling (e.g. on resume) can't fail later*/
+    if(state.timer_cnt >= state.heap_size) {
+        uint32_t new_size = state.heap_size ? state.heap_size * 2 : HEAP_DEF_SIZE;
+        lv_timer_t ** new_heap = lv_realloc(state.heap, new_size * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_heap);
+        if(new_heap == NULL) return NULL;
+        state.heap = new_heap;
+        state.heap_size = new_size;
+    }
+
     new_timer = lv_ll_ins_head(timer_ll_p);
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -178,8 +178,11 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
+    new_timer->heap_idx = LV_TIMER_HEAP_IDX_NONE;
+    new_timer->deferred_next = NULL;
 
-    state.timer_created = true;
+    state.timer_cnt++;
+    heap_insert(new_timer);
 
     lv_timer_handler_resume();
 
@@ -194,8 +197,19 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 
 void lv_timer_delete(lv_timer_t * timer)
 {
+    if(timer->heap_idx == LV_TIMER_HEAP_IDX_DEFERRED) {
+        lv_timer_t ** t = &state.deferred;
+        while(*t != timer) t = &(*t)->deferred_next;
+        *t = timer->deferred_next;
+    }
+    else if(timer->heap_idx != LV_TIMER_HEAP_IDX_NONE) {
+        heap_remove(timer);
+    }
+
+    if(state.timer_running == timer) state.timer_running = NULL;
+
     lv_ll_remove(timer_ll_p, timer);
-    state.timer_deleted = true;
+    state.timer_cnt--;
 
     lv_free(timer);
 }
@@ -204,12 +218,15 @@ void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = true;
+    /*A deferred timer is simply not scheduled again*/
+    if(timer->heap_idx < state.heap_cnt) heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = false;
+    if(timer->heap_idx == LV_TIMER_HEAP_IDX_NONE) heap_insert(timer);
     lv_timer_handler_resume();
 }
 
@@ -217,18 +234,21 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+    heap_update(timer);
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+    heap_update(timer);
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     LV_ASSERT_NULL(timer);
     timer->repeat_count = repeat_count;
+    heap_update(timer); /*A timer with no more repeats is ready to be deleted or paused*/
 }
 
 void lv_timer_set_auto_delete(lv_timer_t * timer, bool auto_delete)
@@ -247,6 +267,7 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
+    heap_update(timer);
     lv_timer_handler_resume();
 }
 
@@ -261,6 +282,14 @@ void lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     lv_ll_clear(timer_ll_p);
+
+    lv_free(state.heap);
+    state.heap = NULL;
+    state.heap_cnt = 0;
+    state.heap_size = 0;
+    state.timer_cnt = 0;
+    state.deferred = NULL;
+    state.timer_running = NULL;
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -305,51 +334,56 @@ bool lv_timer_get_paused(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
- * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
+ * Execute a ready timer and schedule it again
+ * @param timer pointer to lv_timer, the root of the heap
  */
-static bool lv_timer_exec(lv_timer_t * timer)
+static void lv_timer_exec(lv_timer_t * timer)
 {
-    if(timer->paused) return false;
+    /* Decrement the repeat count before executing the timer_cb.
+     * If the timer is deleted by its callback, the code below is not executed*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+    LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
 
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
-
-        if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
-
-        if(!state.timer_deleted) {
-            LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
-        }
-        else {
-            LV_TRACE_TIMER("timer callback finished");
-        }
+    state.timer_running = timer;
+    if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
 
+    if(state.timer_running == NULL) { /*The timer was deleted by the callback*/
+        LV_TRACE_TIMER("timer callback finished");
         LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
+        return;
     }
+    state.timer_running = NULL;
+    LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
 
-    if(state.timer_deleted == false) { /*The timer might be deleted by itself as well*/
-        if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
-            if(timer->auto_delete) {
-                LV_TRACE_TIMER("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
-                lv_timer_delete(timer);
-            }
-            else {
-                LV_TRACE_TIMER("pausing timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
-                lv_timer_pause(timer);
-            }
+    LV_ASSERT_MEM_INTEGRITY();
+
+    if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
+        if(timer->auto_delete) {
+            LV_TRACE_TIMER("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
+            lv_timer_delete(timer);
+        }
+        else {
+            LV_TRACE_TIMER("pausing timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
+            lv_timer_pause(timer);
         }
+        return;
     }
 
-    return exec;
+    /*Paused by the callback*/
+    if(timer->heap_idx >= state.heap_cnt) return;
+
+    if(lv_timer_time_remaining(timer) == 0) {
+        /*E.g. period is 0 or the callback was longer than the period: don't run it again in this call*/
+        heap_remove(timer);
+        timer->heap_idx = LV_TIMER_HEAP_IDX_DEFERRED;
+        timer->deferred_next = state.deferred;
+        state.deferred = timer;
+    }
+    else {
+        heap_update(timer);
+    }
 }
 
 /**
@@ -359,13 +393,124 @@ static bool lv_timer_exec(lv_timer_t * timer)
  */
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
 {
-    /*Check if at least 'period' time elapsed*/
-    uint32_t elp = lv_tick_elaps(timer->last_run);
+    return time_remaining_at(timer, lv_tick_get());
+}
+
+/**
+ * Find out how much time remains before a timer must be run, at a given tick.
+ * The remaining times of all timers decrease together and saturate at zero,
+ * so the heap order computed at any tick stays valid later.
+ * @param timer pointer to lv_timer
+ * @param now the current tick
+ * @return the time remaining, or 0 if it needs to be run again
+ */
+static uint32_t time_remaining_at(const lv_timer_t * timer, uint32_t now)
+{
+    if(timer->repeat_count == 0) return 0;
+
+    /*Check if at least 'period' time elapsed (unsigned subtraction handles the tick overflow)*/
+    uint32_t elp = now - timer->last_run;
     if(elp >= timer->period)
         return 0;
     return timer->period - elp;
 }
 
+/**
+ * Add a not scheduled timer to the heap. A slot is always reserved by `lv_timer_create()`.
+ * @param timer pointer to lv_timer
+ */
+static void heap_insert(lv_timer_t * timer)
+{
+    uint32_t idx = state.heap_cnt;
+    state.heap_cnt++;
+    state.heap[idx] = timer;
+    timer->heap_idx = idx;
+    heap_sift_up(idx, lv_tick_get());
+}
+
+/**
+ * Remove a timer from the heap
+ * @param timer pointer to lv_timer which is in the heap
+ */
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t idx = timer->heap_idx;
+    timer->heap_idx = LV_TIMER_HEAP_IDX_NONE;
+
+    state.heap_cnt--;
+    if(idx == state.heap_cnt) return;
+
+    /*Move the last timer to the freed slot and restore the order*/
+    lv_timer_t * last = state.heap[state.heap_cnt];
+    state.heap[idx] = last;
+    last->heap_idx = idx;
+    uint32_t now = lv_tick_get();
+    heap_sift_up(idx, now);
+    heap_sift_down(last->heap_idx, now);
+}
+
+/**
+ * Restore the heap order after the period or last run of a timer has changed
+ * @param timer pointer to lv_timer
+ */
+static void heap_update(lv_timer_t * timer)
+{
+    uint32_t idx = timer->heap_idx;
+    if(idx >= state.heap_cnt) return;  /*Paused or deferred*/
+
+    uint32_t now = lv_tick_get();
+    heap_sift_up(idx, now);
+    heap_sift_down(timer->heap_idx, now);
+}
+
+static void heap_sift_up(uint32_t idx, uint32_t now)
+{
+    lv_timer_t ** heap = state.heap;
+    lv_timer_t * timer = heap[idx];
+    uint32_t remaining = time_remaining_at(timer, now);
+
+    while(idx > 0) {
+        uint32_t parent = (idx - 1) / 2;
+        if(time_remaining_at(heap[parent], now) <= remaining) break;
+        heap[idx] = heap[parent];
+        heap[idx]->heap_idx = idx;
+        idx = parent;
+    }
+
+    heap[idx] = timer;
+    timer->heap_idx = idx;
+}
+
+static void heap_sift_down(uint32_t idx, uint32_t now)
+{
+    lv_timer_t ** heap = state.heap;
+    uint32_t cnt = state.heap_cnt;
+    lv_timer_t * timer = heap[idx];
+    uint32_t remaining = time_remaining_at(timer, now);
+
+    while(1) {
+        uint32_t child = idx * 2 + 1;
+        if(child >= cnt) break;
+
+        uint32_t child_remaining = time_remaining_at(heap[child], now);
+        if(child + 1 < cnt) {
+            uint32_t right_remaining = time_remaining_at(heap[child + 1], now);
+            if(right_remaining < child_remaining) {
+                child++;
+                child_remaining = right_remaining;
+            }
+        }
+
+        if(remaining <= child_remaining) break;
+        heap[idx] = heap[child];
+        heap[idx]->heap_idx = idx;
+        idx = child;
+    }
+
+    heap[idx] = timer;
+    timer->heap_idx = idx;
+}
+
 /**
  * Call the ready lv_timer
  */
@@ -20,6 +20,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#define LV_TIMER_HEAP_IDX_NONE      0xFFFFFFFF  /**< The timer is not scheduled (paused)*/
+#define LV_TIMER_HEAP_IDX_DEFERRED  0xFFFFFFFE  /**< Already ran in this `lv_timer_handler()` call*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,15 +38,21 @@ struct lv_timer_t {
     int32_t repeat_count;      /**< 1: One time;  -1 : infinity;  n>0: residual times */
     uint32_t paused : 1;
     uint32_t auto_delete : 1;
+    uint32_t heap_idx;         /**< Index in the scheduler heap or `LV_TIMER_HEAP_IDX_...`*/
+    lv_timer_t * deferred_next; /**< Next timer in the deferred list*/
 };
 
 typedef struct {
     lv_ll_t timer_ll;          /**< Linked list to store the lv_timers */
+    lv_timer_t ** heap;        /**< Binary min-heap of the not paused timers, keyed by remaining time*/
+    uint32_t heap_cnt;         /**< Number of timers in `heap`*/
+    uint32_t heap_size;        /**< Allocated slots in `heap` (at least `timer_cnt`)*/
+    uint32_t timer_cnt;        /**< Number of timers in `timer_ll`*/
+    lv_timer_t * deferred;     /**< Timers which ran in this handler call and are ready again*/
+    lv_timer_t * timer_running; /**< Timer whose callback is running, NULL if it was deleted*/
 
     bool lv_timer_run;
     uint8_t idle_last;
-    bool timer_deleted;
-    bool timer_created;
     uint32_t timer_time_until_next;
 
     bool already_running;
@@ -145,6 +145,8 @@ typedef struct lv_image_cache_data_t lv_image_cache_data_t;
 
 typedef struct lv_image_header_cache_data_t lv_image_header_cache_data_t;
 
+typedef struct lv_text_cache_data_t lv_text_cache_data_t;
+
 typedef struct lv_draw_mask_t lv_draw_mask_t;
 
 typedef struct lv_grad_t lv_grad_t;
@@ -158,6 +160,8 @@ typedef struct lv_draw_image_sup_t lv_draw_image_sup_t;
 typedef struct lv_draw_mask_rect_dsc_t lv_draw_mask_rect_dsc_t;
 
 typedef struct lv_obj_style_t lv_obj_style_t;
+typedef struct lv_obj_style_prop_cache_t lv_obj_style_prop_cache_t;
+typedef struct lv_obj_style_refr_batch_t lv_obj_style_refr_batch_t;
 
 typedef struct lv_obj_style_transition_dsc_t lv_obj_style_transition_dsc_t;
 
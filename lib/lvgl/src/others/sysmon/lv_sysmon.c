@@ -17,6 +17,9 @@
 #include "../../stdlib/lv_string.h"
 #include "../../widgets/label/lv_label.h"
 #include "../../display/lv_display_private.h"
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX
+    #include "../../draw/sw/lv_draw_sw_mask_private.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -201,6 +204,9 @@ static void perf_monitor_disp_event_cb(lv_event_t * e)
             info->measured.render_in_progress = 0;
             info->measured.render_elaps_sum += lv_tick_elaps(info->measured.render_start);
             info->measured.render_cnt++;
+#if LV_USE_REFR_OCCLUSION
+            info->measured.occluded_sum += disp->occluded_task_cnt;
+#endif
             break;
         case LV_EVENT_FLUSH_START:
         case LV_EVENT_FLUSH_WAIT_START:
@@ -257,6 +263,29 @@ static void perf_update_timer_cb(lv_timer_t * t)
     info->calculated.render_avg_time = info->measured.render_cnt ? ((info->measured.render_elaps_sum -
                                                                      info->measured.flush_in_render_elaps_sum) /
                                                                     info->measured.render_cnt) : 0;
+    info->calculated.occluded_avg = info->measured.render_cnt ?
+                                    (info->measured.occluded_sum / info->measured.render_cnt) : 0;
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX
+    /*The cache counts since the start so take the difference since the last report*/
+    lv_draw_sw_mask_cache_info_t mask_cache_info;
+    lv_draw_sw_mask_cache_get_info(&mask_cache_info);
+    uint32_t mask_cache_hit = mask_cache_info.hit_cnt - info->measured.mask_cache_hit_cnt;
+    uint32_t mask_cache_miss = mask_cache_info.miss_cnt - info->measured.mask_cache_miss_cnt;
+    info->calculated.mask_cache_hit_rate = mask_cache_hit + mask_cache_miss ?
+                                           (100 * mask_cache_hit / (mask_cache_hit + mask_cache_miss)) : 100;
+    info->calculated.mask_cache_size = mask_cache_info.size;
+    info->calculated.mask_cache_max_size = mask_cache_info.max_size;
+#endif
+
+    lv_image_cache_info_t image_cache_info;
+    lv_image_cache_get_info(&image_cache_info);
+    uint32_t image_cache_hit = image_cache_info.hit_cnt - info->measured.image_cache_hit_cnt;
+    uint32_t image_cache_miss = image_cache_info.miss_cnt - info->measured.image_cache_miss_cnt;
+    info->calculated.image_cache_hit_rate = image_cache_hit + image_cache_miss ?
+                                            (100 * image_cache_hit / (image_cache_hit + image_cache_miss)) : 100;
+    info->calculated.image_cache_size = image_cache_info.size;
+    info->calculated.image_cache_max_size = image_cache_info.max_size;
 
     info->calculated.cpu_avg_total = ((info->calculated.cpu_avg_total * (info->calculated.run_cnt - 1)) +
                                       info->calculated.cpu) / info->calculated.run_cnt;
@@ -268,6 +297,12 @@ static void perf_update_timer_cb(lv_timer_t * t)
     lv_sysmon_perf_info_t prev_info = *info;
     lv_memzero(info, sizeof(lv_sysmon_perf_info_t));
     info->measured.refr_start = prev_info.measured.refr_start;
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX
+    info->measured.mask_cache_hit_cnt = mask_cache_info.hit_cnt;
+    info->measured.mask_cache_miss_cnt = mask_cache_info.miss_cnt;
+#endif
+    info->measured.image_cache_hit_cnt = image_cache_info.hit_cnt;
+    info->measured.image_cache_miss_cnt = image_cache_info.miss_cnt;
     info->calculated.cpu_avg_total = prev_info.calculated.cpu_avg_total;
     info->calculated.fps_avg_total = prev_info.calculated.fps_avg_total;
     info->calculated.run_cnt = prev_info.calculated.run_cnt;
@@ -284,20 +319,43 @@ static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
     LV_LOG("sysmon: "
            "%" LV_PRIu32 " FPS (refr_cnt: %" LV_PRIu32 " | redraw_cnt: %" LV_PRIu32"), "
            "refr %" LV_PRIu32 "ms (render %" LV_PRIu32 "ms | flush %" LV_PRIu32 "ms), "
-           "CPU %" LV_PRIu32 "%%\n",
+           "CPU %" LV_PRIu32 "%%, "
+           "occluded tasks %" LV_PRIu32 ", "
+           "mask cache %" LV_PRIu32 "%% hit (%" LV_PRIu32 "/%" LV_PRIu32 " bytes), "
+           "image cache %" LV_PRIu32 "%% hit (%" LV_PRIu32 "/%" LV_PRIu32 " bytes)\n",
            perf->calculated.fps, perf->measured.refr_cnt, perf->measured.render_cnt,
            perf->calculated.refr_avg_time, perf->calculated.render_avg_time, perf->calculated.flush_avg_time,
-           perf->calculated.cpu);
+           perf->calculated.cpu, perf->calculated.occluded_avg,
+           perf->calculated.mask_cache_hit_rate, perf->calculated.mask_cache_size, perf->calculated.mask_cache_max_size,
+           perf->calculated.image_cache_hit_rate, perf->calculated.image_cache_size, perf->calculated.image_cache_max_size);
 #else
     lv_obj_t * label = lv_observer_get_target(observer);
-    lv_label_set_text_fmt(
-        label,
-        "%" LV_PRIu32" FPS, %" LV_PRIu32 "%% CPU\n"
-        "%" LV_PRIu32" ms (%" LV_PRIu32" | %" LV_PRIu32")",
-        perf->calculated.fps, perf->calculated.cpu,
-        perf->calculated.render_avg_time + perf->calculated.flush_avg_time,
-        perf->calculated.render_avg_time, perf->calculated.flush_avg_time
-    );
+
+    /*Add the optional lines one by one*/
+    char buf[160];
+    uint32_t len = lv_snprintf(buf, sizeof(buf),
+                               "%" LV_PRIu32" FPS, %" LV_PRIu32 "%% CPU\n"
+                               "%" LV_PRIu32" ms (%" LV_PRIu32" | %" LV_PRIu32")",
+                               perf->calculated.fps, perf->calculated.cpu,
+                               perf->calculated.render_avg_time + perf->calculated.flush_avg_time,
+                               perf->calculated.render_avg_time, perf->calculated.flush_avg_time);
+#if LV_USE_REFR_OCCLUSION
+    len += lv_snprintf(buf + len, sizeof(buf) - len, "\n%" LV_PRIu32" occluded tasks", perf->calculated.occluded_avg);
+#endif
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX
+    if(perf->calculated.mask_cache_max_size) {
+        len += lv_snprintf(buf + len, sizeof(buf) - len, "\n%" LV_PRIu32"%% mask cache (%" LV_PRIu32" / %" LV_PRIu32" kB)",
+                           perf->calculated.mask_cache_hit_rate,
+                           (perf->calculated.mask_cache_size + 1023) / 1024, perf->calculated.mask_cache_max_size / 1024);
+    }
+#endif
+    if(perf->calculated.image_cache_max_size) {
+        len += lv_snprintf(buf + len, sizeof(buf) - len, "\n%" LV_PRIu32"%% image cache (%" LV_PRIu32" / %" LV_PRIu32" kB)",
+                           perf->calculated.image_cache_hit_rate,
+                           (perf->calculated.image_cache_size + 1023) / 1024, perf->calculated.image_cache_max_size / 1024);
+    }
+    LV_UNUSED(len);
+    lv_label_set_text(label, buf);
 #endif /*LV_USE_PERF_MONITOR_LOG_MODE*/
 }
 
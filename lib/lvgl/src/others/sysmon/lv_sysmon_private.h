@@ -46,6 +46,11 @@ struct lv_sysmon_perf_info_t {
         uint32_t flush_in_render_elaps_sum;
         uint32_t flush_not_in_render_start;
         uint32_t flush_not_in_render_elaps_sum;
+        uint32_t occluded_sum;
+        uint32_t mask_cache_hit_cnt;    /**< Hits of the SW mask cache at the last report*/
+        uint32_t mask_cache_miss_cnt;   /**< Misses of the SW mask cache at the last report*/
+        uint32_t image_cache_hit_cnt;   /**< Hits of the image cache at the last report*/
+        uint32_t image_cache_miss_cnt;  /**< Misses of the image cache at the last report*/
         uint32_t last_report_timestamp;
         uint32_t render_in_progress : 1;
     } measured;
@@ -56,6 +61,13 @@ struct lv_sysmon_perf_info_t {
         uint32_t refr_avg_time;
         uint32_t render_avg_time;       /**< Pure rendering time without flush time*/
         uint32_t flush_avg_time;        /**< Pure flushing time without rendering time*/
+        uint32_t occluded_avg;          /**< Draw tasks skipped per rendering as their widgets were covered*/
+        uint32_t mask_cache_hit_rate;   /**< Shadows and circles found in the SW mask cache in percentage*/
+        uint32_t mask_cache_size;       /**< Bytes used by the SW mask cache*/
+        uint32_t mask_cache_max_size;   /**< Budget of the SW mask cache in bytes*/
+        uint32_t image_cache_hit_rate;  /**< Opened images found decoded in the image cache in percentage*/
+        uint32_t image_cache_size;      /**< Bytes used by the image cache*/
+        uint32_t image_cache_max_size;  /**< Size of the image cache in bytes*/
         uint32_t cpu_avg_total;
         uint32_t fps_avg_total;
         uint32_t run_cnt;
@@ -47,6 +47,16 @@
  **********************/
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
 
+#if LV_MEM_ROUTE_BY_SIZE
+    static void lv_mem_heap_walker(void * ptr, size_t size, int used, void * user);
+    static void * route_malloc(size_t size, lv_mem_heap_t * heap);
+    static lv_mem_heap_t get_heap(const void * p);
+    static inline lv_tlsf_t get_heap_tlsf(lv_mem_heap_t heap);
+    static uint32_t get_size_class(size_t size);
+    static void used_add(lv_mem_heap_t heap, size_t size, bool new_block);
+    static void used_sub(lv_mem_heap_t heap, size_t size);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -76,14 +86,27 @@ void lv_mem_init(void)
 
 #if LV_MEM_ADR == 0
 #ifdef LV_MEM_POOL_ALLOC
-    state.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_POOL_ALLOC(LV_MEM_SIZE), LV_MEM_SIZE);
+    void * work_mem = (void *)LV_MEM_POOL_ALLOC(LV_MEM_SIZE);
 #else
     /*Allocate a large array to store the dynamically allocated data*/
     static LV_ATTRIBUTE_LARGE_RAM_ARRAY MEM_UNIT work_mem_int[LV_MEM_SIZE / sizeof(MEM_UNIT)];
-    state.tlsf = lv_tlsf_create_with_pool((void *)work_mem_int, LV_MEM_SIZE);
+    void * work_mem = (void *)work_mem_int;
 #endif
 #else
-    state.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
+    void * work_mem = (void *)LV_MEM_ADR;
+#endif
+    state.tlsf = lv_tlsf_create_with_pool(work_mem, LV_MEM_SIZE);
+
+#if LV_MEM_ROUTE_BY_SIZE
+    state.small_start = work_mem;
+    state.small_end = state.small_start + LV_MEM_SIZE;
+    state.large_tlsf = NULL;
+    lv_ll_init(&state.large_pool_ll, sizeof(lv_tlsf_large_pool_t));
+#endif
+
+#if LV_USE_MEM_SLAB
+    static LV_ATTRIBUTE_LARGE_RAM_ARRAY MEM_UNIT slab_mem[LV_MEM_SLAB_SIZE / sizeof(MEM_UNIT)];
+    lv_slab_init(&state.slab, slab_mem);
 #endif
 
     lv_ll_init(&state.pool_ll, sizeof(lv_pool_t));
@@ -100,6 +123,11 @@ void lv_mem_init(void)
 
 void lv_mem_deinit(void)
 {
+#if LV_MEM_ROUTE_BY_SIZE
+    lv_ll_clear(&state.large_pool_ll);
+    if(state.large_tlsf) lv_tlsf_destroy(state.large_tlsf);
+    state.large_tlsf = NULL;
+#endif
     lv_ll_clear(&state.pool_ll);
     lv_tlsf_destroy(state.tlsf);
 #if LV_USE_OS
@@ -122,6 +150,46 @@ lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes)
     return new_pool;
 }
 
+#if LV_MEM_ROUTE_BY_SIZE
+lv_mem_pool_t lv_mem_add_large_pool(void * mem, size_t bytes)
+{
+    /*The mutex is recursive so the list can be updated while the pool is added*/
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    lv_pool_t new_pool = NULL;
+    if(state.large_tlsf == NULL) {
+        /*The control structure of the large heap is stored at the beginning of its first pool*/
+        lv_tlsf_t large_tlsf = lv_tlsf_create_with_pool(mem, bytes);
+        if(large_tlsf) {
+            new_pool = lv_tlsf_get_pool(large_tlsf);
+            state.large_tlsf = large_tlsf;
+        }
+    }
+    else {
+        new_pool = lv_tlsf_add_pool(state.large_tlsf, mem, bytes);
+    }
+
+    if(new_pool) {
+        lv_tlsf_large_pool_t * pool_p = lv_ll_ins_tail(&state.large_pool_ll);
+        LV_ASSERT_MALLOC(pool_p);
+        pool_p->pool = new_pool;
+        pool_p->start = mem;
+        pool_p->end = pool_p->start + bytes;
+    }
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+
+    if(!new_pool) {
+        LV_LOG_WARN("failed to add large memory pool, address: %p, size: %zu", mem, bytes);
+        return NULL;
+    }
+
+    return new_pool;
+}
+#endif
+
 void lv_mem_remove_pool(lv_mem_pool_t pool)
 {
     lv_pool_t * pool_p;
@@ -133,6 +201,36 @@ void lv_mem_remove_pool(lv_mem_pool_t pool)
             return;
         }
     }
+
+#if LV_MEM_ROUTE_BY_SIZE
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    lv_tlsf_large_pool_t * large_pool_p;
+    LV_LL_READ(&state.large_pool_ll, large_pool_p) {
+        if(large_pool_p->pool == pool) {
+            /*The first large pool stores the control structure of the large heap so it can be removed only last*/
+            if(pool == lv_tlsf_get_pool(state.large_tlsf) && lv_ll_get_len(&state.large_pool_ll) > 1) {
+                LV_LOG_WARN("the first large pool can be removed only after the others: %p", pool);
+                LV_ASSERT_MSG(false, "the first large pool can be removed only after the others");
+            }
+            else {
+                lv_tlsf_remove_pool(state.large_tlsf, pool);
+                if(lv_ll_get_len(&state.large_pool_ll) == 1) state.large_tlsf = NULL;
+                lv_ll_remove(&state.large_pool_ll, large_pool_p);
+                lv_free(large_pool_p);
+            }
+#if LV_USE_OS
+            lv_mutex_unlock(&state.mutex);
+#endif
+            return;
+        }
+    }
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+#endif
+
     LV_LOG_WARN("invalid pool: %p", pool);
 }
 
@@ -141,11 +239,32 @@ void * lv_malloc_core(size_t size)
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
+
+#if LV_USE_MEM_SLAB
+    void * slab_p = lv_slab_alloc(&state.slab, size);
+    if(slab_p) {
+        state.cur_used += lv_slab_get_block_size(&state.slab, slab_p);
+        state.max_used = LV_MAX(state.cur_used, state.max_used);
+#if LV_USE_OS
+        lv_mutex_unlock(&state.mutex);
+#endif
+        return slab_p;
+    }
+#endif
+#if LV_MEM_ROUTE_BY_SIZE
+    lv_mem_heap_t heap;
+    void * p = route_malloc(size, &heap);
+#else
     void * p = lv_tlsf_malloc(state.tlsf, size);
+#endif
 
     if(p) {
-        state.cur_used += lv_tlsf_block_size(p);
+        size_t block_size = lv_tlsf_block_size(p);
+        state.cur_used += block_size;
         state.max_used = LV_MAX(state.cur_used, state.max_used);
+#if LV_MEM_ROUTE_BY_SIZE
+        used_add(heap, block_size, true);
+#endif
     }
 
 #if LV_USE_OS
@@ -160,13 +279,65 @@ void * lv_realloc_core(void * p, size_t new_size)
     lv_mutex_lock(&state.mutex);
 #endif
 
+#if LV_USE_MEM_SLAB
+    if(p && lv_slab_is_own(&state.slab, p)) {
+        /*Keep the block if it's large enough, otherwise move it to a larger slab class or the heap.
+         *The mutex is recursive so the allocator can be called again.*/
+        size_t slab_size = lv_slab_get_block_size(&state.slab, p);
+        void * slab_p_new = p;
+        if(new_size > slab_size) {
+            slab_p_new = lv_malloc_core(new_size);
+            if(slab_p_new) {
+                lv_memcpy(slab_p_new, p, slab_size);
+                lv_free_core(p);
+            }
+        }
+#if LV_USE_OS
+        lv_mutex_unlock(&state.mutex);
+#endif
+        return slab_p_new;
+    }
+#endif
+
     size_t old_size = lv_tlsf_block_size(p);
+#if LV_MEM_ROUTE_BY_SIZE
+    lv_mem_heap_t heap = LV_MEM_HEAP_SMALL;
+    void * p_new = NULL;
+    if(p == NULL) {
+        p_new = route_malloc(new_size, &heap);
+    }
+    else {
+        /*Try to keep the block in its heap, otherwise move it to the other heap*/
+        heap = get_heap(p);
+        p_new = lv_tlsf_realloc(get_heap_tlsf(heap), p, new_size);
+        if(p_new) {
+            used_sub(heap, old_size);
+        }
+        else if(state.large_tlsf) {
+            lv_mem_heap_t other = heap == LV_MEM_HEAP_SMALL ? LV_MEM_HEAP_LARGE : LV_MEM_HEAP_SMALL;
+            p_new = lv_tlsf_malloc(get_heap_tlsf(other), new_size);
+            if(p_new) {
+                lv_memcpy(p_new, p, LV_MIN(old_size, new_size));
+                lv_tlsf_free(get_heap_tlsf(heap), p);
+                used_sub(heap, old_size);
+                state.heap_fallback_cnt[other]++;
+                heap = other;
+            }
+        }
+    }
+#else
     void * p_new = lv_tlsf_realloc(state.tlsf, p, new_size);
+#endif
 
     if(p_new) {
+        size_t new_block_size = lv_tlsf_block_size(p_new);
         state.cur_used -= old_size;
-        state.cur_used += lv_tlsf_block_size(p_new);
+        state.cur_used += new_block_size;
         state.max_used = LV_MAX(state.cur_used, state.max_used);
+#if LV_MEM_ROUTE_BY_SIZE
+        /*A moved or resized block is not a new allocation*/
+        used_add(heap, new_block_size, p == NULL);
+#endif
     }
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
@@ -181,11 +352,30 @@ void lv_free_core(void * p)
     lv_mutex_lock(&state.mutex);
 #endif
 
+#if LV_USE_MEM_SLAB
+    if(lv_slab_is_own(&state.slab, p)) {
+        size_t slab_size = lv_slab_get_block_size(&state.slab, p);
+        lv_slab_free(&state.slab, p);
+        if(state.cur_used > slab_size) state.cur_used -= slab_size;
+        else state.cur_used = 0;
+#if LV_USE_OS
+        lv_mutex_unlock(&state.mutex);
+#endif
+        return;
+    }
+#endif
+
 #if LV_MEM_ADD_JUNK
     lv_memset(p, 0xbb, lv_tlsf_block_size(data));
 #endif
     size_t size = lv_tlsf_block_size(p);
+#if LV_MEM_ROUTE_BY_SIZE
+    lv_mem_heap_t heap = get_heap(p);
+    lv_tlsf_free(get_heap_tlsf(heap), p);
+    used_sub(heap, size);
+#else
     lv_tlsf_free(state.tlsf, p);
+#endif
     if(state.cur_used > size) state.cur_used -= size;
     else state.cur_used = 0;
 
@@ -203,11 +393,36 @@ void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
     lv_pool_t * pool_p;
     LV_LL_READ(&state.pool_ll, pool_p) {
         lv_tlsf_walk_pool(*pool_p, lv_mem_walker, mon_p);
+#if LV_MEM_ROUTE_BY_SIZE
+        lv_tlsf_walk_pool(*pool_p, lv_mem_heap_walker, &mon_p->heaps[LV_MEM_HEAP_SMALL]);
+#endif
+    }
+
+#if LV_MEM_ROUTE_BY_SIZE
+    lv_tlsf_large_pool_t * large_pool_p;
+    LV_LL_READ(&state.large_pool_ll, large_pool_p) {
+        lv_tlsf_walk_pool(large_pool_p->pool, lv_mem_walker, mon_p);
+        lv_tlsf_walk_pool(large_pool_p->pool, lv_mem_heap_walker, &mon_p->heaps[LV_MEM_HEAP_LARGE]);
+    }
+
+    uint32_t i;
+    for(i = 0; i < LV_MEM_HEAP_CNT; i++) {
+        mon_p->heaps[i].cur_used = state.heap_cur_used[i];
+        mon_p->heaps[i].max_used = state.heap_max_used[i];
+        mon_p->heaps[i].fallback_cnt = state.heap_fallback_cnt[i];
     }
+    lv_memcpy(mon_p->size_classes, state.size_classes, sizeof(state.size_classes));
+#endif
+
+    /*The free memory of the slabs is not contiguous, so the fragmentation is computed from the heaps*/
+    size_t heap_free_size = mon_p->free_size;
+#if LV_USE_MEM_SLAB
+    lv_slab_monitor(&state.slab, mon_p);
+#endif
 
     mon_p->used_pct = 100 - (uint64_t)100U * mon_p->free_size / mon_p->total_size;
-    if(mon_p->free_size > 0) {
-        mon_p->frag_pct = (uint64_t)mon_p->free_biggest_size * 100U / mon_p->free_size;
+    if(heap_free_size > 0) {
+        mon_p->frag_pct = (uint64_t)mon_p->free_biggest_size * 100U / heap_free_size;
         mon_p->frag_pct = 100 - mon_p->frag_pct;
     }
     else {
@@ -243,6 +458,37 @@ lv_result_t lv_mem_test_core(void)
         }
     }
 
+#if LV_MEM_ROUTE_BY_SIZE
+    if(state.large_tlsf && lv_tlsf_check(state.large_tlsf)) {
+        LV_LOG_WARN("large heap failed");
+#if LV_USE_OS
+        lv_mutex_unlock(&state.mutex);
+#endif
+        return LV_RESULT_INVALID;
+    }
+
+    lv_tlsf_large_pool_t * large_pool_p;
+    LV_LL_READ(&state.large_pool_ll, large_pool_p) {
+        if(lv_tlsf_check_pool(large_pool_p->pool)) {
+            LV_LOG_WARN("large pool failed");
+#if LV_USE_OS
+            lv_mutex_unlock(&state.mutex);
+#endif
+            return LV_RESULT_INVALID;
+        }
+    }
+#endif
+
+#if LV_USE_MEM_SLAB
+    if(!lv_slab_check(&state.slab)) {
+        LV_LOG_WARN("slab failed");
+#if LV_USE_OS
+        lv_mutex_unlock(&state.mutex);
+#endif
+        return LV_RESULT_INVALID;
+    }
+#endif
+
     LV_TRACE_MEM("passed");
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
@@ -270,4 +516,112 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
             mon_p->free_biggest_size = size;
     }
 }
+
+#if LV_MEM_ROUTE_BY_SIZE
+
+static void lv_mem_heap_walker(void * ptr, size_t size, int used, void * user)
+{
+    LV_UNUSED(ptr);
+
+    lv_mem_heap_monitor_t * heap_mon = user;
+    heap_mon->total_size += size;
+    if(!used) {
+        heap_mon->free_size += size;
+        if(size > heap_mon->free_biggest_size)
+            heap_mon->free_biggest_size = size;
+    }
+}
+
+/**
+ * Allocate from the heap of the size, or from the other heap if it's full
+ * @param size      size in bytes
+ * @param heap      store the heap of the block here
+ * @return          the allocated block or NULL
+ */
+static void * route_malloc(size_t size, lv_mem_heap_t * heap)
+{
+    lv_mem_heap_t first = LV_MEM_HEAP_SMALL;
+    if(size > LV_MEM_ROUTE_SMALL_MAX && state.large_tlsf) first = LV_MEM_HEAP_LARGE;
+
+    *heap = first;
+    void * p = lv_tlsf_malloc(get_heap_tlsf(first), size);
+    if(p || state.large_tlsf == NULL) return p;
+
+    lv_mem_heap_t other = first == LV_MEM_HEAP_SMALL ? LV_MEM_HEAP_LARGE : LV_MEM_HEAP_SMALL;
+    p = lv_tlsf_malloc(get_heap_tlsf(other), size);
+    if(p) {
+        state.heap_fallback_cnt[other]++;
+        *heap = other;
+    }
+
+    return p;
+}
+
+static lv_mem_heap_t get_heap(const void * p)
+{
+    /*Most blocks are small so check the `LV_MEM_SIZE` pool first*/
+    const uint8_t * p8 = p;
+    if(p8 >= state.small_start && p8 < state.small_end) return LV_MEM_HEAP_SMALL;
+
+    lv_tlsf_large_pool_t * pool_p;
+    LV_LL_READ(&state.large_pool_ll, pool_p) {
+        if(p8 >= pool_p->start && p8 < pool_p->end) return LV_MEM_HEAP_LARGE;
+    }
+
+    /*In a pool added with `lv_mem_add_pool()`*/
+    return LV_MEM_HEAP_SMALL;
+}
+
+static inline lv_tlsf_t get_heap_tlsf(lv_mem_heap_t heap)
+{
+    return heap == LV_MEM_HEAP_LARGE ? state.large_tlsf : state.tlsf;
+}
+
+static uint32_t get_size_class(size_t size)
+{
+    if(size <= 16) return 0;
+
+#if defined(__GNUC__)
+    /*Class of 17..32 bytes is 1, of 33..64 bytes is 2, etc*/
+    size_t size_m1 = LV_MIN(size - 1, (size_t)UINT32_MAX);
+    uint32_t size_class = 32 - __builtin_clz((uint32_t)size_m1) - 4;
+    return LV_MIN(size_class, LV_MEM_SIZE_CLASS_CNT - 1);
+#else
+    uint32_t size_class = 0;
+    size_t class_max = 16;
+    while(size > class_max && size_class < LV_MEM_SIZE_CLASS_CNT - 1) {
+        class_max <<= 1;
+        size_class++;
+    }
+
+    return size_class;
+#endif
+}
+
+/**
+ * Count a block allocated or resized in a heap
+ * @param heap          the heap of the block
+ * @param size          size of the block
+ * @param new_block     true: count it as an allocation in its size class
+ */
+static void used_add(lv_mem_heap_t heap, size_t size, bool new_block)
+{
+    state.heap_cur_used[heap] += size;
+    state.heap_max_used[heap] = LV_MAX(state.heap_cur_used[heap], state.heap_max_used[heap]);
+
+    lv_mem_size_class_monitor_t * size_class = &state.size_classes[get_size_class(size)];
+    size_class->used_cnt++;
+    if(new_block) size_class->alloc_cnt++;
+}
+
+static void used_sub(lv_mem_heap_t heap, size_t size)
+{
+    if(state.heap_cur_used[heap] > size) state.heap_cur_used[heap] -= size;
+    else state.heap_cur_used[heap] = 0;
+
+    lv_mem_size_class_monitor_t * size_class = &state.size_classes[get_size_class(size)];
+    if(size_class->used_cnt > 0) size_class->used_cnt--;
+}
+
+#endif /*LV_MEM_ROUTE_BY_SIZE*/
 #endif /*LV_STDLIB_BUILTIN*/
@@ -0,0 +1,257 @@
+/**
+ * @file lv_slab.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_slab.h"
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+#if LV_USE_MEM_SLAB
+
+#include "../lv_string.h"
+#include "../../misc/lv_assert.h"
+#include "../../misc/lv_math.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void list_push(lv_slab_t * slab, uint16_t * head, uint16_t idx);
+static void list_remove(lv_slab_t * slab, uint16_t * head, uint16_t idx);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const uint16_t block_sizes[] = {LV_MEM_SLAB_BLOCK_SIZES};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_slab_init(lv_slab_t * slab, void * mem)
+{
+    lv_memzero(slab, sizeof(lv_slab_t));
+    slab->mem = mem;
+    slab->mem_end = slab->mem + LV_SLAB_PAGE_CNT * LV_SLAB_PAGE_SIZE;
+
+    uint32_t class_cnt = sizeof(block_sizes) / sizeof(block_sizes[0]);
+    LV_ASSERT_MSG(class_cnt <= LV_MEM_SLAB_CLASS_MAX, "Too many LV_MEM_SLAB_BLOCK_SIZES");
+    slab->class_cnt = LV_MIN(class_cnt, LV_MEM_SLAB_CLASS_MAX);
+
+    uint32_t i;
+    for(i = 0; i < slab->class_cnt; i++) {
+        LV_ASSERT_MSG(block_sizes[i] % 8 == 0 && block_sizes[i] <= LV_SLAB_BLOCK_SIZE_MAX,
+                      "LV_MEM_SLAB_BLOCK_SIZES should be multiples of 8 up to LV_SLAB_BLOCK_SIZE_MAX");
+        LV_ASSERT_MSG(i == 0 || block_sizes[i] > block_sizes[i - 1], "LV_MEM_SLAB_BLOCK_SIZES should be ascending");
+        slab->block_sizes[i] = block_sizes[i];
+        slab->partial_pages[i] = LV_SLAB_NONE;
+        slab->classes[i].block_size = block_sizes[i];
+    }
+
+    /*Smallest class for each size. Sizes above the largest class are not served.*/
+    uint32_t class_idx = 0;
+    for(i = 0; i <= LV_SLAB_BLOCK_SIZE_MAX / 8; i++) {
+        while(class_idx < slab->class_cnt && slab->block_sizes[class_idx] < i * 8) class_idx++;
+        slab->size_to_class[i] = (uint8_t)class_idx;
+    }
+
+    slab->free_pages = LV_SLAB_NONE;
+    for(i = LV_SLAB_PAGE_CNT; i > 0; i--) {
+        list_push(slab, &slab->free_pages, (uint16_t)(i - 1));
+    }
+}
+
+void * lv_slab_alloc(lv_slab_t * slab, size_t size)
+{
+    if(size > LV_SLAB_BLOCK_SIZE_MAX) return NULL;
+
+    uint32_t class_idx = slab->size_to_class[(size + 7) >> 3];
+    if(class_idx >= slab->class_cnt) return NULL;
+
+    uint16_t page_idx = slab->partial_pages[class_idx];
+    if(page_idx == LV_SLAB_NONE) {
+        page_idx = slab->free_pages;
+        if(page_idx == LV_SLAB_NONE) {
+            slab->classes[class_idx].full_cnt++;
+            return NULL;
+        }
+
+        /*Take a free page and chain its blocks*/
+        list_remove(slab, &slab->free_pages, page_idx);
+        lv_slab_page_t * page = &slab->pages[page_idx];
+        uint32_t block_size = slab->block_sizes[class_idx];
+        uint8_t * page_mem = slab->mem + (uint32_t)page_idx * LV_SLAB_PAGE_SIZE;
+        uint32_t block_cnt = LV_SLAB_PAGE_SIZE / block_size;
+        uint32_t i;
+        for(i = 0; i < block_cnt - 1; i++) {
+            *(void **)(page_mem + i * block_size) = page_mem + (i + 1) * block_size;
+        }
+        *(void **)(page_mem + i * block_size) = NULL;
+        page->free_list = page_mem;
+        page->used_cnt = 0;
+        page->class_idx = (uint8_t)class_idx;
+        list_push(slab, &slab->partial_pages[class_idx], page_idx);
+        slab->classes[class_idx].page_cnt++;
+    }
+
+    lv_slab_page_t * page = &slab->pages[page_idx];
+    void * p = page->free_list;
+    page->free_list = *(void **)p;
+    page->used_cnt++;
+    if(page->free_list == NULL) list_remove(slab, &slab->partial_pages[class_idx], page_idx);
+
+    slab->classes[class_idx].used_cnt++;
+    slab->classes[class_idx].alloc_cnt++;
+
+    return p;
+}
+
+void lv_slab_free(lv_slab_t * slab, void * p)
+{
+    uint16_t page_idx = (uint16_t)(((uint8_t *)p - slab->mem) / LV_SLAB_PAGE_SIZE);
+    lv_slab_page_t * page = &slab->pages[page_idx];
+    uint32_t class_idx = page->class_idx;
+
+    bool was_full = page->free_list == NULL;
+    *(void **)p = page->free_list;
+    page->free_list = p;
+    page->used_cnt--;
+    slab->classes[class_idx].used_cnt--;
+
+    if(page->used_cnt == 0) {
+        /*Give the page back so that any class can use it*/
+        if(!was_full) list_remove(slab, &slab->partial_pages[class_idx], page_idx);
+        list_push(slab, &slab->free_pages, page_idx);
+        slab->classes[class_idx].page_cnt--;
+    }
+    else if(was_full) {
+        list_push(slab, &slab->partial_pages[class_idx], page_idx);
+    }
+}
+
+size_t lv_slab_get_block_size(const lv_slab_t * slab, const void * p)
+{
+    uint32_t page_idx = ((const uint8_t *)p - slab->mem) / LV_SLAB_PAGE_SIZE;
+    return slab->block_sizes[slab->pages[page_idx].class_idx];
+}
+
+void lv_slab_monitor(const lv_slab_t * slab, lv_mem_monitor_t * mon_p)
+{
+    lv_memcpy(mon_p->slabs, slab->classes, sizeof(slab->classes));
+    mon_p->slab_class_cnt = slab->class_cnt;
+
+    uint32_t free_page_cnt = 0;
+    uint16_t page_idx;
+    for(page_idx = slab->free_pages; page_idx != LV_SLAB_NONE; page_idx = slab->pages[page_idx].next) {
+        free_page_cnt++;
+    }
+    mon_p->slab_free_page_cnt = free_page_cnt;
+
+    /*The free pages and the free blocks of the used pages are free memory*/
+    size_t used_size = 0;
+    uint32_t i;
+    for(i = 0; i < slab->class_cnt; i++) {
+        used_size += (size_t)slab->classes[i].used_cnt * slab->block_sizes[i];
+        mon_p->used_cnt += slab->classes[i].used_cnt;
+    }
+    mon_p->total_size += LV_SLAB_PAGE_CNT * LV_SLAB_PAGE_SIZE;
+    mon_p->free_size += LV_SLAB_PAGE_CNT * LV_SLAB_PAGE_SIZE - used_size;
+}
+
+bool lv_slab_check(const lv_slab_t * slab)
+{
+    /*List of each page: 0: none (all blocks used), 1: free pages, 2: pages with free blocks*/
+    uint8_t listed[LV_SLAB_PAGE_CNT];
+    lv_memzero(listed, sizeof(listed));
+
+    uint16_t prev = LV_SLAB_NONE;
+    uint16_t idx;
+    for(idx = slab->free_pages; idx != LV_SLAB_NONE; idx = slab->pages[idx].next) {
+        if(idx >= LV_SLAB_PAGE_CNT || listed[idx] || slab->pages[idx].prev != prev) return false;
+        if(slab->pages[idx].used_cnt != 0) return false;
+        listed[idx] = 1;
+        prev = idx;
+    }
+
+    uint32_t c;
+    for(c = 0; c < slab->class_cnt; c++) {
+        prev = LV_SLAB_NONE;
+        for(idx = slab->partial_pages[c]; idx != LV_SLAB_NONE; idx = slab->pages[idx].next) {
+            if(idx >= LV_SLAB_PAGE_CNT || listed[idx] || slab->pages[idx].prev != prev) return false;
+            if(slab->pages[idx].class_idx != c || slab->pages[idx].free_list == NULL) return false;
+            listed[idx] = 2;
+            prev = idx;
+        }
+    }
+
+    uint32_t page_cnt[LV_MEM_SLAB_CLASS_MAX] = {0};
+    uint32_t used_cnt[LV_MEM_SLAB_CLASS_MAX] = {0};
+    for(idx = 0; idx < LV_SLAB_PAGE_CNT; idx++) {
+        if(listed[idx] == 1) continue;
+
+        const lv_slab_page_t * page = &slab->pages[idx];
+        if(page->class_idx >= slab->class_cnt || page->used_cnt == 0) return false;
+
+        /*The free blocks are at block boundaries in the page and with the used ones they fill the page*/
+        uint32_t block_size = slab->block_sizes[page->class_idx];
+        uint32_t block_cnt = LV_SLAB_PAGE_SIZE / block_size;
+        const uint8_t * page_mem = slab->mem + (uint32_t)idx * LV_SLAB_PAGE_SIZE;
+        uint32_t free_cnt = 0;
+        const uint8_t * p;
+        for(p = page->free_list; p; p = *(const uint8_t * const *)p) {
+            if(p < page_mem || p >= page_mem + block_cnt * block_size || (p - page_mem) % block_size) return false;
+            if(++free_cnt > block_cnt) return false;
+        }
+        if(free_cnt + page->used_cnt != block_cnt) return false;
+        if(listed[idx] == 0 && free_cnt != 0) return false;
+
+        page_cnt[page->class_idx]++;
+        used_cnt[page->class_idx] += page->used_cnt;
+    }
+
+    for(c = 0; c < slab->class_cnt; c++) {
+        if(page_cnt[c] != slab->classes[c].page_cnt || used_cnt[c] != slab->classes[c].used_cnt) return false;
+    }
+
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void list_push(lv_slab_t * slab, uint16_t * head, uint16_t idx)
+{
+    lv_slab_page_t * page = &slab->pages[idx];
+    page->prev = LV_SLAB_NONE;
+    page->next = *head;
+    if(*head != LV_SLAB_NONE) slab->pages[*head].prev = idx;
+    *head = idx;
+}
+
+static void list_remove(lv_slab_t * slab, uint16_t * head, uint16_t idx)
+{
+    lv_slab_page_t * page = &slab->pages[idx];
+    if(page->prev != LV_SLAB_NONE) slab->pages[page->prev].next = page->next;
+    else *head = page->next;
+    if(page->next != LV_SLAB_NONE) slab->pages[page->next].prev = page->prev;
+}
+
+#endif /*LV_USE_MEM_SLAB*/
+#endif /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
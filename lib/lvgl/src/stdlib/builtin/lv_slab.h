@@ -0,0 +1,134 @@
+/**
+ * @file lv_slab.h
+ *
+ */
+
+#ifndef LV_SLAB_H
+#define LV_SLAB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../lv_conf_internal.h"
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+#if LV_USE_MEM_SLAB
+
+#include "../../misc/lv_types.h"
+#include "../lv_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** The slab pool is divided into pages of this size. A page stores the blocks of one class.*/
+#define LV_SLAB_PAGE_SIZE       1024
+
+/** The largest block size of a class*/
+#define LV_SLAB_BLOCK_SIZE_MAX  (LV_SLAB_PAGE_SIZE / 2)
+
+#define LV_SLAB_PAGE_CNT        (LV_MEM_SLAB_SIZE / LV_SLAB_PAGE_SIZE)
+
+#define LV_SLAB_NONE            0xFFFF
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    void * free_list;       /**< The first free block. The first word of a free block points to the next one.*/
+    uint16_t used_cnt;      /**< Number of allocated blocks in the page*/
+    uint16_t prev;          /**< Pages with free blocks of the same class, or the free pages*/
+    uint16_t next;
+    uint8_t class_idx;
+} lv_slab_page_t;
+
+typedef struct {
+    uint8_t * mem;
+    uint8_t * mem_end;
+    uint32_t class_cnt;
+    uint16_t block_sizes[LV_MEM_SLAB_CLASS_MAX];
+    uint16_t partial_pages[LV_MEM_SLAB_CLASS_MAX];  /**< The first page with free blocks of each class*/
+    uint16_t free_pages;                            /**< The first unused page*/
+    uint8_t size_to_class[LV_SLAB_BLOCK_SIZE_MAX / 8 + 1];  /**< Class of each size rounded up to 8 bytes*/
+    lv_slab_page_t pages[LV_SLAB_PAGE_CNT];
+    lv_mem_slab_monitor_t classes[LV_MEM_SLAB_CLASS_MAX];
+} lv_slab_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a slab allocator with the classes of `LV_MEM_SLAB_BLOCK_SIZES`
+ * @param slab      pointer to an uninitialized slab allocator
+ * @param mem       the pool, `LV_MEM_SLAB_SIZE` bytes
+ */
+void lv_slab_init(lv_slab_t * slab, void * mem);
+
+/**
+ * Allocate a block from the smallest class the size fits into
+ * @param slab      pointer to a slab allocator
+ * @param size      size in bytes
+ * @return          the block, or NULL if the size is too large for the classes or the pages are used up
+ */
+void * lv_slab_alloc(lv_slab_t * slab, size_t size);
+
+/**
+ * Free a block allocated by `lv_slab_alloc`
+ * @param slab      pointer to a slab allocator
+ * @param p         the block
+ */
+void lv_slab_free(lv_slab_t * slab, void * p);
+
+/**
+ * Get the size of a block allocated by `lv_slab_alloc`
+ * @param slab      pointer to a slab allocator
+ * @param p         the block
+ * @return          the block size of its class
+ */
+size_t lv_slab_get_block_size(const lv_slab_t * slab, const void * p);
+
+/**
+ * Copy the statistics of the classes and add the pool to the total, free and used sizes
+ * @param slab      pointer to a slab allocator
+ * @param mon_p     the slab fields are set, the pool is added to the other fields
+ */
+void lv_slab_monitor(const lv_slab_t * slab, lv_mem_monitor_t * mon_p);
+
+/**
+ * Check the consistency of the pages, their lists and free blocks, and the statistics of the classes
+ * @param slab      pointer to a slab allocator
+ * @return          true: no error was found
+ */
+bool lv_slab_check(const lv_slab_t * slab);
+
+/**
+ * Check if a block is in the pool of a slab allocator
+ * @param slab      pointer to a slab allocator
+ * @param p         a block
+ * @return          true: the block was allocated by `lv_slab_alloc`
+ */
+static inline bool lv_slab_is_own(const lv_slab_t * slab, const void * p)
+{
+    const uint8_t * p8 = (const uint8_t *)p;
+    return p8 >= slab->mem && p8 < slab->mem_end;
+}
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_MEM_SLAB*/
+#endif /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_SLAB_H*/
@@ -53,6 +53,9 @@
  *   GLOBAL FUNCTIONS
  **********************/
 
+#if !LV_STRING_BUILTIN_ARMV7EM
+/*With LV_STRING_BUILTIN_ARMV7EM these are in lv_string_builtin_armv7em.c*/
+
 void * LV_ATTRIBUTE_FAST_MEM lv_memcpy(void * dst, const void * src, size_t len)
 {
     uint8_t * d8 = dst;
@@ -171,6 +174,8 @@ void * LV_ATTRIBUTE_FAST_MEM lv_memmove(void * dst, const void * src, size_t len
     return dst;
 }
 
+#endif /*!LV_STRING_BUILTIN_ARMV7EM*/
+
 int lv_memcmp(const void * p1, const void * p2, size_t len)
 {
     const char * s1 = (const char *) p1;
@@ -0,0 +1,333 @@
+/**
+ * @file lv_string_builtin_armv7em.c
+ *
+ * `lv_memcpy`, `lv_memset` and `lv_memmove` tuned for ARMv7E-M (Cortex-M4/M7).
+ * The 32 byte blocks are loaded into 8 locals before they are stored so that GCC can emit
+ * LDM/STM or LDRD/STRD bursts. Sources with a different alignment than the destination
+ * are read as aligned words and shifted together instead of copied byte by byte.
+ * It's plain C so it works on any 32 or 64 bit core too.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+#if LV_USE_STDLIB_STRING == LV_STDLIB_BUILTIN && LV_STRING_BUILTIN_ARMV7EM
+#include "../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static inline void copy_bytes(uint8_t * d8, const uint8_t * s8, size_t len);
+static void copy_shifted(uint32_t * d32, const uint8_t * s8, size_t word_cnt);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/*Join the end of word `a` and the start of word `b` as they are in memory. `shift` is 8, 16 or 24.*/
+#if LV_BIG_ENDIAN_SYSTEM
+    #define MERGE(a, b, shift) (((a) << (shift)) | ((b) >> (32 - (shift))))
+#else
+    #define MERGE(a, b, shift) (((a) >> (shift)) | ((b) << (32 - (shift))))
+#endif
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void * LV_ATTRIBUTE_FAST_MEM lv_memcpy(void * dst, const void * src, size_t len)
+{
+    uint8_t * d8 = dst;
+    const uint8_t * s8 = src;
+
+    if(len < 16) {
+        copy_bytes(d8, s8, len);
+        return dst;
+    }
+
+    /*Align the destination*/
+    size_t head = (0 - (lv_uintptr_t)d8) & 0x3;
+    copy_bytes(d8, s8, head);
+    d8 += head;
+    s8 += head;
+    len -= head;
+
+    uint32_t * d32 = (uint32_t *)d8;
+    size_t word_cnt = len >> 2;
+
+    if(((lv_uintptr_t)s8 & 0x3) == 0) {
+        const uint32_t * s32 = (const uint32_t *)s8;
+        while(word_cnt >= 8) {
+            uint32_t w0 = s32[0];
+            uint32_t w1 = s32[1];
+            uint32_t w2 = s32[2];
+            uint32_t w3 = s32[3];
+            uint32_t w4 = s32[4];
+            uint32_t w5 = s32[5];
+            uint32_t w6 = s32[6];
+            uint32_t w7 = s32[7];
+            d32[0] = w0;
+            d32[1] = w1;
+            d32[2] = w2;
+            d32[3] = w3;
+            d32[4] = w4;
+            d32[5] = w5;
+            d32[6] = w6;
+            d32[7] = w7;
+            d32 += 8;
+            s32 += 8;
+            word_cnt -= 8;
+        }
+
+        while(word_cnt) {
+            *d32 = *s32;
+            d32++;
+            s32++;
+            word_cnt--;
+        }
+    }
+    else {
+        /*The last word is copied by bytes as its aligned source word could be past the end*/
+        word_cnt--;
+        copy_shifted(d32, s8, word_cnt);
+        d32 += word_cnt;
+    }
+
+    size_t done = (uint8_t *)d32 - d8;
+    copy_bytes((uint8_t *)d32, s8 + done, len - done);
+
+    return dst;
+}
+
+void LV_ATTRIBUTE_FAST_MEM lv_memset(void * dst, uint8_t v, size_t len)
+{
+    uint8_t * d8 = (uint8_t *)dst;
+
+    if(len < 16) {
+        while(len) {
+            *d8 = v;
+            d8++;
+            len--;
+        }
+        return;
+    }
+
+    /*Align the destination*/
+    size_t head = (0 - (lv_uintptr_t)d8) & 0x3;
+    len -= head;
+    while(head) {
+        *d8 = v;
+        d8++;
+        head--;
+    }
+
+    uint32_t v32 = (uint32_t)v * 0x01010101U;
+    uint32_t * d32 = (uint32_t *)d8;
+    size_t word_cnt = len >> 2;
+    while(word_cnt >= 8) {
+        d32[0] = v32;
+        d32[1] = v32;
+        d32[2] = v32;
+        d32[3] = v32;
+        d32[4] = v32;
+        d32[5] = v32;
+        d32[6] = v32;
+        d32[7] = v32;
+        d32 += 8;
+        word_cnt -= 8;
+    }
+
+    while(word_cnt) {
+        *d32 = v32;
+        d32++;
+        word_cnt--;
+    }
+
+    d8 = (uint8_t *)d32;
+    len &= 0x3;
+    while(len) {
+        *d8 = v;
+        d8++;
+        len--;
+    }
+}
+
+void * LV_ATTRIBUTE_FAST_MEM lv_memmove(void * dst, const void * src, size_t len)
+{
+    uint8_t * d8 = dst;
+    const uint8_t * s8 = src;
+
+    /*`lv_memcpy` copies forward and reads at most 8 bytes ahead of what it writes*/
+    if(d8 + len <= s8 || s8 + len <= d8 || d8 + 8 <= s8) {
+        return lv_memcpy(dst, src, len);
+    }
+
+    if(d8 < s8) {
+        copy_bytes(d8, s8, len);
+        return dst;
+    }
+
+    if(d8 == s8) return dst;
+
+    /*Overlapping with the destination after the source: copy backward*/
+    d8 += len;
+    s8 += len;
+
+    if((((lv_uintptr_t)d8 ^ (lv_uintptr_t)s8) & 0x3) == 0 && d8 - s8 >= 4) {
+        while(len && ((lv_uintptr_t)d8 & 0x3)) {
+            d8--;
+            s8--;
+            *d8 = *s8;
+            len--;
+        }
+
+        uint32_t * d32 = (uint32_t *)d8;
+        const uint32_t * s32 = (const uint32_t *)s8;
+        while(len >= 4) {
+            d32--;
+            s32--;
+            *d32 = *s32;
+            len -= 4;
+        }
+        d8 = (uint8_t *)d32;
+        s8 = (const uint8_t *)s32;
+    }
+
+    while(len) {
+        d8--;
+        s8--;
+        *d8 = *s8;
+        len--;
+    }
+
+    return dst;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static inline void copy_bytes(uint8_t * d8, const uint8_t * s8, size_t len)
+{
+    while(len) {
+        *d8 = *s8;
+        d8++;
+        s8++;
+        len--;
+    }
+}
+
+/**
+ * Copy words from a source that is not word aligned to an aligned destination.
+ * Only aligned source words are read and only the ones fully inside the copied range.
+ * @param d32       aligned destination
+ * @param s8        unaligned source
+ * @param word_cnt  number of words to copy. `s8` should have at least `word_cnt + 1` words.
+ */
+static void copy_shifted(uint32_t * d32, const uint8_t * s8, size_t word_cnt)
+{
+    uint32_t offset = (lv_uintptr_t)s8 & 0x3;
+    const uint32_t * s32 = (const uint32_t *)(s8 - offset) + 1;
+
+    /*The bytes before the first aligned source word, put where they'd be in their aligned word*/
+    uint32_t carry = 0;
+    uint32_t i;
+    for(i = offset; i < 4; i++) {
+#if LV_BIG_ENDIAN_SYSTEM
+        carry |= (uint32_t)s8[i - offset] << (8 * (3 - i));
+#else
+        carry |= (uint32_t)s8[i - offset] << (8 * i);
+#endif
+    }
+
+    switch(offset) {
+        case 1:
+            while(word_cnt >= 4) {
+                uint32_t w0 = s32[0];
+                uint32_t w1 = s32[1];
+                uint32_t w2 = s32[2];
+                uint32_t w3 = s32[3];
+                d32[0] = MERGE(carry, w0, 8);
+                d32[1] = MERGE(w0, w1, 8);
+                d32[2] = MERGE(w1, w2, 8);
+                d32[3] = MERGE(w2, w3, 8);
+                carry = w3;
+                d32 += 4;
+                s32 += 4;
+                word_cnt -= 4;
+            }
+            while(word_cnt) {
+                uint32_t w = *s32;
+                *d32 = MERGE(carry, w, 8);
+                carry = w;
+                d32++;
+                s32++;
+                word_cnt--;
+            }
+            break;
+        case 2:
+            while(word_cnt >= 4) {
+                uint32_t w0 = s32[0];
+                uint32_t w1 = s32[1];
+                uint32_t w2 = s32[2];
+                uint32_t w3 = s32[3];
+                d32[0] = MERGE(carry, w0, 16);
+                d32[1] = MERGE(w0, w1, 16);
+                d32[2] = MERGE(w1, w2, 16);
+                d32[3] = MERGE(w2, w3, 16);
+                carry = w3;
+                d32 += 4;
+                s32 += 4;
+                word_cnt -= 4;
+            }
+            while(word_cnt) {
+                uint32_t w = *s32;
+                *d32 = MERGE(carry, w, 16);
+                carry = w;
+                d32++;
+                s32++;
+                word_cnt--;
+            }
+            break;
+        default:
+            while(word_cnt >= 4) {
+                uint32_t w0 = s32[0];
+                uint32_t w1 = s32[1];
+                uint32_t w2 = s32[2];
+                uint32_t w3 = s32[3];
+                d32[0] = MERGE(carry, w0, 24);
+                d32[1] = MERGE(w0, w1, 24);
+                d32[2] = MERGE(w1, w2, 24);
+                d32[3] = MERGE(w2, w3, 24);
+                carry = w3;
+                d32 += 4;
+                s32 += 4;
+                word_cnt -= 4;
+            }
+            while(word_cnt) {
+                uint32_t w = *s32;
+                *d32 = MERGE(carry, w, 24);
+                carry = w;
+                d32++;
+                s32++;
+                word_cnt--;
+            }
+            break;
+    }
+}
+
+#endif /*LV_USE_STDLIB_STRING == LV_STDLIB_BUILTIN && LV_STRING_BUILTIN_ARMV7EM*/
@@ -17,6 +17,8 @@ extern "C" {
  *********************/
 
 #include "lv_tlsf.h"
+#include "../lv_mem.h"
+#include "lv_slab.h"
 
 /*********************
  *      DEFINES
@@ -26,6 +28,14 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_MEM_ROUTE_BY_SIZE
+typedef struct {
+    lv_pool_t pool;
+    uint8_t * start;
+    uint8_t * end;
+} lv_tlsf_large_pool_t;
+#endif
+
 typedef struct {
 #if LV_USE_OS
     lv_mutex_t mutex;
@@ -34,6 +44,19 @@ typedef struct {
     size_t cur_used;
     size_t max_used;
     lv_ll_t  pool_ll;
+#if LV_MEM_ROUTE_BY_SIZE
+    uint8_t * small_start;      /**< Range of the `LV_MEM_SIZE` pool to find the heap of most blocks quickly*/
+    uint8_t * small_end;
+    lv_tlsf_t large_tlsf;       /**< Heap of the large pools. NULL until the first one is added*/
+    lv_ll_t large_pool_ll;      /**< ::lv_tlsf_large_pool_t of the large pools*/
+    size_t heap_cur_used[LV_MEM_HEAP_CNT];
+    size_t heap_max_used[LV_MEM_HEAP_CNT];
+    uint32_t heap_fallback_cnt[LV_MEM_HEAP_CNT];
+    lv_mem_size_class_monitor_t size_classes[LV_MEM_SIZE_CLASS_CNT];
+#endif
+#if LV_USE_MEM_SLAB
+    lv_slab_t slab;
+#endif
 } lv_tlsf_state_t;
 
 /**********************
@@ -29,6 +29,55 @@ extern "C" {
 
 typedef void * lv_mem_pool_t;
 
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+#if LV_MEM_ROUTE_BY_SIZE
+/** Number of size classes in the statistics: up to 16, 32, 64 ... 16384 bytes and larger*/
+#define LV_MEM_SIZE_CLASS_CNT 12
+
+typedef enum {
+    LV_MEM_HEAP_SMALL,  /**< The `LV_MEM_SIZE` pool and the pools added with `lv_mem_add_pool()`*/
+    LV_MEM_HEAP_LARGE,  /**< The pools added with `lv_mem_add_large_pool()`*/
+    LV_MEM_HEAP_CNT,
+} lv_mem_heap_t;
+
+/**
+ * Information about a heap of the size routed allocator.
+ */
+typedef struct {
+    size_t total_size;
+    size_t free_size;
+    size_t free_biggest_size;
+    size_t cur_used;
+    size_t max_used;
+    uint32_t fallback_cnt;  /**< Allocations served from this heap because the other heap was full*/
+} lv_mem_heap_monitor_t;
+
+/**
+ * Allocation statistics of a size class of the size routed allocator.
+ */
+typedef struct {
+    uint32_t used_cnt;      /**< Number of allocated blocks*/
+    uint32_t alloc_cnt;     /**< Number of allocations since `lv_mem_init()`*/
+} lv_mem_size_class_monitor_t;
+#endif
+
+#if LV_USE_MEM_SLAB
+/** Max number of slab classes in `LV_MEM_SLAB_BLOCK_SIZES`*/
+#define LV_MEM_SLAB_CLASS_MAX 16
+
+/**
+ * Statistics of a slab class.
+ */
+typedef struct {
+    uint32_t block_size;
+    uint32_t page_cnt;      /**< Number of pages used by the class*/
+    uint32_t used_cnt;      /**< Number of allocated blocks*/
+    uint32_t alloc_cnt;     /**< Number of allocations since `lv_mem_init()`*/
+    uint32_t full_cnt;      /**< Allocations served by the heap because there was no free page*/
+} lv_mem_slab_monitor_t;
+#endif
+#endif
+
 /**
  * Heap information structure.
  */
@@ -41,6 +90,17 @@ typedef struct {
     size_t max_used;    /**< Max size of Heap memory used */
     uint8_t used_pct;   /**< Percentage used */
     uint8_t frag_pct;   /**< Amount of fragmentation */
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+#if LV_MEM_ROUTE_BY_SIZE
+    lv_mem_heap_monitor_t heaps[LV_MEM_HEAP_CNT];
+    lv_mem_size_class_monitor_t size_classes[LV_MEM_SIZE_CLASS_CNT];  /**< Classes by the size of the blocks*/
+#endif
+#if LV_USE_MEM_SLAB
+    lv_mem_slab_monitor_t slabs[LV_MEM_SLAB_CLASS_MAX];
+    uint32_t slab_class_cnt;
+    uint32_t slab_free_page_cnt;
+#endif
+#endif
 } lv_mem_monitor_t;
 
 /**********************
@@ -61,6 +121,19 @@ lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes);
 
 void lv_mem_remove_pool(lv_mem_pool_t pool);
 
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+#if LV_MEM_ROUTE_BY_SIZE
+/**
+ * Add a memory pool for the blocks larger than `LV_MEM_ROUTE_SMALL_MAX`, e.g. in external SDRAM.
+ * Remove it with `lv_mem_remove_pool()`.
+ * @param mem       start address of the pool
+ * @param bytes     size of the pool, at most `LV_MEM_SIZE + LV_MEM_POOL_EXPAND_SIZE`
+ * @return          the added pool or NULL on error
+ */
+lv_mem_pool_t lv_mem_add_large_pool(void * mem, size_t bytes);
+#endif
+#endif
+
 /**
  * Allocate memory dynamically
  * @param size requested size in bytes
@@ -4,6 +4,9 @@
 #include "stm32746g_discovery_ts.h"
 
 static SemaphoreHandle_t lvglMutex;
+static TaskHandle_t lvglTaskHandle = NULL;
+static lv_indev_t *touchIndev = NULL;
+static volatile bool touchSignale = false; // Interruption de la dalle tactile à traiter
 
 bool lvglLock(TickType_t xBlockTime)
 {
@@ -23,12 +26,46 @@ bool lvglUnlock()
     return false;
 }
 
+// Réveil de lvglTask : un timer LVGL a été créé ou relancé (invalidation d'une
+// zone, démarrage d'une animation, appui en cours...) par une autre tâche
+static void lvglResume_cb(void *data)
+{
+    LV_UNUSED(data);
+    // Inutile de se réveiller soi-même : lv_timer_handler recalcule l'échéance
+    if (lvglTaskHandle == NULL || xTaskGetCurrentTaskHandle() == lvglTaskHandle) return;
+    xTaskNotifyGive(lvglTaskHandle);
+}
+
+// Interruption de la dalle tactile (FT5336) : réveil immédiat de lvglTask
+static void touch_isr()
+{
+    touchSignale = true;
+    if (lvglTaskHandle == NULL) return;
+    BaseType_t reveil = pdFALSE;
+    vTaskNotifyGiveFromISR(lvglTaskHandle, &reveil);
+    portYIELD_FROM_ISR(reveil);
+}
+
 static void lvglTask(void *pvParameters)
 {
     while (1)
     {
+        if (touchSignale)
+        {
+            // Lecture de l'appui ; LVGL relit ensuite la dalle tant qu'elle est pressée
+            touchSignale = false;
+            lv_lock();
+            lv_indev_read(touchIndev);
+            lv_unlock();
+        }
+
         uint32_t time_till_next = lv_timer_handler();
-        vTaskDelay(pdMS_TO_TICKS(time_till_next));
+
+        // Aucun timer actif (ni animation, ni zone invalidée, ni appui) : attente
+        // sans limite. Le tick reste actif : la SysTick de STM32duino fait aussi
+        // avancer HAL_GetTick (millis, délais du HAL)
+        TickType_t attente = (time_till_next == LV_NO_TIMER_READY) ? portMAX_DELAY : pdMS_TO_TICKS(time_till_next);
+        ulTaskNotifyTake(pdTRUE, attente);
     }
 }
 
@@ -83,6 +120,18 @@ void setup()
 
     lv_init();
 
+#if LV_MEM_ROUTE_BY_SIZE
+    // Les gros blocs (tampons de dessin, calques, images) vont en SDRAM, après la trame de l'écran ;
+    // les petits (objets, styles, événements) restent dans le tas LV_MEM_SIZE en SRAM interne
+    lv_mem_add_large_pool((void *)(LCD_FB_START_ADDRESS + 480 * 272 * 4), LV_MEM_POOL_EXPAND_SIZE);
+#if LV_CACHE_DEF_SIZE && LV_IMAGE_CACHE_ADR
+    // Les images décodées ont leur propre zone à la fin de la SDRAM, elle ne doit pas chevaucher le tas
+    static_assert(LCD_FB_START_ADDRESS + 480 * 272 * 4 + LV_MEM_POOL_EXPAND_SIZE <= LV_IMAGE_CACHE_ADR &&
+                  LV_IMAGE_CACHE_ADR + LV_CACHE_DEF_SIZE <= SDRAM_DEVICE_ADDR + SDRAM_DEVICE_SIZE,
+                  "La zone du cache d'images chevauche le tas LVGL ou dépasse la SDRAM");
+#endif
+#endif
+
     lv_log_register_print_cb([](lv_log_level_t level, const char *buf) {
         Serial.printf("%s", buf);
     });
@@ -95,15 +144,24 @@ void setup()
 
     lv_display_set_buffers(display, buf, NULL, sizeof(buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
 
-    lv_indev_t *indev = lv_indev_create();
-    lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
-    lv_indev_set_read_cb(indev, my_read_cb);
+    // Dalle lue sur interruption plutôt que scrutée à chaque période de rafraîchissement
+    touchIndev = lv_indev_create();
+    lv_indev_set_type(touchIndev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(touchIndev, my_read_cb);
+    lv_indev_set_mode(touchIndev, LV_INDEV_MODE_EVENT);
+    // Une seule configuration de l'EXTI de PI13 (TS_INT_PIN), celle de STM32duino qui possède
+    // EXTI15_10_IRQHandler ; BSP_TS_ITConfig la refaisait avec le HAL. Le FT5336 est seulement
+    // passé en mode interruption
+    ft5336_ts_drv.EnableIT(TS_I2C_ADDRESS);
+    attachInterrupt(digitalPinToInterrupt(pinNametoDigitalPin(PI_13)), touch_isr, RISING);
+
+    lv_timer_handler_set_resume_cb(lvglResume_cb, NULL);
 
     lv_tick_set_cb(xTaskGetTickCount);
 
     mySetup();
 
-    xTaskCreate(lvglTask, NULL, 16384, NULL, osPriorityNormal, NULL);
+    xTaskCreate(lvglTask, NULL, 16384, NULL, osPriorityNormal, &lvglTaskHandle);
     xTaskCreate(myTask, NULL, 16384, NULL, osPriorityNormal, NULL);
 
     vTaskStartScheduler();
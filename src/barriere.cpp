@@ -0,0 +1,227 @@
+#include "barriere.h"
+#include "src/lvgl_private.h"            // Accès à lv_obj_t et lv_obj_class_t (API privée LVGL)
+
+#define MY_CLASS (&barriere_class)
+
+// Données d'instance du widget barrière
+typedef struct {
+    lv_obj_t obj;                        // Doit rester en premier (héritage lv_obj)
+    lv_draw_buf_t *rendu;                // Bras pré-rendu (nullptr = à régénérer)
+    int32_t angle;                       // Angle en dixièmes de degré
+    lv_point_t pivot;                    // Pivot relatif au bras
+    bool antialias;                      // Interpolation bilinéaire (sinon plus proche voisin)
+    uint8_t nbRayures;                   // Nombre de rayures
+    lv_color_t couleurA;                 // Couleur des rayures paires
+    lv_color_t couleurB;                 // Couleur des rayures impaires
+} barriere_t;
+
+static void barriere_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void barriere_destructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void barriere_event(const lv_obj_class_t *class_p, lv_event_t *e);
+
+const lv_obj_class_t barriere_class = {
+    .base_class = &lv_obj_class,
+    .constructor_cb = barriere_constructor,
+    .destructor_cb = barriere_destructor,
+    .event_cb = barriere_event,
+    .user_data = nullptr,
+    .name = "barriere",
+    .width_def = 12,
+    .height_def = 120,
+    .editable = LV_OBJ_CLASS_EDITABLE_INHERIT,
+    .group_def = LV_OBJ_CLASS_GROUP_DEF_INHERIT,
+    .instance_size = sizeof(barriere_t),
+    .theme_inheritable = LV_OBJ_CLASS_THEME_INHERITABLE_FALSE,
+};
+
+// Zone (absolue) couverte par le bras tourné à l'angle courant
+static void getZoneTournee(lv_obj_t *obj, lv_area_t *zone)
+{
+    barriere_t *b = (barriere_t *)obj;
+    lv_image_buf_get_transformed_area(zone, lv_obj_get_width(obj), lv_obj_get_height(obj), b->angle,
+                                      LV_SCALE_NONE, LV_SCALE_NONE, &b->pivot);
+    lv_area_move(zone, obj->coords.x1, obj->coords.y1);
+}
+
+// Libère le rendu mis en cache, il sera régénéré au prochain dessin
+static void invaliderRendu(barriere_t *b)
+{
+    if (b->rendu == nullptr) return;
+    lv_image_cache_drop(b->rendu);
+    lv_draw_buf_destroy(b->rendu);
+    b->rendu = nullptr;
+}
+
+// Dessine une seule fois les rayures dans un buffer ARGB8888
+static void genererRendu(lv_obj_t *obj)
+{
+    barriere_t *b = (barriere_t *)obj;
+    int32_t w = lv_obj_get_width(obj);
+    int32_t h = lv_obj_get_height(obj);
+    if (w <= 0 || h <= 0 || b->nbRayures == 0) return;
+
+    b->rendu = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    if (b->rendu == nullptr) return;
+
+    lv_color32_t a = lv_color_to_32(b->couleurA, LV_OPA_COVER);
+    lv_color32_t c = lv_color_to_32(b->couleurB, LV_OPA_COVER);
+    for (int32_t y = 0; y < h; y++) {
+        lv_color32_t coul = ((y * b->nbRayures / h) % 2 == 0) ? a : c;
+        lv_color32_t *px = (lv_color32_t *)lv_draw_buf_goto_xy(b->rendu, 0, y);
+        for (int32_t x = 0; x < w; x++) px[x] = coul;
+    }
+}
+
+// Crée le widget barrière
+lv_obj_t *barriere_create(lv_obj_t *parent)
+{
+    LV_LOG_INFO("begin");
+    lv_obj_t *obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+void barriere_set_angle(lv_obj_t *obj, int32_t angle)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    barriere_t *b = (barriere_t *)obj;
+    if (angle == b->angle) return;
+
+    // Invalide uniquement l'ancienne et la nouvelle zone du bras.
+    // Pas de mise à jour du layout ici : seul l'angle change à chaque image de l'animation,
+    // et si la taille ou la position change, LVGL invalide déjà tout le widget.
+    lv_area_t zone;
+    getZoneTournee(obj, &zone);
+    lv_obj_invalidate_area(obj, &zone);
+
+    b->angle = angle;
+
+    getZoneTournee(obj, &zone);
+    lv_obj_invalidate_area(obj, &zone);
+}
+
+int32_t barriere_get_angle(const lv_obj_t *obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    return ((const barriere_t *)obj)->angle;
+}
+
+void barriere_set_pivot(lv_obj_t *obj, int32_t x, int32_t y)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    barriere_t *b = (barriere_t *)obj;
+    if (b->pivot.x == x && b->pivot.y == y) return;
+
+    lv_obj_invalidate(obj);
+    b->pivot.x = x;
+    b->pivot.y = y;
+    lv_obj_refresh_ext_draw_size(obj);
+    lv_obj_invalidate(obj);
+}
+
+void barriere_get_pivot(const lv_obj_t *obj, lv_point_t *pivot)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    *pivot = ((const barriere_t *)obj)->pivot;
+}
+
+void barriere_set_antialias(lv_obj_t *obj, bool antialias)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    barriere_t *b = (barriere_t *)obj;
+    if (b->antialias == antialias) return;
+
+    b->antialias = antialias;
+    lv_obj_invalidate(obj);
+}
+
+bool barriere_get_antialias(const lv_obj_t *obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    return ((const barriere_t *)obj)->antialias;
+}
+
+void barriere_set_rayures(lv_obj_t *obj, uint8_t nb, lv_color_t couleurA, lv_color_t couleurB)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    barriere_t *b = (barriere_t *)obj;
+    b->nbRayures = nb;
+    b->couleurA = couleurA;
+    b->couleurB = couleurB;
+    invaliderRendu(b);
+    lv_obj_invalidate(obj);
+}
+
+static void barriere_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj)
+{
+    LV_UNUSED(class_p);
+    barriere_t *b = (barriere_t *)obj;
+    b->rendu = nullptr;
+    b->angle = 0;
+    b->pivot.x = barriere_class.width_def / 2;
+    b->pivot.y = barriere_class.height_def;
+    b->antialias = true;
+    b->nbRayures = 8;
+    b->couleurA = lv_palette_main(LV_PALETTE_RED);
+    b->couleurB = lv_color_white();
+
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+}
+
+static void barriere_destructor(const lv_obj_class_t *class_p, lv_obj_t *obj)
+{
+    LV_UNUSED(class_p);
+    invaliderRendu((barriere_t *)obj);
+}
+
+static void barriere_event(const lv_obj_class_t *class_p, lv_event_t *e)
+{
+    LV_UNUSED(class_p);
+
+    // Le dessin de lv_obj (fond, bordure) est inutile : tout est dans le rendu
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code != LV_EVENT_DRAW_MAIN && code != LV_EVENT_DRAW_MAIN_END && code != LV_EVENT_DRAW_POST &&
+        code != LV_EVENT_DRAW_POST_END) {
+        lv_result_t res = lv_obj_event_base(MY_CLASS, e);
+        if (res != LV_RESULT_OK) return;
+    }
+
+    lv_obj_t *obj = (lv_obj_t *)lv_event_get_current_target(e);
+    barriere_t *b = (barriere_t *)obj;
+
+    if (code == LV_EVENT_SIZE_CHANGED) {
+        invaliderRendu(b);
+        lv_obj_refresh_ext_draw_size(obj);
+    }
+    else if (code == LV_EVENT_REFR_EXT_DRAW_SIZE) {
+        // Place pour le bras quel que soit l'angle : distance max pivot-coin
+        int32_t *s = (int32_t *)lv_event_get_param(e);
+        int32_t w = lv_obj_get_width(obj);
+        int32_t h = lv_obj_get_height(obj);
+        int32_t dx = LV_MAX(b->pivot.x, w - b->pivot.x);
+        int32_t dy = LV_MAX(b->pivot.y, h - b->pivot.y);
+        int32_t r = lv_sqrt32(dx * dx + dy * dy) + 1;
+        *s = LV_MAX(*s, r - b->pivot.x);
+        *s = LV_MAX(*s, r - (w - b->pivot.x));
+        *s = LV_MAX(*s, r - b->pivot.y);
+        *s = LV_MAX(*s, r - (h - b->pivot.y));
+    }
+    else if (code == LV_EVENT_COVER_CHECK) {
+        lv_event_set_cover_res(e, LV_COVER_RES_NOT_COVER);
+    }
+    else if (code == LV_EVENT_DRAW_MAIN) {
+        if (b->rendu == nullptr) genererRendu(obj);
+        if (b->rendu == nullptr) return;
+
+        lv_draw_image_dsc_t dsc;
+        lv_draw_image_dsc_init(&dsc);
+        dsc.src = b->rendu;
+        dsc.rotation = b->angle;
+        dsc.pivot = b->pivot;
+        dsc.antialias = b->antialias;
+        dsc.opa = lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN);
+        dsc.image_area = obj->coords;
+        lv_draw_image(lv_event_get_layer(e), &dsc, &obj->coords);
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef BARRIERE_H
+#define BARRIERE_H
+
+#include "lvgl.h"
+
+// Widget "barrière" : le bras rayé est pré-rendu une seule fois dans un
+// lv_draw_buf puis dessiné par une unique tâche image tournée à chaque frame
+// (pas d'objets enfants, pas de layer de transformation intermédiaire).
+
+lv_obj_t *barriere_create(lv_obj_t *parent);
+
+// Angle du bras en dixièmes de degré (0 = ouvert, 900 = fermé)
+void barriere_set_angle(lv_obj_t *obj, int32_t angle);
+int32_t barriere_get_angle(const lv_obj_t *obj);
+
+// Pivot de rotation, relatif au coin haut-gauche du bras
+void barriere_set_pivot(lv_obj_t *obj, int32_t x, int32_t y);
+void barriere_get_pivot(const lv_obj_t *obj, lv_point_t *pivot);
+
+// Anticrénelage du bras tourné (activé par défaut). Désactivé, chaque pixel
+// prend le plus proche du rendu : moins joli sur les bords mais plus rapide.
+void barriere_set_antialias(lv_obj_t *obj, bool antialias);
+bool barriere_get_antialias(const lv_obj_t *obj);
+
+// Nombre et couleurs des rayures (invalide le rendu mis en cache)
+void barriere_set_rayures(lv_obj_t *obj, uint8_t nb, lv_color_t couleurA, lv_color_t couleurB);
+
+#endif // BARRIERE_H
@@ -0,0 +1,89 @@
+#include "ecrans.h"
+
+// Description d'un écran géré
+typedef struct {
+    const char *nom;                     // Nom pour les traces
+    ecran_construire_cb_t construire;    // Fonction de construction (nullptr si déjà construit)
+    lv_obj_t *ecran;                     // Objet écran (nullptr tant que non construit)
+    uint32_t dureeConstruction;          // Durée de construction [ms]
+    bool dejaAffiche;                    // Premier affichage déjà mesuré
+} ecran_t;
+
+static ecran_t ecrans[ECRAN_NB];
+static ecran_id_t ecranActif = ECRAN_BARRIERE;
+static int ecranMesure = -1;             // Écran dont on attend le premier rendu
+static uint32_t debutAffichage = 0;      // Tick de la demande d'affichage
+
+// Fin de rafraîchissement : mesure de la latence du premier affichage
+static void refrReady_event_cb(lv_event_t *e)
+{
+    LV_UNUSED(e);
+    if (ecranMesure < 0) return;
+
+    ecran_t *ec = &ecrans[ecranMesure];
+    LV_LOG_USER("Ecran %s : construit en %" LV_PRIu32 " ms, premier affichage en %" LV_PRIu32 " ms",
+                ec->nom, ec->dureeConstruction, lv_tick_elaps(debutAffichage));
+    ec->dejaAffiche = true;
+    ecranMesure = -1;
+}
+
+void ecrans_ajouter(ecran_id_t id, const char *nom, ecran_construire_cb_t construire)
+{
+    ecrans[id].nom = nom;
+    ecrans[id].construire = construire;
+    ecrans[id].ecran = nullptr;
+    ecrans[id].dureeConstruction = 0;
+    ecrans[id].dejaAffiche = false;
+}
+
+void ecrans_ajouter_actif(ecran_id_t id, const char *nom)
+{
+    ecrans_ajouter(id, nom, nullptr);
+    ecrans[id].ecran = lv_screen_active();
+    ecrans[id].dejaAffiche = true;
+    ecranActif = id;
+}
+
+void ecrans_construire()
+{
+    for (int i = 0; i < ECRAN_NB; i++) {
+        ecran_t *ec = &ecrans[i];
+        if (ec->ecran != nullptr || ec->construire == nullptr) continue;
+
+        uint32_t t0 = lv_tick_get();
+        ec->ecran = lv_obj_create(nullptr);
+        ec->construire(ec->ecran);
+        lv_obj_update_layout(ec->ecran); // Layout calculé dès maintenant, pas au premier affichage
+        ec->dureeConstruction = lv_tick_elaps(t0);
+    }
+
+    lv_display_add_event_cb(lv_display_get_default(), refrReady_event_cb, LV_EVENT_REFR_READY, nullptr);
+}
+
+void ecrans_afficher(ecran_id_t id)
+{
+    ecran_t *ec = &ecrans[id];
+    if (ec->ecran == nullptr) {
+        LV_LOG_WARN("Ecran %s non construit", ec->nom);
+        return;
+    }
+    if (id == ecranActif) return;
+
+    if (!ec->dejaAffiche) {
+        ecranMesure = id;
+        debutAffichage = lv_tick_get();
+    }
+
+    lv_screen_load(ec->ecran);
+    ecranActif = id;
+}
+
+lv_obj_t *ecrans_get(ecran_id_t id)
+{
+    return ecrans[id].ecran;
+}
+
+ecran_id_t ecrans_get_actif()
+{
+    return ecranActif;
+}
@@ -0,0 +1,34 @@
+#ifndef ECRANS_H
+#define ECRANS_H
+
+#include "lvgl.h"
+
+// Gestionnaire d'écrans : tous les écrans sont construits une seule fois au
+// démarrage puis gardés en mémoire ; passer de l'un à l'autre ne fait qu'un
+// lv_screen_load (O(1)), sans construction de widgets sur le chemin critique.
+
+typedef enum {
+    ECRAN_BARRIERE = 0,                  // Écran principal (barrière + labels)
+    ECRAN_LOGIN,                         // Saisie du mot de passe
+    ECRAN_CHANGE_PWD,                    // Changement de mot de passe
+    ECRAN_NB
+} ecran_id_t;
+
+typedef void (*ecran_construire_cb_t)(lv_obj_t *ecran);
+
+// Déclare un écran et sa fonction de construction (appelée par ecrans_construire)
+void ecrans_ajouter(ecran_id_t id, const char *nom, ecran_construire_cb_t construire);
+
+// Déclare l'écran déjà actif (construit hors du gestionnaire)
+void ecrans_ajouter_actif(ecran_id_t id, const char *nom);
+
+// Construit tous les écrans déclarés (au démarrage, sous lv_lock si tâche LVGL active)
+void ecrans_construire();
+
+// Affiche un écran déjà construit ; la latence du premier affichage est journalisée
+void ecrans_afficher(ecran_id_t id);
+
+lv_obj_t *ecrans_get(ecran_id_t id);
+ecran_id_t ecrans_get_actif();
+
+#endif // ECRANS_H
@@ -1,5 +1,9 @@
 #include "lvgl.h"                        // Inclusion de la bibliothèque LVGL pour l'interface graphique
 #include "lvglDrivers.h"                 // Inclusion des drivers LVGL spécifiques au matériel
+#include "barriere.h"                    // Widget du bras de barrière (rendu mis en cache)
+#include "ecrans.h"                      // Gestionnaire d'écrans pré-construits
+#include "pinpad.h"                      // Pavé numérique léger
+#include "styles.h"                      // Feuille de styles constants partagés
 #include <HardwareTimer.h>               // Timer matériel pour la gestion PWM
 #include "timer.h"                       // Fichier d'en-tête pour la gestion du timer
 
@@ -10,13 +14,15 @@ lv_obj_t *barriereObj = nullptr;         // Objet visuel du bras de la barrière
 lv_obj_t *barriereContainer = nullptr;   // Conteneur principal de la barrière (bras + socle)
 lv_obj_t *loginWindow = nullptr;         // Fenêtre de connexion
 lv_obj_t *pwdTextarea = nullptr;         // Champ de saisie du mot de passe
-static lv_obj_t *keyboard = nullptr;     // Clavier virtuel global
+static lv_obj_t *keyboard = nullptr;     // Pavé numérique global
 lv_obj_t *changePwdWindow = nullptr;     // Fenêtre de changement de mot de passe
 static lv_obj_t *oldPwdTA = nullptr;     // Champ ancien mot de passe
 static lv_obj_t *newPwdTA = nullptr;     // Champ nouveau mot de passe
 lv_obj_t *btnChangePwd = nullptr;        // Bouton pour changer le mot de passe
 
-static String currentPassword = "aa";    // Mot de passe par défaut
+// Mot de passe par défaut. L'ancien "aa" ne peut pas être saisi au pavé numérique (chiffres seulement) :
+// il est remplacé par "1234". Il n'est pas enregistré, il revient à chaque démarrage.
+static String currentPassword = "1234";
 volatile bool connexionAcpt = false;     // Flag d'acceptation de la connexion
 int voitureCount = 0;                    // Compteur de voitures dans le parking
 
@@ -41,102 +47,76 @@ void animerBarriere(int angleCible)
 {
     if (barriereObj == nullptr) return; // Sécurité
 
+    lv_lock(); // Appelée depuis myTask : lvglTask exécute les animations en parallèle
     lv_anim_t a;
     lv_anim_init(&a); // Initialisation de l'animation
     lv_anim_set_var(&a, barriereObj); // Cible : bras de la barrière
     lv_anim_set_values(&a,
-                       lv_obj_get_style_transform_angle(barriereObj, 0), // Angle actuel
-                       angleCible * 10);                                // Angle cible (dixième de degré)
+                       barriere_get_angle(barriereObj), // Angle actuel
+                       angleCible * 10);                // Angle cible (dixième de degré)
     lv_anim_set_time(&a, 500); // Durée de l'animation en ms
     lv_anim_set_exec_cb(&a, [](void *obj, int32_t v) {
-        lv_obj_set_style_transform_angle(static_cast<lv_obj_t*>(obj), v, 0); // Applique l'angle
+        barriere_set_angle(static_cast<lv_obj_t*>(obj), v); // Applique l'angle
     });
     lv_anim_start(&a); // Démarre l'animation
+    lv_unlock();
 }
 
-// Callback pour la gestion du clavier virtuel sur les textareas
+// Callback pour la gestion du pavé numérique sur les textareas
 static void ta_event_cb(lv_event_t * e)
 {
     lv_event_code_t code = lv_event_get_code(e); // Type d'événement LVGL
     lv_obj_t * ta = (lv_obj_t *)lv_event_get_target(e); // Objet cible (textarea)
-    lv_obj_t * kb = (lv_obj_t *)lv_event_get_user_data(e); // Clavier associé
+    lv_obj_t * kb = (lv_obj_t *)lv_event_get_user_data(e); // Pavé associé
 
     if(code == LV_EVENT_FOCUSED) {
-        lv_keyboard_set_textarea(kb, ta); // Associe le clavier à la textarea
-        lv_obj_clear_flag(kb, LV_OBJ_FLAG_HIDDEN); // Affiche le clavier
-        lv_obj_move_foreground(kb); // Met le clavier au premier plan
+        pinpad_set_textarea(kb, ta); // Associe le pavé à la textarea
+        lv_obj_clear_flag(kb, LV_OBJ_FLAG_HIDDEN); // Affiche le pavé
+        lv_obj_move_foreground(kb); // Met le pavé au premier plan
     }
 
-    if(code == LV_EVENT_DEFOCUSED) {
-        lv_keyboard_set_textarea(kb, NULL); // Détache le clavier
-        lv_obj_add_flag(kb, LV_OBJ_FLAG_HIDDEN); // Cache le clavier
+    if(code == LV_EVENT_DEFOCUSED || code == LV_EVENT_READY) {
+        pinpad_set_textarea(kb, NULL); // Détache le pavé
+        lv_obj_add_flag(kb, LV_OBJ_FLAG_HIDDEN); // Cache le pavé (touche OK ou perte de focus)
     }
 }
 
 // Création de la barrière visuelle (socle + bras + rayures)
 void testLvgl()
 {
-    // Taille du conteneur principal
-    int largeur = 200;
-    int hauteur = 180;
-
-    // Création du conteneur centré
+    // Création du conteneur centré (200x180, décalé sous l'heure)
     barriereContainer = lv_obj_create(lv_scr_act());
-    lv_obj_set_size(barriereContainer, largeur, hauteur);
-    lv_obj_align(barriereContainer, LV_ALIGN_CENTER, 0, 20); // Décalé vers le bas pour ne pas chevaucher l'heure
+    lv_obj_add_style(barriereContainer, &style_conteneur, 0);
     lv_obj_clear_flag(barriereContainer, LV_OBJ_FLAG_SCROLLABLE); // Pas de scroll
 
     // Création du socle (base de la barrière)
     lv_obj_t *socle = lv_obj_create(barriereContainer);
-    lv_obj_set_size(socle, 40, 40);
-    lv_obj_align(socle, LV_ALIGN_BOTTOM_LEFT, 0, 0);
-    lv_obj_set_style_bg_color(socle, lv_palette_main(LV_PALETTE_GREY), 0);
-    lv_obj_set_style_radius(socle, 8, 0);
-
-    // Création du bras mobile (parent des rayures)
-    barriereObj = lv_obj_create(barriereContainer);
-    lv_obj_set_size(barriereObj, 12, 120);
+    lv_obj_add_style(socle, &style_socle, 0);
+
+    // Création du bras mobile (rayures pré-rendues dans le widget)
+    barriereObj = barriere_create(barriereContainer); // 12x120 par défaut
     lv_obj_align_to(barriereObj, socle, LV_ALIGN_OUT_TOP_MID, 0, 0);
-    lv_obj_set_style_bg_color(barriereObj, lv_color_white(), 0); // Fond blanc
-    lv_obj_set_style_radius(barriereObj, 4, 0);
-    lv_obj_set_style_pad_all(barriereObj, 0, 0);
+    barriere_set_rayures(barriereObj, 8, lv_palette_main(LV_PALETTE_RED), lv_color_white()); // Rayures rouges et blanches
 
     // Définition du pivot de rotation à la base du bras
-    lv_obj_set_style_transform_pivot_x(barriereObj, 6, 0); // Centre en largeur
-    lv_obj_set_style_transform_pivot_y(barriereObj, 120, 0); // Base du bras
-
-    lv_obj_set_style_transform_angle(barriereObj, 900, 0); // Barrière fermée (90°)
-
-    // Ajout des rayures rouges et blanches sur le bras
-    int nb_rayures = 8;
-    int hauteur_r = 120 / nb_rayures;
-    for (int i = 0; i < nb_rayures; ++i) {
-        lv_obj_t *rayure = lv_obj_create(barriereObj);
-        lv_obj_set_size(rayure, 12, hauteur_r);
-        lv_obj_align(rayure, LV_ALIGN_TOP_MID, 0, i * hauteur_r);
-        if (i % 2 == 0)
-            lv_obj_set_style_bg_color(rayure, lv_palette_main(LV_PALETTE_RED), 0); // Rouge
-        else
-            lv_obj_set_style_bg_color(rayure, lv_color_white(), 0); // Blanc
-        lv_obj_set_style_border_width(rayure, 0, 0);
-        lv_obj_set_style_radius(rayure, 0, 0);
-        lv_obj_set_style_pad_all(rayure, 0, 0);
-    }
+    barriere_set_pivot(barriereObj, 6, 120); // Centre en largeur, base du bras
+
+    barriere_set_angle(barriereObj, 900); // Barrière fermée (90°)
 
     // Création du label compteur de voitures (en haut à droite)
     voitureLabel = lv_label_create(lv_scr_act());
     lv_label_set_text_fmt(voitureLabel, "Voitures: %d", voitureCount);
-    lv_obj_align(voitureLabel, LV_ALIGN_TOP_RIGHT, -10, 10);
+    lv_obj_add_style(voitureLabel, &style_label_voitures, 0);
 
     // Création du label heure simulée (en haut à gauche)
     heureLabel = lv_label_create(lv_scr_act());
     lv_label_set_text(heureLabel, "00:00:00");
-    lv_obj_align(heureLabel, LV_ALIGN_TOP_LEFT, 10, 10);
+    lv_obj_add_style(heureLabel, &style_label_heure, 0);
 
     // Création du label d'état de la barrière (en bas au centre)
     etatLabel = lv_label_create(lv_scr_act());
     lv_label_set_text(etatLabel, "");
-    lv_obj_align(etatLabel, LV_ALIGN_BOTTOM_MID, 0, -10);
+    lv_obj_add_style(etatLabel, &style_label_etat, 0);
 
     // Création du label horaire automatique sous l'heure simulée
     horaireLabel = lv_label_create(lv_scr_act());
@@ -150,10 +130,10 @@ static void btnOk_event_handler(lv_event_t * e)
     if (!pwdTextarea) return; // Sécurité
     const char *txt = lv_textarea_get_text(pwdTextarea); // Récupère le texte saisi
 
-    // Ferme le clavier si ouvert
+    // Ferme le pavé si ouvert
     if (keyboard) {
         lv_obj_add_flag(keyboard, LV_OBJ_FLAG_HIDDEN);
-        lv_keyboard_set_textarea(keyboard, NULL);
+        pinpad_set_textarea(keyboard, NULL);
     }
 
     // Vérifie le mot de passe
@@ -170,32 +150,44 @@ static void btnOk_event_handler(lv_event_t * e)
     }
 }
 
-// Création de la fenêtre de changement de mot de passe
-void createChangePwdWindow()
+// Cache le pavé numérique et le détache de sa textarea
+static void cacherClavier()
 {
-    if (changePwdWindow) return; // Si déjà ouverte, ne rien faire
+    if (keyboard) {
+        lv_obj_add_flag(keyboard, LV_OBJ_FLAG_HIDDEN);
+        pinpad_set_textarea(keyboard, NULL);
+    }
+}
 
-    // Fenêtre plein écran
-    changePwdWindow = lv_win_create(lv_scr_act());
-    lv_obj_set_size(changePwdWindow, 480, 272);
-    lv_obj_align(changePwdWindow, LV_ALIGN_CENTER, 0, 0);
+// Création du pavé numérique, partagé par tous les écrans (couche supérieure)
+static void createKeyboard()
+{
+    if (keyboard != nullptr) return;
+    keyboard = pinpad_create(lv_layer_top());
+    lv_obj_add_flag(keyboard, LV_OBJ_FLAG_HIDDEN); // Cacher par défaut
+    lv_obj_add_style(keyboard, &style_pinpad, 0); // 480x120, aligné en bas
+}
+
+// Construction de l'écran de changement de mot de passe (une seule fois, au démarrage)
+static void createChangePwdWindow(lv_obj_t *ecran)
+{
+    // Fenêtre plein écran (lv_win prend la taille de l'écran)
+    changePwdWindow = lv_win_create(ecran);
 
     // Titre dans l'en-tête
     lv_obj_t *title = lv_label_create(lv_win_get_header(changePwdWindow));
     lv_label_set_text(title, "Changer mot de passe");
-    lv_obj_center(title);
+    lv_obj_add_style(title, &style_centre, 0);
 
     // Champ ancien mot de passe
     oldPwdTA = lv_textarea_create(changePwdWindow);
-    lv_obj_set_size(oldPwdTA, 380, 50);
-    lv_obj_align(oldPwdTA, LV_ALIGN_TOP_MID, 0, 30);
+    lv_obj_add_style(oldPwdTA, &style_champ_mdp, 0);
     lv_textarea_set_password_mode(oldPwdTA, true);
     lv_textarea_set_placeholder_text(oldPwdTA, "Ancien mot de passe");
 
     // Champ nouveau mot de passe
     newPwdTA = lv_textarea_create(changePwdWindow);
-    lv_obj_set_size(newPwdTA, 380, 50);
-    lv_obj_align(newPwdTA, LV_ALIGN_TOP_MID, 0, 100);
+    lv_obj_add_style(newPwdTA, &style_champ_mdp_2, 0);
     lv_textarea_set_password_mode(newPwdTA, true);
     lv_textarea_set_placeholder_text(newPwdTA, "Nouveau mot de passe");
 
@@ -205,11 +197,10 @@ void createChangePwdWindow()
 
     // Bouton valider
     lv_obj_t *btnSave = lv_btn_create(changePwdWindow);
-    lv_obj_set_size(btnSave, 150, 50);
-    lv_obj_align(btnSave, LV_ALIGN_BOTTOM_MID, 0, -10);
+    lv_obj_add_style(btnSave, &style_bouton, 0);
     lv_obj_t *labelSave = lv_label_create(btnSave);
     lv_label_set_text(labelSave, "Valider");
-    lv_obj_center(labelSave);
+    lv_obj_add_style(labelSave, &style_centre, 0);
 
     // Callback du bouton valider
     lv_obj_add_event_cb(btnSave, [](lv_event_t *e) {
@@ -220,81 +211,83 @@ void createChangePwdWindow()
         if (strcmp(oldPwd, currentPassword.c_str()) == 0 && strlen(newPwd) > 0) {
             currentPassword = String(newPwd); // Met à jour le mot de passe
             Serial.println("Mot de passe modifie avec succès");
-            lv_obj_del(changePwdWindow); // Ferme la fenêtre
-            changePwdWindow = nullptr;
-            lv_obj_clear_flag(btnChangePwd, LV_OBJ_FLAG_HIDDEN); // Réaffiche le bouton de changement
+            cacherClavier();
+            ecrans_afficher(ECRAN_LOGIN); // Retour à l'écran de connexion
         } else {
             Serial.println("Ancien mot de passe incorrect ou nouveau vide");
         }
     }, LV_EVENT_CLICKED, nullptr);
 }
 
-// Création de la fenêtre login
-void createLoginWindow()
+// Construction de l'écran de connexion (une seule fois, au démarrage)
+static void createLoginWindow(lv_obj_t *ecran)
 {
-    if (loginWindow != nullptr) {
-        // Si déjà créée, on la réaffiche et on reset le champ
-        lv_obj_clear_flag(loginWindow, LV_OBJ_FLAG_HIDDEN);
-        if (pwdTextarea) lv_textarea_set_text(pwdTextarea, "");
-        if (keyboard) {
-            lv_obj_add_flag(keyboard, LV_OBJ_FLAG_HIDDEN);
-            lv_keyboard_set_textarea(keyboard, NULL);
-        }
-        return;
-    }
-    lv_obj_add_flag(barriereContainer, LV_OBJ_FLAG_HIDDEN); // Masque la barrière
-    loginWindow = lv_win_create(lv_scr_act());
-    lv_obj_set_size(loginWindow, 480, 272);
-    lv_obj_align(loginWindow, LV_ALIGN_CENTER, 0, 0);
+    loginWindow = lv_win_create(ecran); // Plein écran
 
     // Titre
     lv_obj_t *header = lv_win_get_header(loginWindow);
     lv_obj_t *title = lv_label_create(header);
     lv_label_set_text(title, "Connexion");
-    lv_obj_center(title);
+    lv_obj_add_style(title, &style_centre, 0);
 
     // Champ mot de passe
     pwdTextarea = lv_textarea_create(loginWindow);
-    lv_obj_set_size(pwdTextarea, 380, 50);
-    lv_obj_align(pwdTextarea, LV_ALIGN_TOP_MID, 0, 30);
+    lv_obj_add_style(pwdTextarea, &style_champ_mdp, 0);
     lv_textarea_set_password_mode(pwdTextarea, true);
     lv_textarea_set_placeholder_text(pwdTextarea, "Mot de passe");
 
-    // Clavier numérique (créé une seule fois)
-    if (keyboard == nullptr) {
-        keyboard = lv_keyboard_create(lv_scr_act());
-        lv_obj_add_flag(keyboard, LV_OBJ_FLAG_HIDDEN); // Cacher par défaut
-        lv_obj_set_size(keyboard, 480, 100); // Taille personnalisée
-        lv_obj_align(keyboard, LV_ALIGN_BOTTOM_MID, 0, 0); // Aligné en bas
-        lv_keyboard_set_mode(keyboard, LV_KEYBOARD_MODE_TEXT_LOWER); // Mode texte
-    }
-
     // Associe le callback de focus à la zone texte
     lv_obj_add_event_cb(pwdTextarea, ta_event_cb, LV_EVENT_ALL, keyboard);
 
     // Bouton Valider
     lv_obj_t *btnOk = lv_btn_create(loginWindow);
-    lv_obj_set_size(btnOk, 150, 50);
-    lv_obj_align(btnOk, LV_ALIGN_BOTTOM_MID, 0, -10);
+    lv_obj_add_style(btnOk, &style_bouton, 0);
     lv_obj_t *labelOk = lv_label_create(btnOk);
     lv_label_set_text(labelOk, "Valider");
-    lv_obj_center(labelOk);
+    lv_obj_add_style(labelOk, &style_centre, 0);
 
     lv_obj_add_event_cb(btnOk, btnOk_event_handler, LV_EVENT_CLICKED, nullptr);
 
     // Bouton changement mot de passe
     btnChangePwd = lv_btn_create(loginWindow);
-    lv_obj_set_size(btnChangePwd, 200, 50);
-    lv_obj_align(btnChangePwd, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
+    lv_obj_add_style(btnChangePwd, &style_bouton_change, 0);
     lv_obj_t *labelChange = lv_label_create(btnChangePwd);
     lv_label_set_text(labelChange, "Changer de mot de passe");
-    lv_obj_center(labelChange);
+    lv_obj_add_style(labelChange, &style_centre, 0);
     lv_obj_add_event_cb(btnChangePwd, [](lv_event_t *e) {
-        lv_obj_add_flag(btnChangePwd, LV_OBJ_FLAG_HIDDEN); // Cache le bouton
-        createChangePwdWindow(); // Ouvre la fenêtre de changement
+        // Réinitialise les champs et affiche l'écran déjà construit
+        cacherClavier();
+        lv_textarea_set_text(oldPwdTA, "");
+        lv_textarea_set_text(newPwdTA, "");
+        ecrans_afficher(ECRAN_CHANGE_PWD);
     }, LV_EVENT_CLICKED, nullptr);
 }
 
+// Construit à l'avance tous les écrans de l'application
+void createScreens()
+{
+    createKeyboard();
+    ecrans_ajouter_actif(ECRAN_BARRIERE, "barriere");
+    ecrans_ajouter(ECRAN_LOGIN, "login", createLoginWindow);
+    ecrans_ajouter(ECRAN_CHANGE_PWD, "change_pwd", createChangePwdWindow);
+    ecrans_construire();
+}
+
+// Affiche l'écran de connexion (déjà construit) avec un champ vide
+void showLoginWindow()
+{
+    lv_textarea_set_text(pwdTextarea, ""); // Reset du champ
+    cacherClavier();
+    ecrans_afficher(ECRAN_LOGIN);
+}
+
+// Revient à l'écran principal de la barrière
+void hideLoginWindow()
+{
+    cacherClavier();
+    ecrans_afficher(ECRAN_BARRIERE);
+}
+
 #ifdef ARDUINO
 
 #include <HardwareSerial.h>
@@ -313,6 +306,7 @@ void mySetup()
     MyTim->setPWM(1, PA_15, 50, 10);
 
     testLvgl(); // Création de l'interface graphique
+    createScreens(); // Construction des écrans login / changement de mot de passe
 }
 
 // Boucle principale Arduino (vide, tout est géré dans la tâche)
@@ -411,8 +405,7 @@ void myTask(void *pvParameters)
                 {
                     // Crée la fenêtre login
                     lv_lock();
-                    createLoginWindow(); // Affiche la fenêtre login
-                    lv_obj_add_flag(barriereContainer, LV_OBJ_FLAG_HIDDEN); // Cache la barrière
+                    showLoginWindow(); // Affiche la fenêtre login (déjà construite)
                     lv_obj_add_flag(etatLabel, LV_OBJ_FLAG_HIDDEN); // Cache le label d'état
                     lv_unlock();
                     enAttenteConnexion = true;
@@ -475,14 +468,7 @@ void myTask(void *pvParameters)
             {
                 Serial.println("On va cacher la fenêtre login !");
                 lv_lock();
-                if (keyboard) {
-                    lv_obj_add_flag(keyboard, LV_OBJ_FLAG_HIDDEN);
-                    lv_keyboard_set_textarea(keyboard, NULL);
-                }
-                if (loginWindow) {
-                    lv_obj_add_flag(loginWindow, LV_OBJ_FLAG_HIDDEN);
-                }
-                lv_obj_clear_flag(barriereContainer, LV_OBJ_FLAG_HIDDEN); // Réaffiche la barrière
+                hideLoginWindow(); // Retour à l'écran de la barrière
                 lv_unlock();
 
                 enAttenteConnexion = false;
@@ -551,6 +537,7 @@ int main(void)
     hal_setup();    // Initialisation HAL
 
     testLvgl();     // Création de l'interface graphique
+    createScreens(); // Construction des écrans login / changement de mot de passe
 
     hal_loop();     // Boucle principale simulateur
     return 0;
@@ -0,0 +1,245 @@
+#include "pinpad.h"
+#include "src/lvgl_private.h"            // Accès à lv_obj_t et lv_obj_class_t (API privée LVGL)
+
+#define MY_CLASS (&pinpad_class)
+
+#define PINPAD_COLS    3
+#define PINPAD_LIGNES  4
+#define PINPAD_ECART   4                 // Espace entre les touches [px]
+#define TOUCHE_EFFACER 9                 // Index de la touche retour arrière
+#define TOUCHE_OK      11                // Index de la touche OK
+
+// Textes des touches, en flash
+static const char *const textesTouches[PINPAD_COLS * PINPAD_LIGNES] = {
+    "1", "2", "3",
+    "4", "5", "6",
+    "7", "8", "9",
+    LV_SYMBOL_BACKSPACE, "0", LV_SYMBOL_OK
+};
+
+// Données d'instance du pavé numérique
+typedef struct {
+    lv_obj_t obj;                        // Doit rester en premier (héritage lv_obj)
+    lv_obj_t *ta;                        // Textarea cible
+    int32_t colX[PINPAD_COLS + 1];       // Bords gauches des colonnes (+ bord droit final), relatifs
+    int32_t ligneY[PINPAD_LIGNES + 1];   // Bords hauts des lignes (+ bord bas final), relatifs
+    uint8_t touchePressee;               // Index de la touche pressée ou PINPAD_TOUCHE_AUCUNE
+    uint8_t toucheActive;                // Dernière touche validée
+} pinpad_t;
+
+static void pinpad_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void pinpad_event(const lv_obj_class_t *class_p, lv_event_t *e);
+
+const lv_obj_class_t pinpad_class = {
+    .base_class = &lv_obj_class,
+    .constructor_cb = pinpad_constructor,
+    .destructor_cb = nullptr,
+    .event_cb = pinpad_event,
+    .user_data = nullptr,
+    .name = "pinpad",
+    .width_def = 240,
+    .height_def = 160,
+    .editable = LV_OBJ_CLASS_EDITABLE_INHERIT,
+    .group_def = LV_OBJ_CLASS_GROUP_DEF_INHERIT,
+    .instance_size = sizeof(pinpad_t),
+    .theme_inheritable = LV_OBJ_CLASS_THEME_INHERITABLE_TRUE,
+};
+
+// Recalcule la grille de hit-test à partir de la zone de contenu
+static void calculerGrille(lv_obj_t *obj)
+{
+    pinpad_t *p = (pinpad_t *)obj;
+    lv_area_t contenu;
+    lv_obj_get_content_coords(obj, &contenu);
+    int32_t ox = contenu.x1 - obj->coords.x1;
+    int32_t oy = contenu.y1 - obj->coords.y1;
+    int32_t w = lv_area_get_width(&contenu) + PINPAD_ECART;
+    int32_t h = lv_area_get_height(&contenu) + PINPAD_ECART;
+
+    for (int i = 0; i <= PINPAD_COLS; i++) p->colX[i] = ox + (w * i) / PINPAD_COLS;
+    for (int i = 0; i <= PINPAD_LIGNES; i++) p->ligneY[i] = oy + (h * i) / PINPAD_LIGNES;
+}
+
+// Rectangle absolu d'une touche
+static void getZoneTouche(lv_obj_t *obj, uint8_t id, lv_area_t *zone)
+{
+    pinpad_t *p = (pinpad_t *)obj;
+    uint32_t col = id % PINPAD_COLS;
+    uint32_t ligne = id / PINPAD_COLS;
+    zone->x1 = obj->coords.x1 + p->colX[col];
+    zone->x2 = obj->coords.x1 + p->colX[col + 1] - PINPAD_ECART - 1;
+    zone->y1 = obj->coords.y1 + p->ligneY[ligne];
+    zone->y2 = obj->coords.y1 + p->ligneY[ligne + 1] - PINPAD_ECART - 1;
+}
+
+// Touche sous un point absolu (PINPAD_TOUCHE_AUCUNE entre les touches)
+static uint8_t chercherTouche(lv_obj_t *obj, const lv_point_t *pt)
+{
+    pinpad_t *p = (pinpad_t *)obj;
+    int32_t x = pt->x - obj->coords.x1;
+    int32_t y = pt->y - obj->coords.y1;
+    if (x < p->colX[0] || y < p->ligneY[0]) return PINPAD_TOUCHE_AUCUNE;
+
+    uint32_t col = 0;
+    while (col < PINPAD_COLS && x >= p->colX[col + 1]) col++;
+    uint32_t ligne = 0;
+    while (ligne < PINPAD_LIGNES && y >= p->ligneY[ligne + 1]) ligne++;
+    if (col >= PINPAD_COLS || ligne >= PINPAD_LIGNES) return PINPAD_TOUCHE_AUCUNE;
+
+    // Dans l'écart entre deux touches
+    if (x >= p->colX[col + 1] - PINPAD_ECART || y >= p->ligneY[ligne + 1] - PINPAD_ECART) return PINPAD_TOUCHE_AUCUNE;
+
+    return ligne * PINPAD_COLS + col;
+}
+
+// Change la touche pressée en n'invalidant que les deux touches concernées
+static void setTouchePressee(lv_obj_t *obj, uint8_t id)
+{
+    pinpad_t *p = (pinpad_t *)obj;
+    if (p->touchePressee == id) return;
+
+    lv_area_t zone;
+    if (p->touchePressee != PINPAD_TOUCHE_AUCUNE) {
+        getZoneTouche(obj, p->touchePressee, &zone);
+        lv_obj_invalidate_area(obj, &zone);
+    }
+    p->touchePressee = id;
+    if (id != PINPAD_TOUCHE_AUCUNE) {
+        getZoneTouche(obj, id, &zone);
+        lv_obj_invalidate_area(obj, &zone);
+    }
+}
+
+// Applique la touche validée à la textarea et prévient l'application
+static void validerTouche(lv_obj_t *obj, uint8_t id)
+{
+    pinpad_t *p = (pinpad_t *)obj;
+    p->toucheActive = id;
+
+    lv_result_t res = lv_obj_send_event(obj, LV_EVENT_VALUE_CHANGED, nullptr);
+    if (res != LV_RESULT_OK || p->ta == nullptr) return;
+
+    if (id == TOUCHE_EFFACER) {
+        lv_textarea_delete_char(p->ta);
+    }
+    else if (id == TOUCHE_OK) {
+        res = lv_obj_send_event(obj, LV_EVENT_READY, nullptr);
+        if (res != LV_RESULT_OK) return;
+        if (p->ta) lv_obj_send_event(p->ta, LV_EVENT_READY, nullptr);
+    }
+    else {
+        lv_textarea_add_text(p->ta, textesTouches[id]);
+    }
+}
+
+lv_obj_t *pinpad_create(lv_obj_t *parent)
+{
+    LV_LOG_INFO("begin");
+    lv_obj_t *obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+void pinpad_set_textarea(lv_obj_t *obj, lv_obj_t *ta)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    pinpad_t *p = (pinpad_t *)obj;
+    if (p->ta) lv_obj_remove_state(p->ta, LV_STATE_FOCUSED);
+    p->ta = ta;
+    if (p->ta) lv_obj_add_flag(p->ta, LV_OBJ_FLAG_SCROLL_ON_FOCUS);
+}
+
+lv_obj_t *pinpad_get_textarea(const lv_obj_t *obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    return ((const pinpad_t *)obj)->ta;
+}
+
+const char *pinpad_get_touche_texte(const lv_obj_t *obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    const pinpad_t *p = (const pinpad_t *)obj;
+    if (p->toucheActive == PINPAD_TOUCHE_AUCUNE) return nullptr;
+    return textesTouches[p->toucheActive];
+}
+
+static void pinpad_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj)
+{
+    LV_UNUSED(class_p);
+    pinpad_t *p = (pinpad_t *)obj;
+    p->ta = nullptr;
+    p->touchePressee = PINPAD_TOUCHE_AUCUNE;
+    p->toucheActive = PINPAD_TOUCHE_AUCUNE;
+    lv_memzero(p->colX, sizeof(p->colX));
+    lv_memzero(p->ligneY, sizeof(p->ligneY));
+
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_CLICK_FOCUSABLE);
+}
+
+static void pinpad_event(const lv_obj_class_t *class_p, lv_event_t *e)
+{
+    LV_UNUSED(class_p);
+
+    lv_result_t res = lv_obj_event_base(MY_CLASS, e);
+    if (res != LV_RESULT_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t *obj = (lv_obj_t *)lv_event_get_current_target(e);
+    pinpad_t *p = (pinpad_t *)obj;
+
+    if (code == LV_EVENT_SIZE_CHANGED || code == LV_EVENT_STYLE_CHANGED) {
+        calculerGrille(obj);
+    }
+    else if (code == LV_EVENT_PRESSED || code == LV_EVENT_PRESSING) {
+        lv_indev_t *indev = lv_indev_active();
+        if (indev == nullptr || lv_indev_get_type(indev) != LV_INDEV_TYPE_POINTER) return;
+        lv_point_t pt;
+        lv_indev_get_point(indev, &pt);
+        setTouchePressee(obj, chercherTouche(obj, &pt));
+    }
+    else if (code == LV_EVENT_RELEASED) {
+        uint8_t id = p->touchePressee;
+        setTouchePressee(obj, PINPAD_TOUCHE_AUCUNE);
+        if (id != PINPAD_TOUCHE_AUCUNE) validerTouche(obj, id);
+    }
+    else if (code == LV_EVENT_PRESS_LOST) {
+        setTouchePressee(obj, PINPAD_TOUCHE_AUCUNE);
+    }
+    else if (code == LV_EVENT_DRAW_MAIN) {
+        lv_layer_t *layer = lv_event_get_layer(e);
+
+        lv_draw_rect_dsc_t rect;
+        lv_draw_rect_dsc_init(&rect);
+        rect.radius = 4;
+        rect.border_width = 1;
+        rect.border_color = lv_palette_lighten(LV_PALETTE_GREY, 1);
+
+        lv_draw_label_dsc_t label;
+        lv_draw_label_dsc_init(&label);
+        label.font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+        label.align = LV_TEXT_ALIGN_CENTER;
+        int32_t hPolice = lv_font_get_line_height(label.font);
+
+        // Seules les touches qui recoupent la zone à redessiner sont tracées
+        const lv_area_t *clip = &layer->_clip_area;
+        for (uint8_t id = 0; id < PINPAD_COLS * PINPAD_LIGNES; id++) {
+            lv_area_t zone;
+            getZoneTouche(obj, id, &zone);
+            if (!lv_area_is_on(&zone, clip)) continue;
+
+            bool presse = (id == p->touchePressee);
+            if (id == TOUCHE_OK) rect.bg_color = lv_theme_get_color_primary(obj);
+            else rect.bg_color = lv_palette_lighten(LV_PALETTE_GREY, 4);
+            if (presse) rect.bg_color = lv_color_darken(rect.bg_color, LV_OPA_30);
+            lv_draw_rect(layer, &rect, &zone);
+
+            label.color = (id == TOUCHE_OK) ? lv_color_white() : lv_color_black();
+            label.text = textesTouches[id];
+            lv_area_t zoneTexte = zone;
+            zoneTexte.y1 = zone.y1 + (lv_area_get_height(&zone) - hPolice) / 2;
+            zoneTexte.y2 = zoneTexte.y1 + hPolice - 1;
+            lv_draw_label(layer, &label, &zoneTexte);
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#ifndef PINPAD_H
+#define PINPAD_H
+
+#include "lvgl.h"
+
+// Pavé numérique léger (4 lignes x 3 colonnes) :
+//   1 2 3 / 4 5 6 / 7 8 9 / <- 0 OK
+// Les touches sont dessinées directement par le widget (aucun objet ni
+// allocation par touche), le hit-test se fait sur une grille précalculée et
+// seul le rectangle de la touche pressée est invalidé.
+
+#define PINPAD_TOUCHE_AUCUNE 0xFF        // Aucune touche pressée
+
+lv_obj_t *pinpad_create(lv_obj_t *parent);
+
+// Textarea qui reçoit les chiffres (nullptr pour détacher)
+void pinpad_set_textarea(lv_obj_t *obj, lv_obj_t *ta);
+lv_obj_t *pinpad_get_textarea(const lv_obj_t *obj);
+
+// Texte de la touche pressée (valide pendant LV_EVENT_VALUE_CHANGED)
+const char *pinpad_get_touche_texte(const lv_obj_t *obj);
+
+#endif // PINPAD_H
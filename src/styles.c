@@ -0,0 +1,136 @@
+#include "styles.h"
+
+// Couleurs de la palette LVGL (lv_palette_main n'est pas utilisable en constante)
+#define COULEUR_GRIS LV_COLOR_MAKE(0x9E, 0x9E, 0x9E)
+
+// Bit du groupe d'une propriété dans has_group (voir lv_style_get_prop_group)
+#define GROUPE(prop) ((uint32_t)1 << ((prop) >> 2))
+
+// Comme LV_STYLE_CONST_INIT, mais avec les groupes des propriétés du style au lieu de
+// 0xFFFFFFFF : la recherche d'une propriété saute alors les styles qui ne peuvent pas la contenir.
+#if LV_USE_ASSERT_STYLE
+#define STYLE_CONST_INIT(nom, props, groupes)      \
+    const lv_style_t nom = {                        \
+        .sentinel = LV_STYLE_SENTINEL_VALUE,        \
+        .values_and_props = (void *)props,          \
+        .has_group = groupes,                       \
+        .prop_cnt = 255                             \
+    }
+#else
+#define STYLE_CONST_INIT(nom, props, groupes)      \
+    const lv_style_t nom = {                        \
+        .values_and_props = (void *)props,          \
+        .has_group = groupes,                       \
+        .prop_cnt = 255                             \
+    }
+#endif
+
+static const lv_style_const_prop_t props_conteneur[] = {
+    LV_STYLE_CONST_WIDTH(200),
+    LV_STYLE_CONST_HEIGHT(180),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_CENTER),
+    LV_STYLE_CONST_Y(20), // Décalé vers le bas pour ne pas chevaucher l'heure
+    LV_STYLE_CONST_PROPS_END
+};
+STYLE_CONST_INIT(style_conteneur, props_conteneur,
+                 GROUPE(LV_STYLE_WIDTH) | GROUPE(LV_STYLE_HEIGHT) | GROUPE(LV_STYLE_ALIGN) | GROUPE(LV_STYLE_Y));
+
+static const lv_style_const_prop_t props_socle[] = {
+    LV_STYLE_CONST_WIDTH(40),
+    LV_STYLE_CONST_HEIGHT(40),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_BOTTOM_LEFT),
+    LV_STYLE_CONST_BG_COLOR(COULEUR_GRIS),
+    LV_STYLE_CONST_RADIUS(8),
+    LV_STYLE_CONST_PROPS_END
+};
+STYLE_CONST_INIT(style_socle, props_socle,
+                 GROUPE(LV_STYLE_WIDTH) | GROUPE(LV_STYLE_HEIGHT) | GROUPE(LV_STYLE_ALIGN) | GROUPE(LV_STYLE_BG_COLOR) | GROUPE(LV_STYLE_RADIUS));
+
+static const lv_style_const_prop_t props_label_voitures[] = {
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_TOP_RIGHT),
+    LV_STYLE_CONST_X(-10),
+    LV_STYLE_CONST_Y(10),
+    LV_STYLE_CONST_PROPS_END
+};
+STYLE_CONST_INIT(style_label_voitures, props_label_voitures,
+                 GROUPE(LV_STYLE_ALIGN) | GROUPE(LV_STYLE_X) | GROUPE(LV_STYLE_Y));
+
+static const lv_style_const_prop_t props_label_heure[] = {
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_TOP_LEFT),
+    LV_STYLE_CONST_X(10),
+    LV_STYLE_CONST_Y(10),
+    LV_STYLE_CONST_PROPS_END
+};
+STYLE_CONST_INIT(style_label_heure, props_label_heure,
+                 GROUPE(LV_STYLE_ALIGN) | GROUPE(LV_STYLE_X) | GROUPE(LV_STYLE_Y));
+
+static const lv_style_const_prop_t props_label_etat[] = {
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_BOTTOM_MID),
+    LV_STYLE_CONST_Y(-10),
+    LV_STYLE_CONST_PROPS_END
+};
+STYLE_CONST_INIT(style_label_etat, props_label_etat,
+                 GROUPE(LV_STYLE_ALIGN) | GROUPE(LV_STYLE_Y));
+
+static const lv_style_const_prop_t props_centre[] = {
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_CENTER),
+    LV_STYLE_CONST_PROPS_END
+};
+STYLE_CONST_INIT(style_centre, props_centre,
+                 GROUPE(LV_STYLE_ALIGN));
+
+// Les décalages des champs sont dans les styles : un style local en plus sur l'objet
+// ralentirait chaque recherche de propriété
+static const lv_style_const_prop_t props_champ_mdp[] = {
+    LV_STYLE_CONST_WIDTH(380),
+    LV_STYLE_CONST_HEIGHT(50),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_TOP_MID),
+    LV_STYLE_CONST_Y(30),
+    LV_STYLE_CONST_PROPS_END
+};
+STYLE_CONST_INIT(style_champ_mdp, props_champ_mdp,
+                 GROUPE(LV_STYLE_WIDTH) | GROUPE(LV_STYLE_HEIGHT) | GROUPE(LV_STYLE_ALIGN) | GROUPE(LV_STYLE_Y));
+
+static const lv_style_const_prop_t props_champ_mdp_2[] = {
+    LV_STYLE_CONST_WIDTH(380),
+    LV_STYLE_CONST_HEIGHT(50),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_TOP_MID),
+    LV_STYLE_CONST_Y(100),
+    LV_STYLE_CONST_PROPS_END
+};
+STYLE_CONST_INIT(style_champ_mdp_2, props_champ_mdp_2,
+                 GROUPE(LV_STYLE_WIDTH) | GROUPE(LV_STYLE_HEIGHT) | GROUPE(LV_STYLE_ALIGN) | GROUPE(LV_STYLE_Y));
+
+static const lv_style_const_prop_t props_bouton[] = {
+    LV_STYLE_CONST_WIDTH(150),
+    LV_STYLE_CONST_HEIGHT(50),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_BOTTOM_MID),
+    LV_STYLE_CONST_Y(-10),
+    LV_STYLE_CONST_PROPS_END
+};
+STYLE_CONST_INIT(style_bouton, props_bouton,
+                 GROUPE(LV_STYLE_WIDTH) | GROUPE(LV_STYLE_HEIGHT) | GROUPE(LV_STYLE_ALIGN) | GROUPE(LV_STYLE_Y));
+
+static const lv_style_const_prop_t props_bouton_change[] = {
+    LV_STYLE_CONST_WIDTH(200),
+    LV_STYLE_CONST_HEIGHT(50),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_BOTTOM_RIGHT),
+    LV_STYLE_CONST_X(-10),
+    LV_STYLE_CONST_Y(-10),
+    LV_STYLE_CONST_PROPS_END
+};
+STYLE_CONST_INIT(style_bouton_change, props_bouton_change,
+                 GROUPE(LV_STYLE_WIDTH) | GROUPE(LV_STYLE_HEIGHT) | GROUPE(LV_STYLE_ALIGN) | GROUPE(LV_STYLE_X) | GROUPE(LV_STYLE_Y));
+
+static const lv_style_const_prop_t props_pinpad[] = {
+    LV_STYLE_CONST_WIDTH(480),
+    LV_STYLE_CONST_HEIGHT(120), // 4 lignes de touches
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_BOTTOM_MID),
+    LV_STYLE_CONST_PAD_TOP(4),
+    LV_STYLE_CONST_PAD_BOTTOM(4),
+    LV_STYLE_CONST_PAD_LEFT(4),
+    LV_STYLE_CONST_PAD_RIGHT(4),
+    LV_STYLE_CONST_PROPS_END
+};
+STYLE_CONST_INIT(style_pinpad, props_pinpad,
+                 GROUPE(LV_STYLE_WIDTH) | GROUPE(LV_STYLE_HEIGHT) | GROUPE(LV_STYLE_ALIGN) | GROUPE(LV_STYLE_PAD_TOP) | GROUPE(LV_STYLE_PAD_BOTTOM) | GROUPE(LV_STYLE_PAD_LEFT) | GROUPE(LV_STYLE_PAD_RIGHT));
@@ -0,0 +1,30 @@
+#ifndef STYLES_H
+#define STYLES_H
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Feuille de styles de l'application : styles constants (en flash), partagés
+// par les objets via lv_obj_add_style au lieu de styles locaux alloués dans
+// le tas pour chaque objet (lv_obj_set_style_*, lv_obj_set_size, lv_obj_align).
+
+extern const lv_style_t style_conteneur;      // Conteneur de la barrière
+extern const lv_style_t style_socle;          // Socle gris arrondi
+extern const lv_style_t style_label_voitures; // Compteur de voitures (haut droite)
+extern const lv_style_t style_label_heure;    // Heure simulée (haut gauche)
+extern const lv_style_t style_label_etat;     // État de la barrière (bas centre)
+extern const lv_style_t style_centre;         // Titres et textes des boutons
+extern const lv_style_t style_champ_mdp;      // Premier champ mot de passe
+extern const lv_style_t style_champ_mdp_2;    // Second champ mot de passe (en dessous)
+extern const lv_style_t style_bouton;         // Boutons "Valider"
+extern const lv_style_t style_bouton_change;  // Bouton "Changer de mot de passe"
+extern const lv_style_t style_pinpad;         // Pavé numérique
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // STYLES_H
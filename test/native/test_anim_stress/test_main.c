@@ -0,0 +1,166 @@
+// Regroupement des rafraîchissements de style d'un tour d'animations (lv_obj_style_refresh_batch_start/end) :
+// beaucoup d'objets animés en x, y et opacité, certains en rotation ou en ombre. Même image qu'avant le
+// regroupement, et temps d'un tour d'animations de 33 ms.
+// Lancement : pio test -e native -f native/test_anim_stress
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+
+// Même valeur avec et sans le regroupement des rafraîchissements
+#define CONTROLE_SCENE  0xEFCDB979u
+
+#define PERIODE         33               // ms par tour d'animations, comme LV_DEF_REFR_PERIOD
+#define NB_TOURS        60
+
+static uint32_t ecran[480 * 272];
+static uint32_t tampon[480 * 272 / 10];
+static uint64_t tas[8][120 * 1024 / 8];    // Objets, styles locaux et animations (pools de 128 ko au plus)
+static lv_display_t *disp;
+static uint32_t graine;
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static uint32_t aleatoire(uint32_t max)
+{
+    graine = graine * 1103515245u + 12345u;
+    return (graine >> 8) % max;
+}
+
+static void flush(lv_display_t *d, const lv_area_t *zone, uint8_t *px)
+{
+    const uint32_t *p = (const uint32_t *)px;
+    for (int32_t y = zone->y1; y <= zone->y2; y++) {
+        for (int32_t x = zone->x1; x <= zone->x2; x++) ecran[y * 480 + x] = *p++;
+    }
+    lv_display_flush_ready(d);
+}
+
+// FNV-1a de l'écran
+static uint32_t controlerEcran(void)
+{
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < 480 * 272; i++) h = (h ^ ecran[i]) * 16777619u;
+    return h;
+}
+
+void setUp(void)
+{
+    lv_init();
+    for (uint32_t i = 0; i < 8; i++) lv_mem_add_pool(tas[i], sizeof(tas[i]));
+    disp = lv_display_create(480, 272);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);   // 32 bits comme le projet
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_set_buffers(disp, tampon, NULL, sizeof(tampon), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    graine = 1;
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+static void animerX(void *obj, int32_t v) { lv_obj_set_x((lv_obj_t *)obj, v); }
+static void animerY(void *obj, int32_t v) { lv_obj_set_y((lv_obj_t *)obj, v); }
+static void animerOpa(void *obj, int32_t v) { lv_obj_set_style_opa((lv_obj_t *)obj, (lv_opa_t)v, 0); }
+static void animerRotation(void *obj, int32_t v) { lv_obj_set_style_transform_rotation((lv_obj_t *)obj, v, 0); }
+static void animerOmbre(void *obj, int32_t v) { lv_obj_set_style_shadow_width((lv_obj_t *)obj, v, 0); }
+
+static void animer(lv_obj_t *obj, lv_anim_exec_xcb_t cb, int32_t debut, int32_t fin)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, obj);
+    lv_anim_set_exec_cb(&a, cb);
+    lv_anim_set_values(&a, debut, fin);
+    lv_anim_set_duration(&a, 500 + aleatoire(1500));
+    lv_anim_set_playback_duration(&a, 500 + aleatoire(1500));
+    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+    lv_anim_start(&a);
+}
+
+// Retourne le nombre d'animations créées
+static uint32_t creerScene(uint32_t nbObjets)
+{
+    uint32_t nb = 0;
+    for (uint32_t i = 0; i < nbObjets; i++) {
+        lv_obj_t *obj = lv_obj_create(lv_screen_active());
+        lv_obj_set_size(obj, 16 + aleatoire(24), 16 + aleatoire(24));
+        lv_obj_set_style_bg_color(obj, lv_color_hex(aleatoire(0x1000000)), 0);
+        animer(obj, animerX, aleatoire(440), aleatoire(440));
+        animer(obj, animerY, aleatoire(240), aleatoire(240));
+        animer(obj, animerOpa, LV_OPA_50, LV_OPA_COVER);
+        nb += 3;
+        if (i % 10 == 0) {
+            animer(obj, animerRotation, 0, 3600);
+            nb++;
+        }
+        if (i % 7 == 0) {
+            animer(obj, animerOmbre, 0, 20);
+            nb++;
+        }
+    }
+    return nb;
+}
+
+// Tour d'animations de PERIODE ms, retourne sa durée
+static uint64_t tourAnimations(void)
+{
+    lv_tick_inc(PERIODE);
+    uint64_t t0 = nanosecondes();
+    lv_anim_refr_now();
+    return nanosecondes() - t0;
+}
+
+// Une image sur 10 est rendue et contrôlée
+static void test_rendu(void)
+{
+    creerScene(200);
+    uint32_t h = 2166136261u;
+    for (uint32_t n = 0; n < NB_TOURS; n++) {
+        tourAnimations();
+        if (n % 10 == 9) {
+            lv_refr_now(disp);
+            h = (h ^ controlerEcran()) * 16777619u;
+        }
+    }
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_SCENE, h);
+}
+
+// Temps moyen d'un tour d'animations (sans le rendu) et d'une image
+static void test_benchmark(void)
+{
+    static const uint32_t nbObjets[] = {200, 500};
+    char msg[128];
+    for (uint32_t k = 0; k < sizeof(nbObjets) / sizeof(nbObjets[0]); k++) {
+        lv_obj_clean(lv_screen_active());
+        lv_refr_now(disp);
+        uint32_t nbAnims = creerScene(nbObjets[k]);
+        uint64_t anim = 0, rendu = 0;
+        for (uint32_t n = 0; n < NB_TOURS; n++) {
+            anim += tourAnimations();
+            uint64_t t0 = nanosecondes();
+            lv_refr_now(disp);
+            rendu += nanosecondes() - t0;
+        }
+        snprintf(msg, sizeof(msg), "%u objets, %u animations : tour %u µs, image %u µs",
+                 (unsigned)nbObjets[k], (unsigned)nbAnims, (unsigned)(anim / NB_TOURS / 1000),
+                 (unsigned)(rendu / NB_TOURS / 1000));
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_rendu);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,293 @@
+// Mélanges des fonctions de blend logiciel de LVGL vers ARGB8888 et RGB565, comparés bit à bit aux
+// sommes de contrôle relevées avec le code C (LV_DRAW_SW_ASM_NONE).
+// Lancement : pio test -e native -f native/test_blend
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+#include "src/lvgl_private.h"            // Descripteurs de blend (API privée LVGL)
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_argb8888.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+
+// Relevés avec LV_DRAW_SW_ASM_NONE
+#define CONTROLE_COULEUR_ARGB8888   0xECB77C99u
+#define CONTROLE_COULEUR_RGB565     0xEC602725u
+#define CONTROLE_ALEATOIRE          0x455799EFu
+
+#define L       67                       // Largeur maximale des zones aléatoires
+#define H       9
+#define MARGE   8
+#define PAS     (L + MARGE)              // Pixels par ligne
+
+static uint32_t dst32[H * PAS];
+static uint32_t src32[H * PAS];
+static uint16_t dst16[H * PAS];
+static uint16_t src16[H * PAS];
+static uint8_t masque[H * PAS + 4];
+static uint32_t graine;
+
+static uint32_t aleatoire(void)
+{
+    graine = graine * 1103515245u + 12345u;
+    return graine >> 8;
+}
+
+// Valeurs d'alpha aux limites des arrondis, une fois sur deux
+static uint8_t alphaAleatoire(void)
+{
+    static const uint8_t speciaux[] = {0, 1, 2, 3, 4, 127, 128, 129, 250, 251, 252, 253, 254, 255};
+    if (aleatoire() & 1) return speciaux[aleatoire() % sizeof(speciaux)];
+    return (uint8_t)aleatoire();
+}
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// FNV-1a
+static uint32_t controler(uint32_t h, const void *p, size_t taille)
+{
+    const uint8_t *o = (const uint8_t *)p;
+    for (size_t i = 0; i < taille; i++) h = (h ^ o[i]) * 16777619u;
+    return h;
+}
+
+void setUp(void)
+{
+    graine = 1;
+}
+
+void tearDown(void)
+{
+}
+
+// Couleur unie avec toutes les opacités sur tous les fonds : 256 couleurs x 256 opacités x 256 fonds.
+// Sur un fond opaque, c'est rgb888_mix/rgb565_mix pour toutes les valeurs de canaux.
+static uint32_t remplissages(bool argb8888)
+{
+    static uint32_t fond32[256];
+    static uint16_t fond16[256];
+    uint32_t h = 2166136261u;
+
+    lv_draw_sw_blend_fill_dsc_t dsc;
+    lv_memzero(&dsc, sizeof(dsc));
+    dsc.dest_w = 256;
+    dsc.dest_h = 1;
+
+    for (uint32_t c = 0; c < 256; c++) {
+        dsc.color = lv_color_make((uint8_t)c, (uint8_t)(255 - c), (uint8_t)(c * 7));
+        for (uint32_t opa = 0; opa < 256; opa++) {
+            dsc.opa = (lv_opa_t)opa;
+            if (argb8888) {
+                for (uint32_t i = 0; i < 256; i++) fond32[i] = 0xFF000000u | (i << 16) | ((i * 3 & 0xFF) << 8) | (255 - i);
+                dsc.dest_buf = fond32;
+                dsc.dest_stride = sizeof(fond32);
+                lv_draw_sw_blend_color_to_argb8888(&dsc);
+                h = controler(h, fond32, sizeof(fond32));
+            }
+            else {
+                for (uint32_t i = 0; i < 256; i++) fond16[i] = (uint16_t)(i * 257u);
+                dsc.dest_buf = fond16;
+                dsc.dest_stride = sizeof(fond16);
+                lv_draw_sw_blend_color_to_rgb565(&dsc);
+                h = controler(h, fond16, sizeof(fond16));
+            }
+        }
+    }
+    return h;
+}
+
+static void test_couleur_vers_argb8888(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_COULEUR_ARGB8888, remplissages(true));
+}
+
+static void test_couleur_vers_rgb565(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_COULEUR_RGB565, remplissages(false));
+}
+
+static void remplirAleatoire(bool fondUni)
+{
+    for (uint32_t i = 0; i < H * PAS; i++) {
+        uint32_t c = aleatoire() ^ (aleatoire() << 12);
+        if (fondUni && (i % 5)) c = 0x12345678u;
+        dst32[i] = (c & 0xFFFFFFu) | ((uint32_t)alphaAleatoire() << 24);
+        src32[i] = ((aleatoire() ^ (aleatoire() << 10)) & 0xFFFFFFu) | ((uint32_t)alphaAleatoire() << 24);
+        dst16[i] = fondUni && (i % 5) ? 0x1234 : (uint16_t)aleatoire();
+        src16[i] = (uint16_t)aleatoire();
+    }
+    for (uint32_t i = 0; i < sizeof(masque); i++) {
+        uint32_t r = aleatoire() % 4;
+        masque[i] = r == 0 ? 0 : r == 1 ? 255 : alphaAleatoire();
+    }
+}
+
+// Remplissages et images ARGB8888/RGB565 avec opacité et/ou masque, fonds semi-transparents,
+// largeurs de 60 à 67, masques et destination RGB565 non alignés
+static void test_cas_aleatoires(void)
+{
+    static const lv_opa_t opacites[] = {255, 254, 253, 252, 200, 128, 3, 2};
+    uint32_t h = 2166136261u;
+
+    for (uint32_t n = 0; n < 20000; n++) {
+        uint32_t decalage = aleatoire() % 4;
+        int32_t largeur = L - (int32_t)(aleatoire() % 8);
+        lv_opa_t opa = opacites[aleatoire() % 8];
+        bool avecMasque = aleatoire() & 1;
+        lv_color_t couleur = lv_color_hex(aleatoire());
+        remplirAleatoire(n & 1);
+
+        lv_draw_sw_blend_fill_dsc_t f;
+        lv_memzero(&f, sizeof(f));
+        f.dest_w = largeur;
+        f.dest_h = H;
+        f.color = couleur;
+        f.opa = opa;
+        f.mask_buf = avecMasque ? masque + decalage : NULL;
+        f.mask_stride = PAS;
+        f.dest_buf = dst32;
+        f.dest_stride = PAS * 4;
+        lv_draw_sw_blend_color_to_argb8888(&f);
+        f.dest_buf = dst16;
+        f.dest_stride = PAS * 2;
+        lv_draw_sw_blend_color_to_rgb565(&f);
+        h = controler(h, dst32, sizeof(dst32));
+        h = controler(h, dst16, sizeof(dst16));
+
+        remplirAleatoire(n & 1);
+        lv_draw_sw_blend_image_dsc_t d;
+        lv_memzero(&d, sizeof(d));
+        d.dest_w = largeur;
+        d.dest_h = H;
+        d.opa = opa;
+        d.blend_mode = LV_BLEND_MODE_NORMAL;
+        d.mask_buf = avecMasque ? masque + decalage : NULL;
+        d.mask_stride = PAS;
+        d.src_buf = src32;
+        d.src_stride = PAS * 4;
+        d.src_color_format = LV_COLOR_FORMAT_ARGB8888;
+        d.dest_buf = dst32;
+        d.dest_stride = PAS * 4;
+        lv_draw_sw_blend_image_to_argb8888(&d);
+        d.dest_buf = dst16;
+        d.dest_stride = PAS * 2;
+        lv_draw_sw_blend_image_to_rgb565(&d);
+        d.src_buf = src16;
+        d.src_stride = PAS * 2;
+        d.src_color_format = LV_COLOR_FORMAT_RGB565;
+        d.dest_buf = dst16 + 1;
+        lv_draw_sw_blend_image_to_rgb565(&d);
+        h = controler(h, dst32, sizeof(dst32));
+        h = controler(h, dst16, sizeof(dst16));
+    }
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_ALEATOIRE, h);
+}
+
+// Zone de 480 x 16 pixels sur un fond opaque, masque comme un bord antialiasé (surtout 0 ou 255), en ns par pixel
+static void test_benchmark(void)
+{
+    static uint32_t fond32[480 * 16];
+    static uint32_t image32[480 * 16];
+    static uint16_t fond16[480 * 16];
+    static uint16_t image16[480 * 16];
+    static uint8_t bord[480 * 16];
+    static const char *const noms[] = {"couleur -> ARGB8888", "couleur -> RGB565", "ARGB8888 -> ARGB8888",
+                                       "ARGB8888 -> RGB565", "RGB565 -> RGB565"
+                                      };
+    char msg[128];
+
+    for (uint32_t i = 0; i < 480 * 16; i++) {
+        image32[i] = aleatoire() | 0x80000000u;
+        if (i % 3 == 0) image32[i] |= 0xFF000000u;
+        fond32[i] = aleatoire() | 0xFF000000u;
+        image16[i] = (uint16_t)aleatoire();
+        fond16[i] = (uint16_t)aleatoire();
+        uint32_t r = aleatoire() % 8;
+        bord[i] = r < 3 ? 0 : r < 6 ? 255 : (uint8_t)aleatoire();
+    }
+
+    TEST_MESSAGE("ns par pixel            opa 50 %   masque   masque + opa 50 %   normal");
+    for (uint32_t k = 0; k < 5; k++) {
+        double ns[4];
+        for (uint32_t cas = 0; cas < 4; cas++) {
+            lv_opa_t opa = (cas == 0 || cas == 2) ? LV_OPA_50 : LV_OPA_COVER;
+            const lv_opa_t *masque = (cas == 1 || cas == 2) ? bord : NULL;
+            lv_draw_sw_blend_fill_dsc_t f;
+            lv_memzero(&f, sizeof(f));
+            f.dest_w = 480;
+            f.dest_h = 16;
+            f.color = lv_color_hex(0x3377CC);
+            f.opa = opa;
+            f.mask_buf = masque;
+            f.mask_stride = 480;
+            lv_draw_sw_blend_image_dsc_t d;
+            lv_memzero(&d, sizeof(d));
+            d.dest_w = 480;
+            d.dest_h = 16;
+            d.opa = opa;
+            d.blend_mode = LV_BLEND_MODE_NORMAL;
+            d.mask_buf = masque;
+            d.mask_stride = 480;
+
+            uint64_t t0 = nanosecondes();
+            for (uint32_t r = 0; r < 200; r++) {
+                switch (k) {
+                    case 0:
+                        f.dest_buf = fond32;
+                        f.dest_stride = 480 * 4;
+                        lv_draw_sw_blend_color_to_argb8888(&f);
+                        break;
+                    case 1:
+                        f.dest_buf = fond16;
+                        f.dest_stride = 480 * 2;
+                        lv_draw_sw_blend_color_to_rgb565(&f);
+                        break;
+                    case 2:
+                        d.src_buf = image32;
+                        d.src_stride = 480 * 4;
+                        d.src_color_format = LV_COLOR_FORMAT_ARGB8888;
+                        d.dest_buf = fond32;
+                        d.dest_stride = 480 * 4;
+                        lv_draw_sw_blend_image_to_argb8888(&d);
+                        break;
+                    case 3:
+                        d.src_buf = image32;
+                        d.src_stride = 480 * 4;
+                        d.src_color_format = LV_COLOR_FORMAT_ARGB8888;
+                        d.dest_buf = fond16;
+                        d.dest_stride = 480 * 2;
+                        lv_draw_sw_blend_image_to_rgb565(&d);
+                        break;
+                    default:
+                        d.src_buf = image16;
+                        d.src_stride = 480 * 2;
+                        d.src_color_format = LV_COLOR_FORMAT_RGB565;
+                        d.dest_buf = fond16;
+                        d.dest_stride = 480 * 2;
+                        lv_draw_sw_blend_image_to_rgb565(&d);
+                        break;
+                }
+            }
+            ns[cas] = (double)(nanosecondes() - t0) / (200.0 * 480 * 16);
+        }
+        snprintf(msg, sizeof(msg), "%-21s %8.2f %8.2f %19.2f %8.2f", noms[k], ns[0], ns[1], ns[2], ns[3]);
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_couleur_vers_argb8888);
+    RUN_TEST(test_couleur_vers_rgb565);
+    RUN_TEST(test_cas_aleatoires);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
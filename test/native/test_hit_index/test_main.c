@@ -0,0 +1,246 @@
+// Grille des objets cliquables (LV_USE_INDEV_HIT_INDEX) comparée à la recherche récursive lv_indev_search_obj
+// sur des objets qui se chevauchent, cachés, défilés et transformés, sur tous les points de l'écran.
+// Lancement : pio test -e native_hit_index -f native/test_hit_index
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+#include "src/lvgl_private.h"            // Recherche par la grille et son état (API privée LVGL)
+
+#define LARGEUR         480
+#define HAUTEUR         272
+#define NB_RECHERCHES   20000
+
+static uint32_t tampon[LARGEUR * HAUTEUR / 10];
+static lv_display_t *disp;
+static uint32_t graine;
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static uint32_t aleatoire(uint32_t max)
+{
+    graine = graine * 1103515245u + 12345u;
+    return (graine >> 8) % max;
+}
+
+static void flush(lv_display_t *d, const lv_area_t *zone, uint8_t *px)
+{
+    LV_UNUSED(zone);
+    LV_UNUSED(px);
+    lv_display_flush_ready(d);
+}
+
+void setUp(void)
+{
+    lv_init();
+    disp = lv_display_create(LARGEUR, HAUTEUR);
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_set_buffers(disp, tampon, NULL, sizeof(tampon), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    graine = 1;
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+#if LV_USE_INDEV_HIT_INDEX
+
+// La grille de l'écran a été construite et utilisée
+static bool grilleUtilisee(lv_obj_t *scr)
+{
+    const lv_indev_hit_index_state_t *etat = &LV_GLOBAL_DEFAULT()->indev_hit_index;
+    for (uint32_t i = 0; i < LV_INDEV_HIT_INDEX_SLOT_CNT; i++) {
+        const lv_indev_hit_index_t *idx = &etat->slots[i];
+        if (idx->root == scr) return idx->built && idx->usable && idx->generation == etat->generation;
+    }
+    return false;
+}
+
+// Compare la grille et la recherche récursive sur tous les points de l'écran et autour,
+// retourne le nombre de points où un objet est trouvé
+static uint32_t comparer(lv_obj_t *scr, const char *scene)
+{
+    char msg[128];
+    lv_obj_update_layout(scr);
+
+    // La grille n'est construite qu'à la deuxième recherche sans changement
+    lv_point_t p = {0, 0};
+    lv_indev_hit_index_search(scr, &p);
+    lv_indev_hit_index_search(scr, &p);
+
+    uint32_t trouves = 0;
+    for (p.y = -8; p.y < HAUTEUR + 8; p.y++) {
+        for (p.x = -8; p.x < LARGEUR + 8; p.x++) {
+            lv_point_t q = p;
+            lv_obj_t *attendu = lv_indev_search_obj(scr, &q);
+            q = p;
+            lv_obj_t *obj = lv_indev_hit_index_search(scr, &q);
+            if (obj != attendu) {
+                snprintf(msg, sizeof(msg), "%s : point (%d, %d)", scene, (int)p.x, (int)p.y);
+                TEST_ASSERT_EQUAL_PTR_MESSAGE(attendu, obj, msg);
+            }
+            if (obj != NULL) trouves++;
+        }
+    }
+    return trouves;
+}
+
+// Boutons et conteneurs qui se chevauchent, avec enfants, zone de clic étendue et débordement visible
+static void creerChevauchements(lv_obj_t *scr)
+{
+    for (uint32_t i = 0; i < 40; i++) {
+        lv_obj_t *btn = lv_button_create(scr);
+        lv_obj_set_pos(btn, (int32_t)aleatoire(LARGEUR) - 20, (int32_t)aleatoire(HAUTEUR) - 20);
+        lv_obj_set_size(btn, 20 + aleatoire(100), 20 + aleatoire(60));
+        if (i % 3 == 0) {
+            lv_obj_t *enfant = lv_obj_create(btn);
+            lv_obj_set_size(enfant, 30, 30);
+            lv_obj_set_pos(enfant, (int32_t)aleatoire(60) - 20, (int32_t)aleatoire(40) - 20);
+        }
+        if (i % 5 == 0) lv_obj_set_ext_click_area(btn, 6);
+        if (i % 7 == 0) {
+            lv_obj_add_flag(btn, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+            lv_obj_t *dehors = lv_button_create(btn);
+            lv_obj_set_size(dehors, 24, 24);
+            lv_obj_set_pos(dehors, -30, -30);
+        }
+        if (i % 4 == 0) lv_obj_remove_flag(btn, LV_OBJ_FLAG_CLICKABLE);
+    }
+}
+
+static void test_chevauchements(void)
+{
+    lv_obj_t *scr = lv_screen_active();
+    creerChevauchements(scr);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, comparer(scr, "chevauchements"));
+    TEST_ASSERT_TRUE(grilleUtilisee(scr));
+
+    // Premier plan, déplacement, redimensionnement et suppression
+    lv_obj_move_foreground(lv_obj_get_child(scr, 3));
+    lv_obj_set_pos(lv_obj_get_child(scr, 5), 200, 100);
+    lv_obj_set_size(lv_obj_get_child(scr, 6), 150, 90);
+    lv_obj_delete(lv_obj_get_child(scr, 7));
+    comparer(scr, "après modification");
+    TEST_ASSERT_TRUE(grilleUtilisee(scr));
+}
+
+static void test_caches(void)
+{
+    lv_obj_t *scr = lv_screen_active();
+    creerChevauchements(scr);
+    for (uint32_t i = 0; i < lv_obj_get_child_count(scr); i += 3) lv_obj_add_flag(lv_obj_get_child(scr, i), LV_OBJ_FLAG_HIDDEN);
+    comparer(scr, "cachés");
+    TEST_ASSERT_TRUE(grilleUtilisee(scr));
+
+    for (uint32_t i = 0; i < lv_obj_get_child_count(scr); i += 6) lv_obj_remove_flag(lv_obj_get_child(scr, i), LV_OBJ_FLAG_HIDDEN);
+    comparer(scr, "réaffichés");
+}
+
+// Liste défilée verticalement et rangée défilée horizontalement, en partie hors de l'écran
+static void test_defilement(void)
+{
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_t *liste = lv_list_create(scr);
+    lv_obj_set_size(liste, 200, 200);
+    lv_obj_set_pos(liste, 10, 40);
+    for (uint32_t i = 0; i < 30; i++) lv_list_add_button(liste, NULL, "Ligne");
+    lv_obj_t *rangee = lv_obj_create(scr);
+    lv_obj_set_size(rangee, 300, 90);
+    lv_obj_set_pos(rangee, 250, 200);
+    lv_obj_set_flex_flow(rangee, LV_FLEX_FLOW_ROW);
+    for (uint32_t i = 0; i < 12; i++) lv_slider_create(rangee);
+
+    comparer(scr, "avant défilement");
+    lv_obj_scroll_to_y(liste, 350, LV_ANIM_OFF);
+    lv_obj_scroll_to_x(rangee, 500, LV_ANIM_OFF);
+    comparer(scr, "défilés");
+    TEST_ASSERT_TRUE(grilleUtilisee(scr));
+}
+
+// Un objet transformé : la grille n'est pas utilisée mais le résultat reste celui de la recherche récursive
+static void test_transformes(void)
+{
+    lv_obj_t *scr = lv_screen_active();
+    creerChevauchements(scr);
+    lv_obj_t *tourne = lv_button_create(scr);
+    lv_obj_set_size(tourne, 120, 40);
+    lv_obj_set_pos(tourne, 180, 110);
+    lv_obj_set_style_transform_rotation(tourne, 300, 0);
+    lv_obj_t *agrandi = lv_button_create(scr);
+    lv_obj_set_size(agrandi, 60, 40);
+    lv_obj_set_pos(agrandi, 40, 200);
+    lv_obj_set_style_transform_scale(agrandi, 512, 0);
+
+    comparer(scr, "transformés");
+    TEST_ASSERT_FALSE(grilleUtilisee(scr));
+
+    // Sans transformation la grille est de nouveau utilisée
+    lv_obj_set_style_transform_rotation(tourne, 0, 0);
+    lv_obj_set_style_transform_scale(agrandi, LV_SCALE_NONE, 0);
+    comparer(scr, "transformation retirée");
+    TEST_ASSERT_TRUE(grilleUtilisee(scr));
+}
+
+// Temps d'une recherche, grille construite, et de la recherche récursive
+static void test_benchmark(void)
+{
+    char msg[128];
+    lv_obj_t *scr = lv_screen_active();
+    creerChevauchements(scr);
+    lv_obj_t *liste = lv_list_create(scr);
+    for (uint32_t i = 0; i < 30; i++) lv_list_add_button(liste, NULL, "Ligne");
+    lv_obj_update_layout(scr);
+
+    static lv_point_t points[NB_RECHERCHES];
+    for (uint32_t i = 0; i < NB_RECHERCHES; i++) {
+        points[i].x = (int32_t)aleatoire(LARGEUR);
+        points[i].y = (int32_t)aleatoire(HAUTEUR);
+    }
+
+    lv_indev_hit_index_search(scr, &points[0]);
+    uint64_t t0 = nanosecondes();
+    lv_indev_hit_index_search(scr, &points[0]);
+    uint64_t construction = nanosecondes() - t0;
+
+    volatile uintptr_t somme = 0;
+    t0 = nanosecondes();
+    for (uint32_t i = 0; i < NB_RECHERCHES; i++) {
+        lv_point_t p = points[i];
+        somme += (uintptr_t)lv_indev_search_obj(scr, &p);
+    }
+    uint64_t recursive = nanosecondes() - t0;
+    t0 = nanosecondes();
+    for (uint32_t i = 0; i < NB_RECHERCHES; i++) {
+        lv_point_t p = points[i];
+        somme += (uintptr_t)lv_indev_hit_index_search(scr, &p);
+    }
+    uint64_t grille = nanosecondes() - t0;
+    TEST_ASSERT_TRUE(grilleUtilisee(scr));
+
+    snprintf(msg, sizeof(msg), "recherche récursive %u ns, grille %u ns, construction %u µs",
+             (unsigned)(recursive / NB_RECHERCHES), (unsigned)(grille / NB_RECHERCHES), (unsigned)(construction / 1000));
+    TEST_MESSAGE(msg);
+}
+
+#endif /*LV_USE_INDEV_HIT_INDEX*/
+
+int main(void)
+{
+    UNITY_BEGIN();
+#if LV_USE_INDEV_HIT_INDEX
+    RUN_TEST(test_chevauchements);
+    RUN_TEST(test_caches);
+    RUN_TEST(test_defilement);
+    RUN_TEST(test_transformes);
+    RUN_TEST(test_benchmark);
+#endif
+    return UNITY_END();
+}
@@ -0,0 +1,249 @@
+// Tests du cache des images décodées (lv_image_cache) : le rendu doit être identique avec ou sans cache,
+// les images épinglées ne sont pas évincées et celles trop grandes pour le cache n'y entrent pas.
+// Lancement : pio test -e native -f native/test_image_cache
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+
+// Somme de contrôle des images de la scène, relevée avec le code d'avant le cache (cache désactivé)
+#define CONTROLE_SCENE  0x18C08119u
+
+#define NB_IMAGES       100
+#define NB_PICTOS       24
+#define NB_VISIBLES     8
+
+// Indexées comme les ressources de l'application : une photo plein écran (I8), un logo (I8)
+// et des pictogrammes (I4) qui défilent, 8 visibles à la fois
+static uint8_t donneesPhoto[256 * 4 + 480 * 272];
+static uint8_t donneesLogo[256 * 4 + 200 * 60];
+static uint8_t donneesPictos[NB_PICTOS][16 * 4 + 48 * 64];
+static lv_image_dsc_t photo;
+static lv_image_dsc_t logo;
+static lv_image_dsc_t pictos[NB_PICTOS];
+
+static uint32_t ecran[480 * 272];
+static uint32_t tampon[480 * 272 / 10];
+static uint64_t tas[8][120 * 1024 / 8];    // Les images décodées sont allouées dans le tas (pools de 128 ko au plus)
+static lv_display_t *disp;
+static lv_obj_t *objetsPictos[NB_VISIBLES];
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void flush(lv_display_t *d, const lv_area_t *zone, uint8_t *px)
+{
+    const uint32_t *p = (const uint32_t *)px;
+    for (int32_t y = zone->y1; y <= zone->y2; y++) {
+        for (int32_t x = zone->x1; x <= zone->x2; x++) ecran[y * 480 + x] = *p++;
+    }
+    lv_display_flush_ready(d);
+}
+
+// FNV-1a de l'écran
+static uint32_t controlerEcran(void)
+{
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < 480 * 272; i++) h = (h ^ ecran[i]) * 16777619u;
+    return h;
+}
+
+// Image indexée avec une palette (la couleur 0 est transparente) et un motif calculés
+static void creerImage(lv_image_dsc_t *dsc, uint8_t *donnees, uint32_t largeur, uint32_t hauteur,
+                       lv_color_format_t cf, uint32_t graine)
+{
+    uint32_t bpp = cf == LV_COLOR_FORMAT_I4 ? 4 : 8;
+    uint32_t couleurs = 1u << bpp;
+    uint32_t stride = (largeur * bpp + 7) / 8;
+    for (uint32_t i = 0; i < couleurs; i++) {
+        donnees[i * 4 + 0] = (uint8_t)(i * 37 + graine * 11);
+        donnees[i * 4 + 1] = (uint8_t)(i * 91 + graine * 5);
+        donnees[i * 4 + 2] = (uint8_t)(i * 13 + graine * 71);
+        donnees[i * 4 + 3] = i == 0 ? 0 : 0xFF;
+    }
+    uint8_t *px = donnees + couleurs * 4;
+    for (uint32_t y = 0; y < hauteur; y++) {
+        for (uint32_t x = 0; x < stride; x++) px[y * stride + x] = (uint8_t)((x * 7 + y * 3 + graine) * 29);
+    }
+    lv_memzero(dsc, sizeof(*dsc));
+    dsc->header.magic = LV_IMAGE_HEADER_MAGIC;
+    dsc->header.cf = cf;
+    dsc->header.w = largeur;
+    dsc->header.h = hauteur;
+    dsc->header.stride = stride;
+    dsc->data = donnees;
+    dsc->data_size = couleurs * 4 + stride * hauteur;
+}
+
+void setUp(void)
+{
+    lv_init();
+    for (uint32_t i = 0; i < 8; i++) lv_mem_add_pool(tas[i], sizeof(tas[i]));
+    disp = lv_display_create(480, 272);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);   // 32 bits comme le projet
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_set_buffers(disp, tampon, NULL, sizeof(tampon), LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    creerImage(&photo, donneesPhoto, 480, 272, LV_COLOR_FORMAT_I8, 99);
+    creerImage(&logo, donneesLogo, 200, 60, LV_COLOR_FORMAT_I8, 1);
+    for (uint32_t i = 0; i < NB_PICTOS; i++) {
+        creerImage(&pictos[i], donneesPictos[i], 64 + (i % 3) * 16, 64, LV_COLOR_FORMAT_I4, i + 2);
+    }
+
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_t *fond = lv_image_create(scr);
+    lv_image_set_src(fond, &photo);
+    lv_obj_t *objetLogo = lv_image_create(scr);
+    lv_image_set_src(objetLogo, &logo);
+    lv_obj_set_pos(objetLogo, 10, 10);
+    for (uint32_t i = 0; i < NB_VISIBLES; i++) {
+        objetsPictos[i] = lv_image_create(scr);
+        lv_obj_set_pos(objetsPictos[i], 10 + i * 58, 120 + (i % 2) * 70);
+    }
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+// Rend la scène, les pictogrammes changent toutes les 4 images. Si vider est vrai, les images du
+// cache sont supprimées au milieu. Retourne la somme de contrôle des images et la durée moyenne d'une image.
+static uint32_t rendre(bool vider, uint64_t *nsParImage)
+{
+    uint32_t h = 2166136261u;
+    uint64_t ns = 0;
+    for (uint32_t f = 0; f < NB_IMAGES; f++) {
+        for (uint32_t i = 0; i < NB_VISIBLES; i++) lv_image_set_src(objetsPictos[i], &pictos[(i + f / 4 * 3) % NB_PICTOS]);
+        if (vider && f == NB_IMAGES / 2) lv_image_cache_drop(NULL);
+        lv_obj_invalidate(lv_screen_active());
+        uint64_t t0 = nanosecondes();
+        lv_refr_now(disp);
+        ns += nanosecondes() - t0;
+        h = (h ^ controlerEcran()) * 16777619u;
+    }
+    if (nsParImage) *nsParImage = ns / NB_IMAGES;
+    return h;
+}
+
+// Sans cache : chaque image est décodée à chaque fois qu'elle est dessinée
+static void test_sans_cache(void)
+{
+    lv_image_cache_resize(0, true);
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_SCENE, rendre(false, NULL));
+    lv_image_cache_info_t info;
+    lv_image_cache_get_info(&info);
+    TEST_ASSERT_EQUAL_UINT32(0, info.entry_cnt);
+}
+
+// 512 ko comme sur la carte : le logo et les pictogrammes sont décodés une fois,
+// la photo (plus d'un quart du cache) est dessinée ligne par ligne sans y entrer
+static void test_cache_du_projet(void)
+{
+    lv_image_cache_resize(512 * 1024, true);
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_SCENE, rendre(false, NULL));
+    lv_image_cache_info_t info;
+    lv_image_cache_get_info(&info);
+    TEST_ASSERT_FALSE(lv_image_cache_is_cacheable(480 * 272 * 4));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(1 + NB_PICTOS, info.entry_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(info.max_size, info.size);
+    TEST_ASSERT_GREATER_THAN_UINT32(10 * info.miss_cnt, info.hit_cnt);
+}
+
+// 256 ko : les pictogrammes s'évincent les uns les autres, le logo épinglé reste dans le cache
+static void test_epingle(void)
+{
+    lv_image_cache_resize(256 * 1024, true);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_cache_pin(&logo));
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_SCENE, rendre(false, NULL));
+    lv_image_cache_info_t info;
+    lv_image_cache_get_info(&info);
+    TEST_ASSERT_EQUAL_UINT32(1, info.pinned_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(200 * 60 * 4, info.pinned_size);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(info.max_size, info.size);
+
+    // Une image qui ne peut pas entrer dans le cache n'est pas épinglée
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_image_cache_pin(&photo));
+
+    lv_image_cache_unpin(&logo);
+    lv_image_cache_get_info(&info);
+    TEST_ASSERT_EQUAL_UINT32(0, info.pinned_cnt);
+}
+
+// Supprimer toutes les images au milieu du rendu, l'image épinglée aussi
+static void test_vider(void)
+{
+    lv_image_cache_resize(512 * 1024, true);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_cache_pin(&logo));
+    lv_image_cache_drop(&logo);
+    lv_image_cache_info_t info;
+    lv_image_cache_get_info(&info);
+    TEST_ASSERT_EQUAL_UINT32(0, info.pinned_cnt);
+
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_SCENE, rendre(true, NULL));
+    lv_image_cache_get_info(&info);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, info.entry_cnt);
+
+    // Réduire le cache à 0 libère toutes les images
+    lv_image_cache_resize(0, true);
+    lv_image_cache_get_info(&info);
+    TEST_ASSERT_EQUAL_UINT32(0, info.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, info.size);
+}
+
+// Tas presque plein : les images qui ne peuvent pas être converties d'un coup sont lues ligne par ligne
+static void test_memoire_pleine(void)
+{
+    static void *blocs[128];
+    uint32_t nb = 0;
+    while (nb < 128 && (blocs[nb] = lv_malloc(16 * 1024)) != NULL) nb++;
+    for (uint32_t i = 0; i < 6 && nb > 0; i++) lv_free(blocs[--nb]);  // Reste pour le rendu
+
+    lv_image_cache_resize(512 * 1024, true);
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_SCENE, rendre(false, NULL));
+    lv_image_cache_info_t info;
+    lv_image_cache_get_info(&info);
+    TEST_ASSERT_LESS_THAN_UINT32(NB_PICTOS, info.entry_cnt);
+
+    while (nb > 0) lv_free(blocs[--nb]);
+}
+
+static void test_benchmark(void)
+{
+    static const uint32_t budgets[] = {0, 256 * 1024, 512 * 1024};
+    char msg[128];
+    for (uint32_t k = 0; k < 3; k++) {
+        if (k > 0) {
+            tearDown();
+            setUp();
+        }
+        lv_image_cache_resize(budgets[k], true);
+        uint64_t ns;
+        rendre(false, &ns);
+        lv_image_cache_info_t info;
+        lv_image_cache_get_info(&info);
+        uint32_t total = info.hit_cnt + info.miss_cnt;
+        snprintf(msg, sizeof(msg), "cache %6u octets : %6u µs par image, %3u %% trouvées dans le cache, %6u octets utilisés",
+                 (unsigned)budgets[k], (unsigned)(ns / 1000), (unsigned)(total ? info.hit_cnt * 100 / total : 0),
+                 (unsigned)info.size);
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_sans_cache);
+    RUN_TEST(test_cache_du_projet);
+    RUN_TEST(test_epingle);
+    RUN_TEST(test_vider);
+    RUN_TEST(test_memoire_pleine);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,192 @@
+// Kerning par paires converti en classes (lv_font_fmt_txt_kern_classes_create) : mêmes valeurs que la police
+// d'origine pour toutes les paires de glyphes, et temps de mesure de labels longs et d'un tableau.
+// Lancement : pio test -e native -f native/test_kerning
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+
+#define MAX_GLYPHES     256              // Les paires converties ont des identifiants de glyphes sur 8 bits
+#define NB_MESURES      2000
+
+// Copie de Montserrat 14 dont le kerning par classes est remplacé par des paires, puis par les classes converties
+static lv_font_fmt_txt_dsc_t dscPaires;
+static lv_font_fmt_txt_dsc_t dscConverti;
+static lv_font_t policePaires;
+static lv_font_t policeConvertie;
+static lv_font_fmt_txt_kern_pair_t paires;
+static uint8_t identifiants[MAX_GLYPHES * MAX_GLYPHES * 2];
+static int8_t valeurs[MAX_GLYPHES * MAX_GLYPHES];
+static lv_font_fmt_txt_kern_classes_t *classes;
+static uint32_t nbGlyphes;
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Nombre de glyphes de la police d'après ses plages de caractères
+static uint32_t compterGlyphes(const lv_font_fmt_txt_dsc_t *dsc)
+{
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < dsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t *cmap = &dsc->cmaps[i];
+        uint32_t nb = cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY ? cmap->range_length : cmap->list_length;
+        if (cmap->glyph_id_start + nb > n) n = cmap->glyph_id_start + nb;
+    }
+    return n;
+}
+
+// Toutes les paires de valeur non nulle, triées par glyphe gauche puis droit comme le convertisseur de polices
+static void creerPaires(const lv_font_fmt_txt_dsc_t *dsc)
+{
+    const lv_font_fmt_txt_kern_classes_t *kc = dsc->kern_dsc;
+    uint32_t n = 0;
+    for (uint32_t g = 1; g < nbGlyphes; g++) {
+        for (uint32_t d = 1; d < nbGlyphes; d++) {
+            uint8_t cg = kc->left_class_mapping[g];
+            uint8_t cd = kc->right_class_mapping[d];
+            if (cg == 0 || cd == 0) continue;
+            int8_t v = kc->class_pair_values[(cg - 1) * kc->right_class_cnt + (cd - 1)];
+            if (v == 0) continue;
+            identifiants[n * 2] = (uint8_t)g;
+            identifiants[n * 2 + 1] = (uint8_t)d;
+            valeurs[n] = v;
+            n++;
+        }
+    }
+    paires.glyph_ids = identifiants;
+    paires.values = valeurs;
+    paires.pair_cnt = n;
+    paires.glyph_ids_size = 0;
+}
+
+void setUp(void)
+{
+    lv_init();
+    const lv_font_fmt_txt_dsc_t *origine = lv_font_montserrat_14.dsc;
+    nbGlyphes = compterGlyphes(origine);
+    creerPaires(origine);
+
+    dscPaires = *origine;
+    dscPaires.kern_dsc = &paires;
+    dscPaires.kern_classes = 0;
+    policePaires = lv_font_montserrat_14;
+    policePaires.dsc = &dscPaires;
+
+    classes = lv_font_fmt_txt_kern_classes_create(&paires, nbGlyphes);
+    dscConverti = *origine;
+    dscConverti.kern_dsc = classes;
+    dscConverti.kern_classes = 1;
+    policeConvertie = lv_font_montserrat_14;
+    policeConvertie.dsc = &dscConverti;
+}
+
+void tearDown(void)
+{
+    lv_font_fmt_txt_kern_classes_delete(classes);
+    lv_deinit();
+}
+
+// Caractères de la police : ASCII, degré, puce et symboles
+static uint32_t caracteres(uint32_t *liste)
+{
+    const lv_font_fmt_txt_dsc_t *dsc = lv_font_montserrat_14.dsc;
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < dsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t *cmap = &dsc->cmaps[i];
+        if (cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+            for (uint32_t k = 0; k < cmap->range_length; k++) liste[n++] = cmap->range_start + k;
+        }
+        else {
+            for (uint32_t k = 0; k < cmap->list_length; k++) liste[n++] = cmap->range_start + cmap->unicode_list[k];
+        }
+    }
+    return n;
+}
+
+// Les paires et les classes converties donnent la largeur de la police d'origine pour chaque paire de caractères
+static void test_valeurs(void)
+{
+    static uint32_t liste[MAX_GLYPHES];
+    char msg[128];
+    TEST_ASSERT_NOT_NULL(classes);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(MAX_GLYPHES, nbGlyphes);
+    uint32_t nb = caracteres(liste);
+    TEST_ASSERT_EQUAL_UINT32(nbGlyphes - 1, nb);
+
+    uint32_t differents = 0;
+    for (uint32_t i = 0; i < nb; i++) {
+        for (uint32_t j = 0; j < nb; j++) {
+            uint16_t attendu = lv_font_get_glyph_width(&lv_font_montserrat_14, liste[i], liste[j]);
+            snprintf(msg, sizeof(msg), "U+%04X U+%04X", (unsigned)liste[i], (unsigned)liste[j]);
+            TEST_ASSERT_EQUAL_UINT32_MESSAGE(attendu, lv_font_get_glyph_width(&policePaires, liste[i], liste[j]), msg);
+            TEST_ASSERT_EQUAL_UINT32_MESSAGE(attendu, lv_font_get_glyph_width(&policeConvertie, liste[i], liste[j]), msg);
+            if (attendu != lv_font_get_glyph_width(&lv_font_montserrat_14, liste[i], 0)) differents++;
+        }
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(0, differents);
+
+    snprintf(msg, sizeof(msg), "%u paires converties en %u x %u classes, %u paires de caractères crénées",
+             (unsigned)paires.pair_cnt, (unsigned)classes->left_class_cnt, (unsigned)classes->right_class_cnt,
+             (unsigned)differents);
+    TEST_MESSAGE(msg);
+}
+
+// Des paires trop nombreuses ou avec un glyphe hors de la police ne sont pas converties
+static void test_refus(void)
+{
+    TEST_ASSERT_NULL(lv_font_fmt_txt_kern_classes_create(&paires, 10));
+
+    lv_font_fmt_txt_kern_pair_t larges = paires;
+    larges.glyph_ids_size = 1;
+    TEST_ASSERT_NULL(lv_font_fmt_txt_kern_classes_create(&larges, nbGlyphes));
+}
+
+// Mesure de labels longs et des cellules d'un tableau avec chaque police
+static void test_benchmark(void)
+{
+    static const char *const label =
+        "Entree avec mot de passe requis : tapez le code puis Valider. AVAT Tw Yo LT Fa P. \"Voitures\" : 12/40";
+    static const char *const cellules[] = {"Place", "A12", "Libre", "Temps", "07:45", "Tarif", "2,50", "LAVAGE", "VT", "Yves"};
+    const lv_font_t *polices[3] = {&lv_font_montserrat_14, &policePaires, &policeConvertie};
+    static const char *const noms[3] = {"classes d'origine", "paires", "classes converties"};
+    char msg[128];
+
+    for (uint32_t p = 0; p < 3; p++) {
+        uint32_t caracteresLabel = strlen(label);
+        uint64_t t0 = nanosecondes();
+        for (uint32_t n = 0; n < NB_MESURES; n++) lv_text_get_width(label, caracteresLabel, polices[p], 0);
+        uint64_t nsLabel = (nanosecondes() - t0) / NB_MESURES;
+
+        uint32_t caracteresTableau = 0;
+        t0 = nanosecondes();
+        for (uint32_t n = 0; n < NB_MESURES; n++) {
+            for (uint32_t i = 0; i < sizeof(cellules) / sizeof(cellules[0]); i++) {
+                uint32_t l = strlen(cellules[i]);
+                lv_text_get_width(cellules[i], l, polices[p], 0);
+                if (n == 0) caracteresTableau += l;
+            }
+        }
+        uint64_t nsTableau = (nanosecondes() - t0) / NB_MESURES;
+
+        snprintf(msg, sizeof(msg), "%-18s : label %u ns (%u ns par caractère), tableau %u ns (%u ns par caractère)",
+                 noms[p], (unsigned)nsLabel, (unsigned)(nsLabel / caracteresLabel),
+                 (unsigned)nsTableau, (unsigned)(nsTableau / caracteresTableau));
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_valeurs);
+    RUN_TEST(test_refus);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,180 @@
+// Mise à jour de la mise en page limitée aux sous-arbres modifiés (layout_child_inv) sur un tableau de bord :
+// mêmes coordonnées qu'avant après 2000 mises à jour, et temps d'une mise à jour.
+// Lancement : pio test -e native -f native/test_layout
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+
+// Relevé avant la limitation aux sous-arbres modifiés, identique après
+#define CONTROLE_COORDONNEES    0x7964BF79u
+
+#define NB_CARTES       34
+#define NB_MISES_A_JOUR 2000
+
+static uint32_t tampon[480 * 272 / 10];
+static lv_display_t *disp;
+static lv_obj_t *horloge;
+static lv_obj_t *cartes[NB_CARTES];
+static lv_obj_t *valeurs[NB_CARTES];
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void flush(lv_display_t *d, const lv_area_t *zone, uint8_t *px)
+{
+    LV_UNUSED(zone);
+    LV_UNUSED(px);
+    lv_display_flush_ready(d);
+}
+
+// FNV-1a des coordonnées de tous les objets, en préordre
+static uint32_t controlerCoordonnees(lv_obj_t *obj, uint32_t h)
+{
+    lv_area_t zone;
+    lv_obj_get_coords(obj, &zone);
+    const int32_t c[4] = {zone.x1, zone.y1, zone.x2, zone.y2};
+    for (uint32_t i = 0; i < 4; i++) h = (h ^ (uint32_t)c[i]) * 16777619u;
+    uint32_t nb = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < nb; i++) h = controlerCoordonnees(lv_obj_get_child(obj, i), h);
+    return h;
+}
+
+static uint32_t compterObjets(lv_obj_t *obj)
+{
+    uint32_t n = 1;
+    uint32_t nb = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < nb; i++) n += compterObjets(lv_obj_get_child(obj, i));
+    return n;
+}
+
+void setUp(void)
+{
+    lv_init();
+    disp = lv_display_create(480, 272);
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_set_buffers(disp, tampon, NULL, sizeof(tampon), LV_DISPLAY_RENDER_MODE_PARTIAL);
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+// Barre d'état en flex, corps en flex avec retour à la ligne de cartes à la taille de leur contenu,
+// panneau en grille et pied de page en pourcentages
+static void creerTableauDeBord(void)
+{
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_set_flex_flow(scr, LV_FLEX_FLOW_COLUMN);
+
+    lv_obj_t *barre = lv_obj_create(scr);
+    lv_obj_set_size(barre, lv_pct(100), LV_SIZE_CONTENT);
+    lv_obj_set_flex_flow(barre, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(barre, LV_FLEX_ALIGN_SPACE_BETWEEN, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    static const char *const etats[] = {"Parking", "Wifi", "Capteurs OK", "Entrée", "Sortie", "Alarme"};
+    for (uint32_t i = 0; i < 6; i++) lv_label_set_text(lv_label_create(barre), etats[i]);
+    horloge = lv_label_create(barre);
+    lv_label_set_text(horloge, "00:00:00");
+
+    lv_obj_t *corps = lv_obj_create(scr);
+    lv_obj_set_width(corps, lv_pct(100));
+    lv_obj_set_flex_grow(corps, 1);
+    lv_obj_set_flex_flow(corps, LV_FLEX_FLOW_ROW_WRAP);
+    for (uint32_t i = 0; i < NB_CARTES; i++) {
+        lv_obj_t *carte = lv_obj_create(corps);
+        lv_obj_set_size(carte, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(carte, LV_FLEX_FLOW_COLUMN);
+        lv_label_set_text_fmt(lv_label_create(carte), "Place %u", (unsigned)i);
+        valeurs[i] = lv_label_create(carte);
+        lv_label_set_text(valeurs[i], "libre");
+        lv_obj_t *barreRemplissage = lv_bar_create(carte);
+        lv_obj_set_size(barreRemplissage, 80, 8);
+        lv_bar_set_value(barreRemplissage, (int32_t)(i * 4), LV_ANIM_OFF);
+        lv_obj_t *ligne = lv_obj_create(carte);
+        lv_obj_set_size(ligne, lv_pct(100), 20);
+        lv_obj_t *icone = lv_obj_create(ligne);
+        lv_obj_set_size(icone, 12, 12);
+        lv_obj_align(icone, LV_ALIGN_RIGHT_MID, 0, 0);
+        cartes[i] = carte;
+    }
+
+    static const int32_t colonnes[] = {LV_GRID_FR(1), LV_GRID_FR(2), LV_GRID_FR(1), LV_GRID_TEMPLATE_LAST};
+    static const int32_t lignes[] = {LV_GRID_CONTENT, LV_GRID_CONTENT, LV_GRID_CONTENT, LV_GRID_TEMPLATE_LAST};
+    lv_obj_t *grille = lv_obj_create(corps);
+    lv_obj_set_size(grille, lv_pct(90), LV_SIZE_CONTENT);
+    lv_obj_set_grid_dsc_array(grille, colonnes, lignes);
+    for (uint32_t i = 0; i < 9; i++) {
+        lv_obj_t *label = lv_label_create(grille);
+        lv_label_set_text_fmt(label, "Entrée %u", (unsigned)i);
+        lv_obj_set_grid_cell(label, LV_GRID_ALIGN_STRETCH, (int32_t)(i % 3), 1, LV_GRID_ALIGN_CENTER, (int32_t)(i / 3), 1);
+    }
+
+    lv_obj_t *pied = lv_obj_create(scr);
+    lv_obj_set_size(pied, lv_pct(100), 40);
+    for (uint32_t i = 0; i < 4; i++) {
+        lv_obj_t *bouton = lv_button_create(pied);
+        lv_obj_set_size(bouton, lv_pct(22), lv_pct(100));
+        lv_obj_set_x(bouton, lv_pct(25 * (int32_t)i));
+        lv_label_set_text(lv_label_create(bouton), "Menu");
+    }
+    lv_obj_update_layout(scr);
+}
+
+// Heure, valeur d'une carte ou largeur d'une carte selon n
+static void mettreAJour(uint32_t type, uint32_t n)
+{
+    switch (type) {
+        case 0:
+            lv_label_set_text_fmt(horloge, "%02u:%02u:%02u", (unsigned)(n / 3600 % 24), (unsigned)(n / 60 % 60), (unsigned)(n % 60));
+            break;
+        case 1:
+            lv_label_set_text(valeurs[n % NB_CARTES], (n / NB_CARTES) % 2 ? "occupée" : "libre");
+            break;
+        default:
+            lv_obj_set_width(cartes[n % NB_CARTES], (n / NB_CARTES) % 2 ? LV_SIZE_CONTENT : 140);
+            break;
+    }
+    lv_obj_update_layout(lv_screen_active());
+}
+
+static void test_coordonnees(void)
+{
+    creerTableauDeBord();
+    uint32_t h = controlerCoordonnees(lv_screen_active(), 2166136261u);
+    for (uint32_t n = 0; n < NB_MISES_A_JOUR; n++) {
+        mettreAJour(n % 3, n / 3);
+        if (n % 100 == 99) h = controlerCoordonnees(lv_screen_active(), h);
+    }
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_COORDONNEES, h);
+}
+
+static void test_benchmark(void)
+{
+    static const char *const noms[] = {"heure dans la barre d'état", "valeur d'une carte", "largeur d'une carte"};
+    char msg[128];
+    creerTableauDeBord();
+    snprintf(msg, sizeof(msg), "%u objets", (unsigned)compterObjets(lv_screen_active()));
+    TEST_MESSAGE(msg);
+    for (uint32_t type = 0; type < 3; type++) {
+        uint64_t t0 = nanosecondes();
+        for (uint32_t n = 0; n < NB_MISES_A_JOUR; n++) mettreAJour(type, n);
+        uint64_t ns = (nanosecondes() - t0) / NB_MISES_A_JOUR;
+        snprintf(msg, sizeof(msg), "%-28s : %u ns par mise à jour", noms[type], (unsigned)ns);
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_coordonnees);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,166 @@
+// Tests des masques de fondu et des masques bitmap (lv_draw_sw_mask_apply), comparés bit à bit aux
+// sommes de contrôle relevées avec le code C (LV_DRAW_SW_ASM_NONE).
+// Lancement : pio test -e native -f native/test_mask       (code C)
+//             pio test -e native_x86 -f native/test_mask   (SSE2)
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+#include "src/lvgl_private.h"            // Masques logiciels (API privée LVGL)
+
+// Relevés avec LV_DRAW_SW_ASM_NONE
+#define CONTROLE_MELANGES   0xE9FD6BE9u
+#define CONTROLE_ALEATOIRE  0xFA8678FDu
+
+static uint8_t carte[256 * 256];
+static uint32_t graine;
+
+static uint32_t aleatoire(void)
+{
+    graine = graine * 1103515245u + 12345u;
+    return graine >> 8;
+}
+
+// Valeurs d'alpha aux limites des arrondis, une fois sur deux
+static uint8_t alphaAleatoire(void)
+{
+    static const uint8_t speciaux[] = {0, 1, 2, 3, 4, 127, 128, 129, 250, 251, 252, 253, 254, 255};
+    if (aleatoire() & 1) return speciaux[aleatoire() % sizeof(speciaux)];
+    return (uint8_t)aleatoire();
+}
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// FNV-1a
+static uint32_t controler(uint32_t h, const void *p, size_t taille)
+{
+    const uint8_t *o = (const uint8_t *)p;
+    for (size_t i = 0; i < taille; i++) h = (h ^ o[i]) * 16777619u;
+    return h;
+}
+
+void setUp(void)
+{
+    lv_init();
+    graine = 1;
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+// Toutes les paires (masque, opacité) : par le masque bitmap (une opacité par pixel)
+// puis par le masque de fondu (une opacité par ligne)
+static void test_tous_les_melanges(void)
+{
+    uint8_t ligne[256];
+    uint32_t h = 2166136261u;
+
+    for (uint32_t i = 0; i < sizeof(carte); i++) carte[i] = (uint8_t)(i >> 8);
+    lv_area_t zone = {0, 0, 255, 255};
+    lv_draw_sw_mask_map_param_t map;
+    lv_draw_sw_mask_map_init(&map, &zone, carte);
+    void *masques[2] = {&map, NULL};
+    for (int32_t y = 0; y < 256; y++) {
+        for (uint32_t i = 0; i < 256; i++) ligne[i] = (uint8_t)i;
+        int32_t res = lv_draw_sw_mask_apply(masques, ligne, 0, y, 256);
+        h = controler(h, &res, sizeof(res));
+        h = controler(h, ligne, sizeof(ligne));
+    }
+
+    lv_draw_sw_mask_fade_param_t fondu;
+    lv_draw_sw_mask_fade_init(&fondu, &zone, 0, 0, 255, 255);
+    masques[0] = &fondu;
+    for (int32_t y = 0; y < 256; y++) {
+        for (uint32_t i = 0; i < 256; i++) ligne[i] = (uint8_t)i;
+        int32_t res = lv_draw_sw_mask_apply(masques, ligne, 0, y, 256);
+        h = controler(h, &res, sizeof(res));
+        h = controler(h, ligne, sizeof(ligne));
+    }
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_MELANGES, h);
+}
+
+// Fondu et bitmap seuls ou combinés, sur des lignes de position et de longueur aléatoires,
+// qui débordent de la zone des masques
+static void test_cas_aleatoires(void)
+{
+    uint8_t ligne[200];
+    uint32_t h = 2166136261u;
+
+    for (uint32_t n = 0; n < 5000; n++) {
+        lv_area_t zone;
+        zone.x1 = aleatoire() % 20;
+        zone.y1 = aleatoire() % 10;
+        zone.x2 = zone.x1 + 1 + aleatoire() % 99;
+        zone.y2 = zone.y1 + 1 + aleatoire() % 39;
+        for (uint32_t i = 0; i < 100 * 40; i++) carte[i] = alphaAleatoire();
+
+        lv_draw_sw_mask_fade_param_t fondu;
+        lv_draw_sw_mask_map_param_t map;
+        lv_draw_sw_mask_fade_init(&fondu, &zone, alphaAleatoire(), zone.y1 + aleatoire() % 10, alphaAleatoire(),
+                                  zone.y2 - aleatoire() % 10);
+        lv_draw_sw_mask_map_init(&map, &zone, carte);
+        void *masques[3] = {&fondu, &map, NULL};
+        if (aleatoire() & 1) {
+            masques[0] = &map;
+            masques[1] = (aleatoire() & 1) ? &fondu : NULL;
+        }
+
+        for (int32_t y = -2; y < 52; y++) {
+            int32_t x = aleatoire() % 30;
+            int32_t longueur = 1 + aleatoire() % 150;
+            for (int32_t i = 0; i < longueur; i++) ligne[i] = alphaAleatoire();
+            int32_t res = lv_draw_sw_mask_apply(masques, ligne, x, y, longueur);
+            h = controler(h, &res, sizeof(res));
+            h = controler(h, ligne, longueur);
+        }
+    }
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_ALEATOIRE, h);
+}
+
+// Lignes de 480 pixels sur 16 lignes, en ns par pixel
+static void test_benchmark(void)
+{
+    static uint8_t ligne[480];
+    char msg[96];
+    for (uint32_t i = 0; i < 480 * 16; i++) carte[i] = (uint8_t)aleatoire();
+    lv_area_t zone = {0, 0, 479, 15};
+    lv_draw_sw_mask_fade_param_t fondu;
+    lv_draw_sw_mask_map_param_t map;
+    lv_draw_sw_mask_fade_init(&fondu, &zone, 255, 0, 0, 15);
+    lv_draw_sw_mask_map_init(&map, &zone, carte);
+
+    for (uint32_t k = 0; k < 2; k++) {
+        void *masques[2] = {k ? (void *)&map : (void *)&fondu, NULL};
+        uint64_t ns = 0;
+        for (uint32_t r = 0; r < 2000; r++) {
+            for (int32_t y = 0; y < 16; y++) {
+                memset(ligne, 200, sizeof(ligne));
+                uint64_t t0 = nanosecondes();
+                lv_draw_sw_mask_apply(masques, ligne, 0, y, 480);
+                ns += nanosecondes() - t0;
+            }
+        }
+        snprintf(msg, sizeof(msg), "masque %s : %.3f ns par pixel", k ? "bitmap" : "de fondu",
+                 (double)ns / (2000.0 * 480 * 16));
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_tous_les_melanges);
+    RUN_TEST(test_cas_aleatoires);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,164 @@
+// Tests du cache des coins d'ombre et des cercles du rendu logiciel (LV_DRAW_SW_MASK_CACHE_SIZE) :
+// le rendu doit être identique quel que soit le budget du cache.
+// Lancement : pio test -e native -f native/test_mask_cache
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+#include "src/lvgl_private.h"            // Cache des masques (API privée LVGL)
+
+// Somme de contrôle des 200 images de la scène, relevée avec le code d'avant le cache
+#define CONTROLE_SCENE  0xC94AC9D3u
+
+#define NB_IMAGES       200
+#define NB_WIDGETS      12
+
+static uint32_t ecran[480 * 272];
+static uint32_t tampon[480 * 272 / 10];
+static lv_display_t *disp;
+static lv_obj_t *widgets[NB_WIDGETS];
+static lv_obj_t *arc;
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void flush(lv_display_t *d, const lv_area_t *zone, uint8_t *px)
+{
+    const uint32_t *p = (const uint32_t *)px;
+    for (int32_t y = zone->y1; y <= zone->y2; y++) {
+        for (int32_t x = zone->x1; x <= zone->x2; x++) ecran[y * 480 + x] = *p++;
+    }
+    lv_display_flush_ready(d);
+}
+
+// FNV-1a de l'écran
+static uint32_t controlerEcran(void)
+{
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < 480 * 272; i++) h = (h ^ ecran[i]) * 16777619u;
+    return h;
+}
+
+void setUp(void)
+{
+    lv_init();
+    disp = lv_display_create(480, 272);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);   // 32 bits comme le projet
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_set_buffers(disp, tampon, NULL, sizeof(tampon), LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    // Widgets arrondis avec ombre et bordure, et un arc
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0xEEEEEE), 0);
+    for (uint32_t i = 0; i < NB_WIDGETS; i++) {
+        lv_obj_t *o = lv_obj_create(scr);
+        lv_obj_remove_style_all(o);
+        lv_obj_set_style_bg_opa(o, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(o, lv_palette_main((lv_palette_t)(i % 16)), 0);
+        lv_obj_set_style_radius(o, 4 + (i % 4) * 6, 0);
+        lv_obj_set_style_shadow_width(o, 6 + (i % 3) * 10, 0);
+        lv_obj_set_style_shadow_spread(o, i % 2 * 3, 0);
+        lv_obj_set_style_shadow_offset_y(o, 4, 0);
+        lv_obj_set_style_shadow_opa(o, LV_OPA_50, 0);
+        lv_obj_set_style_border_width(o, i % 3, 0);
+        lv_obj_set_style_border_color(o, lv_color_black(), 0);
+        lv_obj_set_pos(o, 20 + (i % 4) * 115, 20 + (i / 4) * 85);
+        widgets[i] = o;
+    }
+    arc = lv_arc_create(scr);
+    lv_obj_set_size(arc, 70, 70);
+    lv_obj_set_pos(arc, 390, 190);
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+// Rend la scène avec le budget donné, les tailles des widgets changent à chaque image.
+// Retourne la somme de contrôle des images et la durée moyenne d'une image.
+static uint32_t rendre(uint32_t budget, uint64_t *nsParImage)
+{
+    lv_cache_set_max_size(LV_GLOBAL_DEFAULT()->sw_mask_cache, budget, NULL);
+    uint32_t h = 2166136261u;
+    uint64_t ns = 0;
+    for (uint32_t f = 0; f < NB_IMAGES; f++) {
+        for (uint32_t i = 0; i < NB_WIDGETS; i++) {
+            // Quelques tailles qui reviennent, certaines plus petites que les coins d'ombre
+            lv_obj_set_size(widgets[i], 30 + ((f + i) % 5) * 15, 20 + ((f / 3 + i) % 4) * 12);
+        }
+        lv_arc_set_value(arc, f % 100);
+        lv_obj_update_layout(lv_screen_active());
+        lv_obj_invalidate(lv_screen_active());
+        uint64_t t0 = nanosecondes();
+        lv_refr_now(disp);
+        ns += nanosecondes() - t0;
+        h = (h ^ controlerEcran()) * 16777619u;
+    }
+    if (nsParImage) *nsParImage = ns / NB_IMAGES;
+    return h;
+}
+
+// Sans cache : tout est recalculé à chaque image
+static void test_sans_cache(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_SCENE, rendre(0, NULL));
+}
+
+// 600 octets : les entrées sont sans cesse évincées ou calculées dans un tampon temporaire (pas plus rapide que sans cache)
+static void test_petit_budget(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_SCENE, rendre(600, NULL));
+    lv_draw_sw_mask_cache_info_t info;
+    lv_draw_sw_mask_cache_get_info(&info);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(600, info.size);
+}
+
+// 8 ko comme sur la carte : la plupart des cercles et des ombres sont trouvés dans le cache
+static void test_budget_du_projet(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_SCENE, rendre(8 * 1024, NULL));
+    lv_draw_sw_mask_cache_info_t info;
+    lv_draw_sw_mask_cache_get_info(&info);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(8 * 1024, info.size);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(info.miss_cnt, info.hit_cnt);
+}
+
+// Durée d'une image selon le budget : le cache ne fait gagner du temps qu'à partir de 4 ko,
+// la scène tient dans 8 ko (LV_DRAW_SW_MASK_CACHE_SIZE du projet) et un budget plus grand ne gagne plus rien
+static void test_benchmark(void)
+{
+    static const uint32_t budgets[] = {0, 600, 2 * 1024, 4 * 1024, 6 * 1024, 8 * 1024, 16 * 1024};
+    char msg[128];
+    for (uint32_t k = 0; k < sizeof(budgets) / sizeof(budgets[0]); k++) {
+        if (k > 0) {
+            tearDown();
+            setUp();
+        }
+        uint64_t ns;
+        rendre(budgets[k], &ns);
+        lv_draw_sw_mask_cache_info_t info;
+        lv_draw_sw_mask_cache_get_info(&info);
+        uint32_t total = info.hit_cnt + info.miss_cnt;
+        snprintf(msg, sizeof(msg), "budget %5u octets : %6u µs par image, %3u %% trouvés dans le cache, %5u octets utilisés",
+                 (unsigned)budgets[k], (unsigned)(ns / 1000), (unsigned)(total ? info.hit_cnt * 100 / total : 0),
+                 (unsigned)info.size);
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_sans_cache);
+    RUN_TEST(test_petit_budget);
+    RUN_TEST(test_budget_du_projet);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
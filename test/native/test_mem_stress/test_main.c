@@ -0,0 +1,229 @@
+// Test d'endurance de l'allocateur : création et suppression d'un million de fenêtres
+// avec les slabs et le routage par taille, puis relevé du plus grand bloc libre de chaque tas.
+// Lancement : pio test -e native_mem
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unity.h>
+#include "lvgl.h"
+
+#if !LV_MEM_ROUTE_BY_SIZE || !LV_USE_MEM_SLAB
+#error "Ce test demande LV_MEM_ROUTE_BY_SIZE et LV_USE_MEM_SLAB (env native_mem)"
+#endif
+
+#define NB_FENETRES     1000000          // Fenêtres créées puis supprimées
+#define NB_OUVERTES     8                // Fenêtres ouvertes en même temps
+#define PERIODE_RENDU   64               // Rendu de l'écran toutes les N fenêtres
+#define PERIODE_TEST    10000            // Vérification des tas toutes les N fenêtres
+
+static uint64_t sdram[LV_MEM_POOL_EXPAND_SIZE / sizeof(uint64_t)]; // Émule la SDRAM de la carte
+static uint64_t sdram2[256 * 1024 / sizeof(uint64_t)];              // Second gros pool, retiré pendant le test
+static lv_mem_pool_t poolSdram;
+static uint8_t tampon[480 * 272 / 10 * 4];
+static uint32_t tick;
+
+static uint32_t lireTick(void)
+{
+    return tick;
+}
+
+static void flush(lv_display_t *disp, const lv_area_t *zone, uint8_t *px)
+{
+    LV_UNUSED(zone);
+    LV_UNUSED(px);
+    lv_display_flush_ready(disp);
+}
+
+// Fenêtre de taille et de contenu variables, comme les fenêtres de connexion de l'application
+static lv_obj_t *creerFenetre(uint32_t n)
+{
+    char texte[64];
+    lv_obj_t *win = lv_win_create(lv_screen_active());
+    lv_obj_set_size(win, 200 + n % 200, 100 + n % 150);
+    lv_obj_set_pos(win, n % 280, n % 170);
+
+    snprintf(texte, sizeof(texte), "Fenetre %u", (unsigned)n);
+    lv_win_add_title(win, texte);
+    lv_win_add_button(win, LV_SYMBOL_CLOSE, 40);
+
+    lv_obj_t *contenu = lv_win_get_content(win);
+    lv_obj_t *ta = lv_textarea_create(contenu);
+    lv_textarea_set_one_line(ta, n % 2 == 0);
+    for (uint32_t i = 0; i < n % 24; i++) lv_textarea_add_char(ta, '0' + i % 10);
+
+    lv_obj_t *label = lv_label_create(contenu);
+    lv_label_set_text_fmt(label, "%0*u", (int)(1 + n % 40), (unsigned)n);
+    if (n % 3 == 0) lv_obj_set_style_opa_layered(win, LV_OPA_80, 0); // Rendu dans un calque (gros bloc)
+    return win;
+}
+
+static void afficherTas(const char *etape, const lv_mem_monitor_t *m)
+{
+    char msg[200];
+    snprintf(msg, sizeof(msg),
+             "%-6s petit tas : %6u utilisés, plus grand bloc libre %6u | SDRAM : %7u utilisés, plus grand bloc libre %7u",
+             etape, (unsigned)m->heaps[LV_MEM_HEAP_SMALL].cur_used, (unsigned)m->heaps[LV_MEM_HEAP_SMALL].free_biggest_size,
+             (unsigned)m->heaps[LV_MEM_HEAP_LARGE].cur_used, (unsigned)m->heaps[LV_MEM_HEAP_LARGE].free_biggest_size);
+    TEST_MESSAGE(msg);
+}
+
+void setUp(void)
+{
+    lv_init();
+    lv_tick_set_cb(lireTick);
+    poolSdram = lv_mem_add_large_pool(sdram, sizeof(sdram));
+    lv_display_t *disp = lv_display_create(480, 272);
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_set_buffers(disp, tampon, NULL, sizeof(tampon), LV_DISPLAY_RENDER_MODE_PARTIAL);
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+// Après le million de fenêtres, les tas doivent revenir à leur état initial
+static void test_million_de_fenetres(void)
+{
+    lv_obj_t *ouvertes[NB_OUVERTES] = {NULL};
+    lv_mem_monitor_t debut;
+    lv_mem_monitor_t m;
+    size_t minPetit = SIZE_MAX;
+    size_t minGrand = SIZE_MAX;
+
+    lv_refr_now(NULL);
+    lv_mem_monitor(&debut);
+    afficherTas("début", &debut);
+
+    for (uint32_t n = 0; n < NB_FENETRES; n++) {
+        uint32_t i = (n * 5) % NB_OUVERTES; // Ordre de suppression différent de l'ordre de création
+        if (ouvertes[i]) lv_obj_delete(ouvertes[i]);
+        ouvertes[i] = creerFenetre(n);
+
+        if (n % PERIODE_RENDU == 0) {
+            tick += 30;
+            lv_refr_now(NULL);
+        }
+
+        if (n % PERIODE_TEST == PERIODE_TEST - 1) {
+            TEST_ASSERT_TRUE(lv_mem_test() == LV_RESULT_OK);
+            lv_mem_monitor(&m);
+            minPetit = LV_MIN(minPetit, m.heaps[LV_MEM_HEAP_SMALL].free_biggest_size);
+            minGrand = LV_MIN(minGrand, m.heaps[LV_MEM_HEAP_LARGE].free_biggest_size);
+        }
+    }
+
+    lv_mem_monitor(&m);
+    afficherTas("ouvert", &m);
+
+    for (uint32_t i = 0; i < NB_OUVERTES; i++) lv_obj_delete(ouvertes[i]);
+    lv_refr_now(NULL);
+    lv_mem_monitor(&m);
+    afficherTas("fin", &m);
+
+    uint32_t slabsPleins = 0;
+    for (uint32_t i = 0; i < m.slab_class_cnt; i++) slabsPleins += m.slabs[i].full_cnt;
+    char msg[200];
+    snprintf(msg, sizeof(msg),
+             "plus petit « plus grand bloc libre » : petit tas %u, SDRAM %u | max utilisé : petit tas %u, SDRAM %u | slabs pleins %u fois",
+             (unsigned)minPetit, (unsigned)minGrand, (unsigned)m.heaps[LV_MEM_HEAP_SMALL].max_used,
+             (unsigned)m.heaps[LV_MEM_HEAP_LARGE].max_used, (unsigned)slabsPleins);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_TRUE(lv_mem_test() == LV_RESULT_OK);
+    TEST_ASSERT_EQUAL_UINT32(debut.heaps[LV_MEM_HEAP_SMALL].cur_used, m.heaps[LV_MEM_HEAP_SMALL].cur_used);
+    TEST_ASSERT_EQUAL_UINT32(debut.heaps[LV_MEM_HEAP_LARGE].cur_used, m.heaps[LV_MEM_HEAP_LARGE].cur_used);
+    TEST_ASSERT_EQUAL_UINT32(debut.heaps[LV_MEM_HEAP_SMALL].free_biggest_size, m.heaps[LV_MEM_HEAP_SMALL].free_biggest_size);
+    TEST_ASSERT_EQUAL_UINT32(debut.heaps[LV_MEM_HEAP_LARGE].free_biggest_size, m.heaps[LV_MEM_HEAP_LARGE].free_biggest_size);
+}
+
+// Le moniteur compte le pool des slabs et lv_mem_test() vérifie les slabs
+static void test_moniteur_et_verification_des_slabs(void)
+{
+    lv_mem_monitor_t avant;
+    lv_mem_monitor_t apres;
+    lv_mem_monitor(&avant);
+    TEST_ASSERT_EQUAL_UINT32(avant.heaps[LV_MEM_HEAP_SMALL].total_size + avant.heaps[LV_MEM_HEAP_LARGE].total_size +
+                             LV_MEM_SLAB_SIZE, avant.total_size);
+
+    // 100 blocs de 24 octets : classe de 32 octets, dans le pool des slabs
+    void *blocs[100];
+    for (uint32_t i = 0; i < 100; i++) blocs[i] = lv_malloc(24);
+    lv_mem_monitor(&apres);
+    TEST_ASSERT_EQUAL_UINT32(avant.total_size, apres.total_size);
+    TEST_ASSERT_EQUAL_UINT32(avant.free_size - 100 * 32, apres.free_size);
+    TEST_ASSERT_EQUAL_UINT32(avant.used_cnt + 100, apres.used_cnt);
+    TEST_ASSERT_TRUE(lv_mem_test() == LV_RESULT_OK);
+
+    // Un bloc libre qui pointe hors de sa page doit être détecté
+    lv_free(blocs[50]);
+    void *suivant = *(void **)blocs[50];
+    *(void **)blocs[50] = (uint8_t *)blocs[50] + 4;
+    TEST_ASSERT_TRUE(lv_mem_test() == LV_RESULT_INVALID);
+    *(void **)blocs[50] = suivant;
+    TEST_ASSERT_TRUE(lv_mem_test() == LV_RESULT_OK);
+
+    for (uint32_t i = 0; i < 100; i++) {
+        if (i != 50) lv_free(blocs[i]);
+    }
+    lv_mem_monitor(&apres);
+    TEST_ASSERT_EQUAL_UINT32(avant.free_size, apres.free_size);
+}
+
+static uint32_t compterAllocations(void)
+{
+    lv_mem_monitor_t m;
+    lv_mem_monitor(&m);
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < LV_MEM_SIZE_CLASS_CNT; i++) n += m.size_classes[i].alloc_cnt;
+    return n;
+}
+
+// Un bloc agrandi plusieurs fois par lv_realloc ne compte que pour une allocation
+static void test_realloc_compte_une_allocation(void)
+{
+    uint32_t avant = compterAllocations();
+    void *p = lv_realloc(NULL, 600);     // Hors des slabs
+    TEST_ASSERT_NOT_NULL(p);
+    for (uint32_t taille = 1200; taille <= 64 * 1024; taille *= 2) {
+        p = lv_realloc(p, taille);
+        TEST_ASSERT_NOT_NULL(p);
+    }
+    TEST_ASSERT_EQUAL_UINT32(avant + 1, compterAllocations());
+    lv_free(p);
+    TEST_ASSERT_EQUAL_UINT32(avant + 1, compterAllocations());
+}
+
+// Le premier gros pool contient la structure de contrôle du tas : il se retire après les autres
+static void test_retrait_des_gros_pools(void)
+{
+    lv_mem_pool_t pool = lv_mem_add_large_pool(sdram2, sizeof(sdram2));
+    TEST_ASSERT_NOT_NULL(pool);
+    lv_mem_monitor_t m;
+    lv_mem_monitor(&m);
+    uint32_t total = m.heaps[LV_MEM_HEAP_LARGE].total_size;
+
+    lv_mem_remove_pool(pool);
+    lv_mem_monitor(&m);
+    TEST_ASSERT_LESS_THAN_UINT32(total, m.heaps[LV_MEM_HEAP_LARGE].total_size);
+    TEST_ASSERT_TRUE(lv_mem_test() == LV_RESULT_OK);
+    void *p = lv_malloc(100 * 1024);
+    TEST_ASSERT_NOT_NULL(p);
+    lv_free(p);
+
+    // Seul le pool de la SDRAM reste : il peut être retiré
+    lv_mem_remove_pool(poolSdram);
+    lv_mem_monitor(&m);
+    TEST_ASSERT_EQUAL_UINT32(0, m.heaps[LV_MEM_HEAP_LARGE].total_size);
+    TEST_ASSERT_TRUE(lv_mem_test() == LV_RESULT_OK);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_moniteur_et_verification_des_slabs);
+    RUN_TEST(test_realloc_compte_une_allocation);
+    RUN_TEST(test_retrait_des_gros_pools);
+    RUN_TEST(test_million_de_fenetres);
+    return UNITY_END();
+}
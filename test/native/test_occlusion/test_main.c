@@ -0,0 +1,201 @@
+// Widgets cachés par un widget opaque (LV_USE_REFR_OCCLUSION) : mêmes pixels avec et sans l'élimination,
+// tâches de dessin évitées et temps d'une image.
+// Lancement : pio test -e native -f native/test_occlusion            (sans élimination, valeurs relevées)
+//             pio test -e native_occlusion -f native/test_occlusion  (avec élimination et moniteur de performance)
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+#include "src/lvgl_private.h"            // Compteur des tâches évitées (API privée LVGL)
+
+#define LARGEUR         480
+#define HAUTEUR         272
+#define NB_SCENES       12
+#define NB_IMAGES       20
+
+// Relevés sans élimination : fenêtre de connexion plein écran et à 60 %, puis les scènes aléatoires
+static const uint32_t controleFenetre[2] = {0xCD5371C8u, 0x7A8A0A34u};
+static const uint32_t controleScenes[NB_SCENES] = {
+    0x6FB52173u, 0x977C7C0Cu, 0x4BD885D6u, 0x426FF5CCu, 0x5F9966A3u, 0x560694A8u,
+    0x77D513CDu, 0xBFEF64F0u, 0x8A365323u, 0x0E8ECB6Du, 0xA796341Du, 0xB446AFEEu,
+};
+
+static uint32_t ecran[LARGEUR * HAUTEUR];
+static uint32_t tampon[LARGEUR * HAUTEUR / 10];
+static uint64_t tas[4][120 * 1024 / 8];    // Calques des widgets transformés (pools de 128 ko au plus)
+static lv_display_t *disp;
+static uint32_t graine;
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static uint32_t aleatoire(uint32_t max)
+{
+    graine = graine * 1103515245u + 12345u;
+    return (graine >> 8) % max;
+}
+
+static void flush(lv_display_t *d, const lv_area_t *zone, uint8_t *px)
+{
+    const uint32_t *p = (const uint32_t *)px;
+    for (int32_t y = zone->y1; y <= zone->y2; y++) {
+        for (int32_t x = zone->x1; x <= zone->x2; x++) ecran[y * LARGEUR + x] = *p++;
+    }
+    lv_display_flush_ready(d);
+}
+
+// FNV-1a de l'écran
+static uint32_t controlerEcran(void)
+{
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < LARGEUR * HAUTEUR; i++) h = (h ^ ecran[i]) * 16777619u;
+    return h;
+}
+
+// Tâches de dessin évitées à la dernière image (comptées avec le moniteur de performance)
+static uint32_t tachesEvitees(void)
+{
+#if LV_USE_REFR_OCCLUSION && LV_USE_PERF_MONITOR
+    return disp->occluded_task_cnt;
+#else
+    return 0;
+#endif
+}
+
+void setUp(void)
+{
+    lv_init();
+    for (uint32_t i = 0; i < 4; i++) lv_mem_add_pool(tas[i], sizeof(tas[i]));
+    disp = lv_display_create(LARGEUR, HAUTEUR);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);   // 32 bits comme le projet
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_set_buffers(disp, tampon, NULL, sizeof(tampon), LV_DISPLAY_RENDER_MODE_PARTIAL);
+#if LV_USE_PERF_MONITOR
+    lv_sysmon_hide_performance(disp);    // Pas d'étiquette dans les images comparées
+#endif
+    graine = 1;
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+// L'écran de la barrière (conteneur, socle, labels) sous la fenêtre de connexion
+static void creerFenetre(int32_t pourcentage)
+{
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_t *conteneur = lv_obj_create(scr);
+    lv_obj_set_size(conteneur, 300, 220);
+    lv_obj_align(conteneur, LV_ALIGN_LEFT_MID, 10, 0);
+    lv_obj_t *socle = lv_obj_create(conteneur);
+    lv_obj_set_size(socle, 60, 40);
+    lv_obj_align(socle, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+    lv_obj_t *bras = lv_obj_create(conteneur);
+    lv_obj_set_size(bras, 200, 12);
+    lv_obj_align(bras, LV_ALIGN_BOTTOM_LEFT, 30, -40);
+    static const char *const textes[] = {"Voitures: 3", "12:34:56", "Barriere fermee", "Entree avec mot de passe requis"};
+    for (uint32_t i = 0; i < 4; i++) {
+        lv_obj_t *label = lv_label_create(scr);
+        lv_label_set_text(label, textes[i]);
+        lv_obj_align(label, LV_ALIGN_TOP_RIGHT, -10, 20 + 30 * (int32_t)i);
+    }
+
+    lv_obj_t *win = lv_win_create(scr);
+    lv_obj_set_size(win, lv_pct(pourcentage), lv_pct(pourcentage));
+    lv_obj_center(win);
+    lv_win_add_title(win, "Connexion");
+    lv_obj_t *contenu = lv_win_get_content(win);
+    lv_obj_t *ta = lv_textarea_create(contenu);
+    lv_textarea_set_one_line(ta, true);
+    lv_textarea_set_password_mode(ta, true);
+    lv_textarea_set_text(ta, "1234");
+    lv_obj_t *btn = lv_button_create(contenu);
+    lv_obj_align(btn, LV_ALIGN_BOTTOM_MID, 0, 0);
+    lv_label_set_text(lv_label_create(btn), "Valider");
+}
+
+// Widgets opaques et transparents, arrondis, ombres, coins rognés, transformations et widgets cachés
+static void creerSceneAleatoire(void)
+{
+    lv_obj_t *scr = lv_screen_active();
+    for (uint32_t i = 0; i < 25; i++) {
+        lv_obj_t *parent = (i > 0 && aleatoire(3) == 0) ? lv_obj_get_child(scr, (int32_t)aleatoire(lv_obj_get_child_count(scr))) : scr;
+        lv_obj_t *obj = aleatoire(4) == 0 ? lv_button_create(parent) : lv_obj_create(parent);
+        lv_obj_set_pos(obj, (int32_t)aleatoire(LARGEUR) - 40, (int32_t)aleatoire(HAUTEUR) - 40);
+        lv_obj_set_size(obj, 40 + aleatoire(300), 30 + aleatoire(200));
+        lv_obj_set_style_bg_color(obj, lv_color_hex(aleatoire(0x1000000)), 0);
+        lv_obj_set_style_bg_opa(obj, aleatoire(3) == 0 ? (lv_opa_t)aleatoire(256) : LV_OPA_COVER, 0);
+        lv_obj_set_style_radius(obj, aleatoire(2) ? 0 : (int32_t)aleatoire(30), 0);
+        if (aleatoire(4) == 0) lv_obj_set_style_shadow_width(obj, 5 + aleatoire(20), 0);
+        if (aleatoire(6) == 0) lv_obj_set_style_clip_corner(obj, true, 0);
+        if (aleatoire(8) == 0) lv_obj_set_style_opa(obj, (lv_opa_t)(128 + aleatoire(128)), 0);
+        if (aleatoire(10) == 0) {
+            // Le calque entier doit tenir dans un pool
+            lv_obj_set_size(obj, 40 + aleatoire(100), 30 + aleatoire(80));
+            lv_obj_set_style_transform_rotation(obj, (int32_t)aleatoire(3600), 0);
+        }
+        if (aleatoire(10) == 0) lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+        if (aleatoire(3) == 0) lv_label_set_text(lv_label_create(obj), "Texte");
+    }
+}
+
+static void test_fenetre(void)
+{
+    char msg[128];
+    static const int32_t pourcentages[2] = {100, 60};
+    for (uint32_t k = 0; k < 2; k++) {
+        lv_obj_clean(lv_screen_active());
+        creerFenetre(pourcentages[k]);
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(disp);
+        uint32_t taches = tachesEvitees();
+        TEST_ASSERT_EQUAL_HEX32(controleFenetre[k], controlerEcran());
+
+        uint64_t t0 = nanosecondes();
+        for (uint32_t n = 0; n < NB_IMAGES; n++) {
+            lv_obj_invalidate(lv_screen_active());
+            lv_refr_now(disp);
+        }
+        uint64_t image = (nanosecondes() - t0) / NB_IMAGES;
+
+        snprintf(msg, sizeof(msg), "fenêtre à %d %% : %u tâches de dessin évitées, image %u µs",
+                 (int)pourcentages[k], (unsigned)taches, (unsigned)(image / 1000));
+        TEST_MESSAGE(msg);
+#if LV_USE_REFR_OCCLUSION && LV_USE_PERF_MONITOR
+        // Seule la fenêtre plein écran couvre entièrement des widgets
+        if (pourcentages[k] == 100) TEST_ASSERT_GREATER_THAN_UINT32(0, taches);
+#endif
+    }
+}
+
+static void test_scenes_aleatoires(void)
+{
+    char msg[64];
+    uint32_t taches = 0;
+    for (uint32_t k = 0; k < NB_SCENES; k++) {
+        lv_obj_clean(lv_screen_active());
+        creerSceneAleatoire();
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(disp);
+        taches += tachesEvitees();
+        snprintf(msg, sizeof(msg), "scène %u", (unsigned)k);
+        TEST_ASSERT_EQUAL_HEX32_MESSAGE(controleScenes[k], controlerEcran(), msg);
+    }
+    snprintf(msg, sizeof(msg), "%u tâches de dessin évitées sur %u scènes", (unsigned)taches, NB_SCENES);
+    TEST_MESSAGE(msg);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fenetre);
+    RUN_TEST(test_scenes_aleatoires);
+    return UNITY_END();
+}
@@ -0,0 +1,203 @@
+// Pavé numérique (src/pinpad.cpp) comparé au clavier LVGL (lv_keyboard) qu'il remplace :
+// mémoire à la création, temps de création et surface redessinée par appui.
+// Lancement : pio test -e native -f native/test_pinpad
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+#include "src/lvgl_private.h"            // Zones des boutons du clavier (API privée LVGL)
+#include "../../../src/pinpad.cpp"       // Le widget n'est pas dans une bibliothèque
+
+#define LARGEUR         480
+#define HAUTEUR         272
+#define HAUTEUR_PAVE    120              // Comme style_pinpad
+#define NB_CREATIONS    200
+
+static uint32_t tampon[LARGEUR * HAUTEUR / 10];
+static lv_display_t *disp;
+static lv_indev_t *indev;
+static lv_indev_state_t etat;
+static lv_point_t point;
+static uint32_t pixelsRedessines;
+static lv_obj_t *ta;
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void flush(lv_display_t *d, const lv_area_t *zone, uint8_t *px)
+{
+    LV_UNUSED(px);
+    pixelsRedessines += lv_area_get_size(zone);
+    lv_display_flush_ready(d);
+}
+
+static void lire(lv_indev_t *i, lv_indev_data_t *data)
+{
+    LV_UNUSED(i);
+    data->point = point;
+    data->state = etat;
+}
+
+static size_t memoireUtilisee(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+void setUp(void)
+{
+    lv_init();
+    disp = lv_display_create(LARGEUR, HAUTEUR);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);   // 32 bits comme le projet
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_set_buffers(disp, tampon, NULL, sizeof(tampon), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    indev = lv_indev_create();
+    lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(indev, lire);
+    etat = LV_INDEV_STATE_RELEASED;
+
+    ta = lv_textarea_create(lv_screen_active());
+    lv_textarea_set_one_line(ta, true);
+    lv_textarea_set_password_mode(ta, true);
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+static lv_obj_t *creerPave(void)
+{
+    lv_obj_t *pave = pinpad_create(lv_layer_top());
+    lv_obj_set_size(pave, LARGEUR, HAUTEUR_PAVE);
+    lv_obj_align(pave, LV_ALIGN_BOTTOM_MID, 0, 0);
+    pinpad_set_textarea(pave, ta);
+    return pave;
+}
+
+static lv_obj_t *creerClavier(lv_keyboard_mode_t mode)
+{
+    lv_obj_t *kb = lv_keyboard_create(lv_layer_top());
+    lv_obj_set_size(kb, LARGEUR, HAUTEUR_PAVE);
+    lv_obj_align(kb, LV_ALIGN_BOTTOM_MID, 0, 0);
+    lv_keyboard_set_mode(kb, mode);
+    lv_keyboard_set_textarea(kb, ta);
+    return kb;
+}
+
+// Centre de la touche (colonne, ligne) du pavé
+static lv_point_t centreTouchePave(lv_obj_t *pave, uint32_t col, uint32_t ligne)
+{
+    pinpad_t *p = (pinpad_t *)pave;
+    lv_point_t pt;
+    pt.x = pave->coords.x1 + (p->colX[col] + p->colX[col + 1] - PINPAD_ECART) / 2;
+    pt.y = pave->coords.y1 + (p->ligneY[ligne] + p->ligneY[ligne + 1] - PINPAD_ECART) / 2;
+    return pt;
+}
+
+// Centre d'un bouton du clavier
+static lv_point_t centreBouton(lv_obj_t *kb, uint32_t id)
+{
+    lv_area_t zone = ((lv_buttonmatrix_t *)kb)->button_areas[id];
+    lv_area_move(&zone, kb->coords.x1, kb->coords.y1);
+    lv_point_t pt = {(zone.x1 + zone.x2) / 2, (zone.y1 + zone.y2) / 2};
+    return pt;
+}
+
+// Appui puis relâchement en pt, retourne les pixels redessinés par les deux rafraîchissements
+static uint32_t appuyer(lv_point_t pt)
+{
+    lv_refr_now(disp);
+    pixelsRedessines = 0;
+    point = pt;
+    etat = LV_INDEV_STATE_PRESSED;
+    lv_indev_read(indev);
+    lv_refr_now(disp);
+    etat = LV_INDEV_STATE_RELEASED;
+    lv_indev_read(indev);
+    lv_refr_now(disp);
+    return pixelsRedessines;
+}
+
+// Chiffres, effacement, appui entre deux touches et OK
+static void test_saisie(void)
+{
+    lv_obj_t *pave = creerPave();
+    lv_obj_update_layout(pave);
+    uint32_t nbReady = 0;
+    lv_obj_add_event_cb(ta, [](lv_event_t *e) { (*(uint32_t *)lv_event_get_user_data(e))++; }, LV_EVENT_READY, &nbReady);
+
+    appuyer(centreTouchePave(pave, 0, 0));       // 1
+    appuyer(centreTouchePave(pave, 1, 3));       // 0
+    appuyer(centreTouchePave(pave, 2, 2));       // 9
+    appuyer(centreTouchePave(pave, 0, 3));       // Effacer
+    appuyer(centreTouchePave(pave, 1, 1));       // 5
+    TEST_ASSERT_EQUAL_STRING("105", lv_textarea_get_text(ta));
+
+    // Dans l'écart entre deux touches : rien
+    lv_point_t ecart = centreTouchePave(pave, 0, 0);
+    ecart.x = pave->coords.x1 + ((pinpad_t *)pave)->colX[1] - PINPAD_ECART / 2;
+    appuyer(ecart);
+    TEST_ASSERT_EQUAL_STRING("105", lv_textarea_get_text(ta));
+
+    appuyer(centreTouchePave(pave, 2, 3));       // OK
+    TEST_ASSERT_EQUAL_UINT32(1, nbReady);
+    TEST_ASSERT_EQUAL_STRING("105", lv_textarea_get_text(ta));
+}
+
+// Mémoire, temps de création et surface redessinée par appui d'un chiffre,
+// pour le pavé et le clavier LVGL en mode texte (l'ancien écran de connexion) et numérique
+static void test_comparaison_clavier(void)
+{
+    static const char *const noms[] = {"pavé numérique", "lv_keyboard texte", "lv_keyboard numérique"};
+    size_t memoire[3];
+    uint32_t surface[3];
+    uint64_t ns[3];
+    char msg[160];
+
+    for (uint32_t k = 0; k < 3; k++) {
+        lv_refr_now(disp);
+        size_t avant = memoireUtilisee();
+        lv_obj_t *obj = k == 0 ? creerPave() : creerClavier(k == 1 ? LV_KEYBOARD_MODE_TEXT_LOWER : LV_KEYBOARD_MODE_NUMBER);
+        lv_obj_update_layout(obj);
+        memoire[k] = memoireUtilisee() - avant;
+
+        // Un chiffre : "1" du pavé, "q" puis "1" du clavier texte (le premier bouton change de carte), "1" du clavier numérique
+        lv_textarea_set_text(ta, "");
+        lv_point_t pt = k == 0 ? centreTouchePave(obj, 0, 0) : centreBouton(obj, k == 1 ? 1 : 0);
+        surface[k] = appuyer(pt);
+        TEST_ASSERT_EQUAL_STRING(k == 1 ? "q" : "1", lv_textarea_get_text(ta));
+        lv_obj_delete(obj);
+
+        uint64_t t0 = nanosecondes();
+        for (uint32_t i = 0; i < NB_CREATIONS; i++) {
+            obj = k == 0 ? creerPave() : creerClavier(k == 1 ? LV_KEYBOARD_MODE_TEXT_LOWER : LV_KEYBOARD_MODE_NUMBER);
+            lv_obj_update_layout(obj);
+            lv_obj_delete(obj);
+        }
+        ns[k] = (nanosecondes() - t0) / NB_CREATIONS;
+
+        snprintf(msg, sizeof(msg), "%-22s : %5u octets, création %4u µs, %6u pixels redessinés par appui",
+                 noms[k], (unsigned)memoire[k], (unsigned)(ns[k] / 1000), (unsigned)surface[k]);
+        TEST_MESSAGE(msg);
+    }
+
+    TEST_ASSERT_LESS_THAN_UINT32(memoire[1], memoire[0]);
+    TEST_ASSERT_LESS_THAN_UINT32(memoire[2], memoire[0]);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(surface[2], surface[0]);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_saisie);
+    RUN_TEST(test_comparaison_clavier);
+    return UNITY_END();
+}
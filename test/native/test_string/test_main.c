@@ -0,0 +1,164 @@
+// Tests de lv_memcpy, lv_memset et lv_memmove : toutes les tailles et tous les alignements,
+// comparés à des copies octet par octet, puis benchmark de 8 o à 64 Ko.
+// Lancement : pio test -e native -f native/test_string (version builtin de LVGL)
+//             pio test -e native_armv7em -f native/test_string (version LV_STRING_BUILTIN_ARMV7EM)
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+
+#define GARDE           64               // Octets de garde de chaque côté de la zone écrite
+#define TAILLE_MAX      (64 * 1024)
+
+static uint8_t src[TAILLE_MAX + 2 * GARDE];
+static uint8_t dst[TAILLE_MAX + 2 * GARDE];
+static uint8_t attendu[TAILLE_MAX + 2 * GARDE];
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Motif sans période multiple de 4 pour détecter les mots décalés
+static void remplir(uint8_t *p, size_t taille, uint32_t graine)
+{
+    for (size_t i = 0; i < taille; i++) p[i] = (uint8_t)((i * 251u + graine * 17u) ^ (i >> 8));
+}
+
+static const size_t grandesTailles[] = {511, 512, 1000, 1023, 4096, 4099, 65536 - 7, 65536};
+
+void setUp(void)
+{
+    lv_init();
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+static void verifierCopie(size_t taille, size_t decSrc, size_t decDst)
+{
+    remplir(src, sizeof(src), (uint32_t)taille);
+    memset(dst, 0xA5, sizeof(dst));
+    memset(attendu, 0xA5, sizeof(attendu));
+    for (size_t i = 0; i < taille; i++) attendu[GARDE + decDst + i] = src[GARDE + decSrc + i];
+
+    void *ret = lv_memcpy(dst + GARDE + decDst, src + GARDE + decSrc, taille);
+    TEST_ASSERT_EQUAL_PTR(dst + GARDE + decDst, ret);
+    TEST_ASSERT_EQUAL_MEMORY(attendu, dst, taille + 2 * GARDE);
+}
+
+// Tailles 0 à 300 et grandes tailles, décalages de 0 à 7 de la source et de la destination
+static void test_memcpy(void)
+{
+    for (size_t decSrc = 0; decSrc < 8; decSrc++) {
+        for (size_t decDst = 0; decDst < 8; decDst++) {
+            for (size_t taille = 0; taille <= 300; taille++) verifierCopie(taille, decSrc, decDst);
+            for (size_t i = 0; i < sizeof(grandesTailles) / sizeof(grandesTailles[0]); i++) {
+                verifierCopie(grandesTailles[i] - 8, decSrc, decDst);
+            }
+        }
+    }
+}
+
+static void verifierRemplissage(size_t taille, size_t dec, uint8_t valeur)
+{
+    memset(dst, 0xA5, sizeof(dst));
+    memset(attendu, 0xA5, sizeof(attendu));
+    for (size_t i = 0; i < taille; i++) attendu[GARDE + dec + i] = valeur;
+
+    lv_memset(dst + GARDE + dec, valeur, taille);
+    TEST_ASSERT_EQUAL_MEMORY(attendu, dst, taille + 2 * GARDE);
+}
+
+static void test_memset(void)
+{
+    for (size_t dec = 0; dec < 8; dec++) {
+        for (size_t taille = 0; taille <= 300; taille++) verifierRemplissage(taille, dec, (uint8_t)(taille * 7 + 1));
+        for (size_t i = 0; i < sizeof(grandesTailles) / sizeof(grandesTailles[0]); i++) {
+            verifierRemplissage(grandesTailles[i] - 8, dec, 0x00);
+            verifierRemplissage(grandesTailles[i] - 8, dec, 0xFF);
+        }
+    }
+}
+
+// Zones qui se recouvrent : la source est de -40 à +40 octets de la destination
+static void verifierDeplacement(size_t taille, size_t decDst, int32_t distance)
+{
+    remplir(dst, sizeof(dst), (uint32_t)taille);
+    memcpy(attendu, dst, sizeof(attendu));
+    uint8_t *d = dst + GARDE + decDst;
+    uint8_t *s = d + distance;
+    uint8_t *a = attendu + GARDE + decDst;
+    for (size_t i = 0; i < taille; i++) src[i] = s[i];
+    for (size_t i = 0; i < taille; i++) a[i] = src[i];
+
+    void *ret = lv_memmove(d, s, taille);
+    TEST_ASSERT_EQUAL_PTR(d, ret);
+    TEST_ASSERT_EQUAL_MEMORY(attendu, dst, taille + 2 * GARDE);
+}
+
+static void test_memmove(void)
+{
+    for (size_t decDst = 0; decDst < 4; decDst++) {
+        for (int32_t distance = -40; distance <= 40; distance++) {
+            for (size_t taille = 0; taille <= 200; taille++) verifierDeplacement(taille, decDst, distance);
+            verifierDeplacement(4096, decDst, distance);
+        }
+    }
+}
+
+// Débit de lv_memcpy en Mo/s par taille : alignés, source décalée de 1, destination décalée de 2,
+// et moyenne des 16 combinaisons de décalages 0 à 3. Puis lv_memset et lv_memmove alignés.
+static uint32_t debit(size_t taille, size_t decSrc, size_t decDst, int operation)
+{
+    uint32_t repetitions = (uint32_t)(4 * 1024 * 1024 / taille);
+    uint8_t *d = dst + GARDE + decDst;
+    uint8_t *s = src + GARDE + decSrc;
+
+    uint64_t t0 = nanosecondes();
+    for (uint32_t r = 0; r < repetitions; r++) {
+        if (operation == 0) lv_memcpy(d, s, taille);
+        else if (operation == 1) lv_memset(d, (int)r, taille);
+        else lv_memmove(d, d + 8, taille - 8);
+        __asm__ volatile("" : : "r"(d) : "memory");
+    }
+    uint64_t ns = nanosecondes() - t0;
+    if (ns == 0) ns = 1;
+    return (uint32_t)((uint64_t)taille * repetitions * 1000u / ns);
+}
+
+static void test_benchmark(void)
+{
+    static const size_t tailles[] = {8, 64, 512, 4096, 65536 - 8};
+    char msg[200];
+
+    TEST_MESSAGE("Mo/s        memcpy aligné  src+1  dst+2  moy. 16  |  memset  memmove");
+    for (size_t k = 0; k < sizeof(tailles) / sizeof(tailles[0]); k++) {
+        size_t t = tailles[k];
+        uint32_t somme = 0;
+        for (size_t decSrc = 0; decSrc < 4; decSrc++) {
+            for (size_t decDst = 0; decDst < 4; decDst++) somme += debit(t, decSrc, decDst, 0);
+        }
+        snprintf(msg, sizeof(msg), "%6u o  %14u %6u %6u %8u  | %7u %8u", (unsigned)t, (unsigned)debit(t, 0, 0, 0),
+                 (unsigned)debit(t, 1, 0, 0), (unsigned)debit(t, 0, 2, 0), (unsigned)(somme / 16),
+                 (unsigned)debit(t, 0, 0, 1), (unsigned)debit(t, 0, 0, 2));
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_memcpy);
+    RUN_TEST(test_memset);
+    RUN_TEST(test_memmove);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
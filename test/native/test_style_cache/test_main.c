@@ -0,0 +1,190 @@
+// Cache des propriétés de style résolues (LV_OBJ_STYLE_PROP_CACHE_CNT) : même rendu avec et sans cache,
+// et mesure du tas, de la recherche des propriétés, des changements d'état et du rafraîchissement.
+// Lancement : pio test -e native -f native/test_style_cache              (sans cache, comme le projet)
+//             pio test -e native_style_cache -f native/test_style_cache  (16 entrées par objet)
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+
+// Relevé sans cache
+#define CONTROLE_SCENE  0x4E8FED7Au
+
+#define NB_BOUTONS      12
+#define NB_PASSES       200
+
+static const lv_style_prop_t proprietes[] = {
+    LV_STYLE_WIDTH, LV_STYLE_HEIGHT, LV_STYLE_X, LV_STYLE_Y, LV_STYLE_ALIGN,
+    LV_STYLE_PAD_TOP, LV_STYLE_PAD_LEFT, LV_STYLE_BG_COLOR, LV_STYLE_BG_OPA, LV_STYLE_RADIUS,
+    LV_STYLE_BORDER_WIDTH, LV_STYLE_SHADOW_WIDTH, LV_STYLE_TEXT_COLOR, LV_STYLE_TEXT_FONT, LV_STYLE_OPA,
+    LV_STYLE_TRANSFORM_ROTATION, LV_STYLE_TRANSLATE_X, LV_STYLE_OUTLINE_WIDTH, LV_STYLE_LAYOUT, LV_STYLE_BLEND_MODE,
+};
+
+static uint32_t ecran[480 * 272];
+static uint32_t tampon[480 * 272 / 10];
+static lv_display_t *disp;
+static lv_obj_t *boutons[NB_BOUTONS];
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void flush(lv_display_t *d, const lv_area_t *zone, uint8_t *px)
+{
+    const uint32_t *p = (const uint32_t *)px;
+    for (int32_t y = zone->y1; y <= zone->y2; y++) {
+        for (int32_t x = zone->x1; x <= zone->x2; x++) ecran[y * 480 + x] = *p++;
+    }
+    lv_display_flush_ready(d);
+}
+
+// FNV-1a de l'écran
+static uint32_t controlerEcran(void)
+{
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < 480 * 272; i++) h = (h ^ ecran[i]) * 16777619u;
+    return h;
+}
+
+static size_t memoireUtilisee(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+static void lireProprietes(lv_obj_t *obj, volatile uint32_t *somme)
+{
+    for (uint32_t i = 0; i < sizeof(proprietes) / sizeof(proprietes[0]); i++) {
+        *somme += (uint32_t)lv_obj_get_style_prop(obj, LV_PART_MAIN, proprietes[i]).num;
+    }
+    uint32_t nb = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < nb; i++) lireProprietes(lv_obj_get_child(obj, i), somme);
+}
+
+void setUp(void)
+{
+    lv_init();
+    disp = lv_display_create(480, 272);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);   // 32 bits comme le projet
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_set_buffers(disp, tampon, NULL, sizeof(tampon), LV_DISPLAY_RENDER_MODE_PARTIAL);
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+// Boutons du thème avec un label, dans un conteneur flex, un curseur et un interrupteur
+static size_t creerScene(void)
+{
+    size_t avant = memoireUtilisee();
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_t *cont = lv_obj_create(scr);
+    lv_obj_set_size(cont, 480, 200);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    for (uint32_t i = 0; i < NB_BOUTONS; i++) {
+        boutons[i] = lv_button_create(cont);
+        lv_obj_t *label = lv_label_create(boutons[i]);
+        lv_label_set_text_fmt(label, "Place %u", (unsigned)i);
+    }
+    lv_obj_t *curseur = lv_slider_create(scr);
+    lv_obj_align(curseur, LV_ALIGN_BOTTOM_LEFT, 20, -30);
+    lv_slider_set_value(curseur, 40, LV_ANIM_OFF);
+    lv_obj_t *inter = lv_switch_create(scr);
+    lv_obj_align(inter, LV_ALIGN_BOTTOM_RIGHT, -20, -20);
+    lv_obj_update_layout(scr);
+    return memoireUtilisee() - avant;
+}
+
+// Sans tick, les transitions du thème ne finissent jamais et s'accumulent à chaque changement d'état :
+// on avance le temps pour les terminer tout de suite
+static void changerEtat(lv_obj_t *obj, bool presse)
+{
+    if (presse) lv_obj_add_state(obj, LV_STATE_PRESSED);
+    else lv_obj_remove_state(obj, LV_STATE_PRESSED);
+    lv_tick_inc(1000);
+    lv_anim_refr_now();
+}
+
+// Boutons pressés puis relâchés un par un, avec un rafraîchissement à chaque fois
+static uint32_t presserBoutons(void)
+{
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < NB_BOUTONS; i++) {
+        changerEtat(boutons[i], true);
+        lv_refr_now(disp);
+        h = (h ^ controlerEcran()) * 16777619u;
+        changerEtat(boutons[i], false);
+        lv_refr_now(disp);
+        h = (h ^ controlerEcran()) * 16777619u;
+    }
+    return h;
+}
+
+static void test_rendu(void)
+{
+    creerScene();
+    lv_refr_now(disp);
+    uint32_t h = (2166136261u ^ controlerEcran()) * 16777619u;
+    h = (h ^ presserBoutons()) * 16777619u;
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_SCENE, h);
+}
+
+static void test_benchmark(void)
+{
+    char msg[160];
+    size_t tas = creerScene();
+    lv_obj_t *scr = lv_screen_active();
+
+    // Recherche de 20 propriétés sur tous les objets, le cache est chaud après la première passe
+    volatile uint32_t somme = 0;
+    uint64_t recherche = UINT64_MAX;
+    for (uint32_t n = 0; n < NB_PASSES; n++) {
+        uint64_t t0 = nanosecondes();
+        lireProprietes(scr, &somme);
+        uint64_t ns = nanosecondes() - t0;
+        if (ns < recherche) recherche = ns;
+    }
+
+    // Changements d'état : le cache de l'objet est vidé à chaque fois
+    uint64_t t0 = nanosecondes();
+    for (uint32_t n = 0; n < 20; n++) {
+        for (uint32_t i = 0; i < NB_BOUTONS; i++) {
+            changerEtat(boutons[i], true);
+            lv_obj_update_layout(scr);
+            changerEtat(boutons[i], false);
+            lv_obj_update_layout(scr);
+        }
+    }
+    uint64_t etats = (nanosecondes() - t0) / (20 * NB_BOUTONS * 2);
+
+    // Rafraîchissement de tout l'écran
+    uint64_t rafraichir = UINT64_MAX;
+    for (uint32_t n = 0; n < 5; n++) {
+        lv_obj_invalidate(scr);
+        t0 = nanosecondes();
+        lv_refr_now(disp);
+        uint64_t ns = nanosecondes() - t0;
+        if (ns < rafraichir) rafraichir = ns;
+    }
+
+    snprintf(msg, sizeof(msg), "cache %u entrées : tas %u octets, recherche %u ns, changement d'état %u ns, image %u µs",
+             (unsigned)LV_OBJ_STYLE_PROP_CACHE_CNT, (unsigned)tas, (unsigned)recherche, (unsigned)etats,
+             (unsigned)(rafraichir / 1000));
+    TEST_MESSAGE(msg);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_rendu);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
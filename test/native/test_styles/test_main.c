@@ -0,0 +1,245 @@
+// Feuille de styles constants de l'application (src/styles.c) comparée aux styles locaux qu'elle remplace
+// (lv_obj_set_style_*, lv_obj_set_size, lv_obj_align) : rendu identique, tas par écran et recherche des propriétés.
+// Lancement : pio test -e native -f native/test_styles
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+#include "../../../src/styles.c"         // La feuille de styles n'est pas dans une bibliothèque
+
+#define NB_PASSES       2000
+
+typedef enum {
+    ECRAN_BARRIERE = 0,
+    ECRAN_LOGIN,
+    ECRAN_CHANGE_PWD,
+    ECRAN_PAVE,
+    ECRAN_NB
+} ecran_t;
+
+static const char *const nomsEcrans[ECRAN_NB] = {"barriere", "login", "change_pwd", "pavé"};
+
+// Propriétés lues par la recherche : des propriétés des styles de l'application et d'autres
+static const lv_style_prop_t proprietes[] = {
+    LV_STYLE_WIDTH, LV_STYLE_HEIGHT, LV_STYLE_ALIGN, LV_STYLE_X, LV_STYLE_Y,
+    LV_STYLE_BG_COLOR, LV_STYLE_RADIUS, LV_STYLE_PAD_TOP, LV_STYLE_TEXT_COLOR, LV_STYLE_BORDER_WIDTH,
+};
+
+static uint32_t ecran[480 * 272];
+static uint32_t tampon[480 * 272 / 10];
+static lv_display_t *disp;
+static bool locaux;                      // Styles locaux (avant la feuille de styles) au lieu des styles constants
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void flush(lv_display_t *d, const lv_area_t *zone, uint8_t *px)
+{
+    const uint32_t *p = (const uint32_t *)px;
+    for (int32_t y = zone->y1; y <= zone->y2; y++) {
+        for (int32_t x = zone->x1; x <= zone->x2; x++) ecran[y * 480 + x] = *p++;
+    }
+    lv_display_flush_ready(d);
+}
+
+// FNV-1a de l'écran
+static uint32_t controlerEcran(void)
+{
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < 480 * 272; i++) h = (h ^ ecran[i]) * 16777619u;
+    return h;
+}
+
+static size_t memoireUtilisee(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+// Ajoute le style constant ou, comme avant, une propriété locale par propriété du style
+static void appliquer(lv_obj_t *obj, const lv_style_t *style)
+{
+    if (!locaux) {
+        lv_obj_add_style(obj, style, 0);
+        return;
+    }
+    const lv_style_const_prop_t *p = (const lv_style_const_prop_t *)style->values_and_props;
+    for (; p->prop != LV_STYLE_PROP_INV; p++) lv_obj_set_local_style_prop(obj, p->prop, p->value, 0);
+}
+
+// Mêmes objets et mêmes styles que src/main.cpp (sans le bras de la barrière ni le pavé, qui sont en C++)
+static void construireBarriere(lv_obj_t *scr)
+{
+    lv_obj_t *conteneur = lv_obj_create(scr);
+    appliquer(conteneur, &style_conteneur);
+    lv_obj_remove_flag(conteneur, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_t *socle = lv_obj_create(conteneur);
+    appliquer(socle, &style_socle);
+
+    lv_obj_t *voitures = lv_label_create(scr);
+    lv_label_set_text(voitures, "Voitures: 0");
+    appliquer(voitures, &style_label_voitures);
+    lv_obj_t *heure = lv_label_create(scr);
+    lv_label_set_text(heure, "00:00:00");
+    appliquer(heure, &style_label_heure);
+    lv_obj_t *etat = lv_label_create(scr);
+    lv_label_set_text(etat, "Barriere fermee");
+    appliquer(etat, &style_label_etat);
+    lv_obj_t *horaire = lv_label_create(scr);
+    lv_label_set_text(horaire, "Entree avec mot de passe requis");
+    lv_obj_align_to(horaire, heure, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 10);
+}
+
+static lv_obj_t *creerBouton(lv_obj_t *parent, const lv_style_t *style, const char *texte)
+{
+    lv_obj_t *btn = lv_button_create(parent);
+    appliquer(btn, style);
+    lv_obj_t *label = lv_label_create(btn);
+    lv_label_set_text(label, texte);
+    appliquer(label, &style_centre);
+    return btn;
+}
+
+static lv_obj_t *creerChamp(lv_obj_t *parent, const lv_style_t *style, const char *texte)
+{
+    lv_obj_t *ta = lv_textarea_create(parent);
+    appliquer(ta, style);
+    lv_textarea_set_password_mode(ta, true);
+    lv_textarea_set_placeholder_text(ta, texte);
+    return ta;
+}
+
+static void construireLogin(lv_obj_t *scr)
+{
+    lv_obj_t *win = lv_win_create(scr);
+    lv_obj_t *titre = lv_label_create(lv_win_get_header(win));
+    lv_label_set_text(titre, "Connexion");
+    appliquer(titre, &style_centre);
+    creerChamp(win, &style_champ_mdp, "Mot de passe");
+    creerBouton(win, &style_bouton, "Valider");
+    creerBouton(win, &style_bouton_change, "Changer de mot de passe");
+}
+
+static void construireChangePwd(lv_obj_t *scr)
+{
+    lv_obj_t *win = lv_win_create(scr);
+    lv_obj_t *titre = lv_label_create(lv_win_get_header(win));
+    lv_label_set_text(titre, "Changer mot de passe");
+    appliquer(titre, &style_centre);
+    creerChamp(win, &style_champ_mdp, "Ancien mot de passe");
+    creerChamp(win, &style_champ_mdp_2, "Nouveau mot de passe");
+    creerBouton(win, &style_bouton, "Valider");
+}
+
+static void construirePave(lv_obj_t *scr)
+{
+    lv_obj_t *pave = lv_obj_create(scr);
+    appliquer(pave, &style_pinpad);
+}
+
+// Construit l'écran et retourne les octets du tas qu'il utilise
+static size_t construire(ecran_t id, lv_obj_t **scr)
+{
+    size_t avant = memoireUtilisee();
+    *scr = lv_obj_create(NULL);
+    switch (id) {
+        case ECRAN_BARRIERE: construireBarriere(*scr); break;
+        case ECRAN_LOGIN: construireLogin(*scr); break;
+        case ECRAN_CHANGE_PWD: construireChangePwd(*scr); break;
+        default: construirePave(*scr); break;
+    }
+    lv_obj_update_layout(*scr);
+    return memoireUtilisee() - avant;
+}
+
+static void lireProprietes(lv_obj_t *obj, volatile uint32_t *somme)
+{
+    for (uint32_t i = 0; i < sizeof(proprietes) / sizeof(proprietes[0]); i++) {
+        *somme += (uint32_t)lv_obj_get_style_prop(obj, LV_PART_MAIN, proprietes[i]).num;
+    }
+    uint32_t nb = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < nb; i++) lireProprietes(lv_obj_get_child(obj, i), somme);
+}
+
+// Meilleur temps de lecture des propriétés sur tous les objets de l'écran
+static uint64_t mesurerRecherche(lv_obj_t *scr)
+{
+    volatile uint32_t somme = 0;
+    uint64_t meilleur = UINT64_MAX;
+    for (uint32_t n = 0; n < NB_PASSES; n++) {
+        uint64_t t0 = nanosecondes();
+        lireProprietes(scr, &somme);
+        uint64_t ns = nanosecondes() - t0;
+        if (ns < meilleur) meilleur = ns;
+    }
+    return meilleur;
+}
+
+void setUp(void)
+{
+    lv_init();
+    disp = lv_display_create(480, 272);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);   // 32 bits comme le projet
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_set_buffers(disp, tampon, NULL, sizeof(tampon), LV_DISPLAY_RENDER_MODE_PARTIAL);
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+// Les écrans sont rendus à l'identique avec les styles constants et les styles locaux
+static void test_rendu_identique(void)
+{
+    for (uint32_t id = 0; id < ECRAN_NB; id++) {
+        uint32_t h[2];
+        for (uint32_t k = 0; k < 2; k++) {
+            locaux = k == 1;
+            lv_obj_t *scr;
+            construire((ecran_t)id, &scr);
+            lv_screen_load(scr);
+            lv_refr_now(disp);
+            h[k] = controlerEcran();
+            lv_screen_load(lv_obj_create(NULL));
+            lv_obj_delete(scr);
+        }
+        TEST_ASSERT_EQUAL_HEX32_MESSAGE(h[1], h[0], nomsEcrans[id]);
+    }
+}
+
+// Tas par écran et recherche de 10 propriétés sur tous les objets de l'écran
+static void test_tas_et_recherche(void)
+{
+    char msg[128];
+    for (uint32_t id = 0; id < ECRAN_NB; id++) {
+        size_t tas[2];
+        uint64_t ns[2];
+        for (uint32_t k = 0; k < 2; k++) {
+            locaux = k == 1;
+            lv_obj_t *scr;
+            tas[k] = construire((ecran_t)id, &scr);
+            ns[k] = mesurerRecherche(scr);
+            lv_obj_delete(scr);
+        }
+        snprintf(msg, sizeof(msg), "%-10s : tas %5u -> %5u octets, recherche %6u -> %6u ns (locaux -> constants)",
+                 nomsEcrans[id], (unsigned)tas[1], (unsigned)tas[0], (unsigned)ns[1], (unsigned)ns[0]);
+        TEST_MESSAGE(msg);
+        TEST_ASSERT_LESS_THAN_UINT32(tas[1], tas[0]);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_rendu_identique);
+    RUN_TEST(test_tas_et_recherche);
+    return UNITY_END();
+}
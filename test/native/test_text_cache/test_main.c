@@ -0,0 +1,250 @@
+// Cache des mesures de texte (LV_TEXT_CACHE_DEF_SIZE) : mêmes tailles, coupures de lignes et pixels
+// qu'avec la mesure sans cache, budget en octets respecté, et temps d'une mesure.
+// Lancement : pio test -e native -f native/test_text_cache
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+#include "src/lvgl_private.h"            // Entrées du cache et lv_text_get_next_line (API privée LVGL)
+
+#define LARGEUR         480
+#define HAUTEUR         272
+#define BUDGET          (4 * 1024)       // Comme lv_conf.h
+#define NB_MESURES      2000
+#define MAX_LIGNES      256
+
+static uint32_t ecran[LARGEUR * HAUTEUR];
+static uint32_t tampon[LARGEUR * HAUTEUR / 10];
+static lv_display_t *disp;
+static uint32_t graine;
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static uint32_t aleatoire(uint32_t max)
+{
+    graine = graine * 1103515245u + 12345u;
+    return (graine >> 8) % max;
+}
+
+static void flush(lv_display_t *d, const lv_area_t *zone, uint8_t *px)
+{
+    const uint32_t *p = (const uint32_t *)px;
+    for (int32_t y = zone->y1; y <= zone->y2; y++) {
+        for (int32_t x = zone->x1; x <= zone->x2; x++) ecran[y * LARGEUR + x] = *p++;
+    }
+    lv_display_flush_ready(d);
+}
+
+// FNV-1a de l'écran
+static uint32_t controlerEcran(void)
+{
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < LARGEUR * HAUTEUR; i++) h = (h ^ ecran[i]) * 16777619u;
+    return h;
+}
+
+void setUp(void)
+{
+    lv_init();
+    disp = lv_display_create(LARGEUR, HAUTEUR);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);   // 32 bits comme le projet
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_set_buffers(disp, tampon, NULL, sizeof(tampon), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    graine = 1;
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+// Mots courts et longs, accents, retours à la ligne et espaces multiples
+static void texteAleatoire(char *texte, uint32_t max)
+{
+    static const char *const mots[] = {
+        "Place", "libre", "occupée", "Barrière", "fermée", "12:34:56", "Voitures:", "3", " ", "  ", "\n",
+        "Entrée", "avec", "mot", "de", "passe", "requis", "anticonstitutionnellement", "-", "a",
+    };
+    uint32_t nb = aleatoire(40);
+    uint32_t n = 0;
+    texte[0] = '\0';
+    for (uint32_t i = 0; i < nb; i++) {
+        const char *mot = mots[aleatoire(sizeof(mots) / sizeof(mots[0]))];
+        uint32_t l = strlen(mot);
+        if (n + l + 2 >= max) break;
+        memcpy(&texte[n], mot, l);
+        n += l;
+        if (aleatoire(3)) texte[n++] = ' ';
+        texte[n] = '\0';
+    }
+}
+
+// Coupures de lignes sans cache, comme lv_text_get_size les calcule
+static uint32_t couperSansCache(const char *texte, const lv_font_t *police, int32_t espaceLettres, int32_t largeur,
+                                lv_text_flag_t options, uint32_t *fins)
+{
+    if (options & LV_TEXT_FLAG_EXPAND) largeur = LV_COORD_MAX;
+    uint32_t nb = 0;
+    uint32_t debut = 0;
+    while (texte[debut] != '\0' && nb < MAX_LIGNES) {
+        debut += lv_text_get_next_line(&texte[debut], police, espaceLettres, largeur, NULL, options);
+        fins[nb++] = debut;
+    }
+    return nb;
+}
+
+// Tailles et coupures de textes aléatoires avec le cache (mesure puis lecture) et sans cache
+static void test_mesures(void)
+{
+    static const lv_text_flag_t options[] = {LV_TEXT_FLAG_NONE, LV_TEXT_FLAG_EXPAND, LV_TEXT_FLAG_FIT, LV_TEXT_FLAG_BREAK_ALL};
+    static char texte[400];
+    static uint32_t fins[MAX_LIGNES];
+    const lv_font_t *police = LV_FONT_DEFAULT;
+    char msg[64];
+    uint32_t lues = 0;
+
+    for (uint32_t k = 0; k < NB_MESURES; k++) {
+        texteAleatoire(texte, sizeof(texte));
+        int32_t espaceLettres = (int32_t)aleatoire(4);
+        int32_t espaceLignes = (int32_t)aleatoire(6);
+        int32_t largeur = aleatoire(5) == 0 ? LV_COORD_MAX : 20 + (int32_t)aleatoire(400);
+        lv_text_flag_t option = options[aleatoire(sizeof(options) / sizeof(options[0]))];
+        snprintf(msg, sizeof(msg), "mesure %u", (unsigned)k);
+
+        lv_text_cache_resize(0, true);
+        lv_point_t attendu;
+        lv_text_get_size(&attendu, texte, police, espaceLettres, espaceLignes, largeur, option);
+        uint32_t nbLignes = couperSansCache(texte, police, espaceLettres, largeur, option, fins);
+
+        lv_text_cache_resize(BUDGET, false);
+        for (uint32_t fois = 0; fois < 2; fois++) {
+            lv_point_t taille;
+            lv_text_get_size(&taille, texte, police, espaceLettres, espaceLignes, largeur, option);
+            TEST_ASSERT_EQUAL_INT32_MESSAGE(attendu.x, taille.x, msg);
+            TEST_ASSERT_EQUAL_INT32_MESSAGE(attendu.y, taille.y, msg);
+        }
+
+        lv_cache_entry_t *entree = lv_text_cache_acquire(texte, police, espaceLettres, espaceLignes, largeur, option);
+        TEST_ASSERT_NOT_NULL_MESSAGE(entree, msg);
+        const lv_text_cache_data_t *lignes = lv_cache_entry_get_data(entree);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(nbLignes, lignes->line_cnt, msg);
+        uint32_t debut = 0;
+        for (uint32_t i = 0; i < nbLignes; i++) {
+            int32_t largeurLigne;
+            TEST_ASSERT_EQUAL_UINT32_MESSAGE(fins[i] - debut, lv_text_cache_get_next_line(lignes, debut, &largeurLigne), msg);
+            TEST_ASSERT_EQUAL_INT32_MESSAGE(lv_text_get_width(&texte[debut], fins[i] - debut, police, espaceLettres),
+                                            largeurLigne, msg);
+            debut = fins[i];
+        }
+        lv_text_cache_release(entree);
+        lues++;
+    }
+    snprintf(msg, sizeof(msg), "%u textes comparés", (unsigned)lues);
+    TEST_MESSAGE(msg);
+}
+
+// Labels avec retour à la ligne, alignements, espacement des lettres et texte long coupé par des points
+static void creerLabels(void)
+{
+    static char textes[12][300];
+    lv_obj_t *scr = lv_screen_active();
+    for (uint32_t i = 0; i < 12; i++) {
+        texteAleatoire(textes[i], sizeof(textes[i]));
+        lv_obj_t *label = lv_label_create(scr);
+        lv_label_set_text_static(label, textes[i]);
+        lv_obj_set_pos(label, (int32_t)(i % 4) * 120, (int32_t)(i / 4) * 90 - 20);
+        lv_obj_set_width(label, 60 + (int32_t)aleatoire(60));
+        if (i % 3 == 0) lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+        if (i % 3 == 1) lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_RIGHT, 0);
+        if (i % 5 == 0) lv_obj_set_style_text_letter_space(label, 2, 0);
+        if (i % 4 == 0) {
+            lv_obj_set_height(label, 60);
+            lv_label_set_long_mode(label, LV_LABEL_LONG_DOT);
+        }
+    }
+}
+
+// Mêmes labels mesurés et dessinés sans cache, puis avec les coupures de lignes du cache
+static void test_rendu(void)
+{
+    lv_text_cache_resize(0, true);
+    creerLabels();
+    lv_refr_now(disp);
+    uint32_t attendu = controlerEcran();
+
+    lv_obj_clean(lv_screen_active());
+    lv_text_cache_resize(BUDGET, false);
+    graine = 1;
+    creerLabels();
+    TEST_ASSERT_GREATER_THAN_UINT32(0, (uint32_t)lv_cache_get_size(LV_GLOBAL_DEFAULT()->text_cache, NULL));
+    for (uint32_t fois = 0; fois < 2; fois++) {
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(disp);
+        TEST_ASSERT_EQUAL_HEX32(attendu, controlerEcran());
+    }
+}
+
+// Le cache ne dépasse pas son budget et un texte long n'est pas copié
+static void test_budget(void)
+{
+    static char texte[400];
+    static char long_texte[2000];
+    lv_cache_t *cache = LV_GLOBAL_DEFAULT()->text_cache;
+    lv_text_cache_resize(BUDGET, true);
+
+    for (uint32_t k = 0; k < 500; k++) {
+        texteAleatoire(texte, sizeof(texte));
+        lv_point_t taille;
+        lv_text_get_size(&taille, texte, LV_FONT_DEFAULT, 0, 0, 200, LV_TEXT_FLAG_NONE);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(BUDGET, (uint32_t)lv_cache_get_size(cache, NULL));
+    }
+
+    memset(long_texte, 'a', sizeof(long_texte) - 1);
+    long_texte[sizeof(long_texte) - 1] = '\0';
+    lv_point_t taille;
+    lv_text_get_size(&taille, long_texte, LV_FONT_DEFAULT, 0, 0, 200, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_GREATER_THAN_INT32(0, taille.y);
+    TEST_ASSERT_NULL(lv_text_cache_acquire(long_texte, LV_FONT_DEFAULT, 0, 0, 200, LV_TEXT_FLAG_NONE));
+}
+
+// Mesure répétée des labels courts d'un écran (ils tiennent tous dans le budget), avec et sans le cache
+static void test_benchmark(void)
+{
+    static char textes[20][40];
+    char msg[128];
+    for (uint32_t i = 0; i < 20; i++) texteAleatoire(textes[i], sizeof(textes[i]));
+
+    uint64_t ns[2];
+    for (uint32_t avecCache = 0; avecCache < 2; avecCache++) {
+        lv_text_cache_resize(avecCache ? BUDGET : 0, true);
+        uint64_t t0 = nanosecondes();
+        for (uint32_t n = 0; n < 500; n++) {
+            for (uint32_t i = 0; i < 20; i++) {
+                lv_point_t taille;
+                lv_text_get_size(&taille, textes[i], LV_FONT_DEFAULT, 0, 0, 150, LV_TEXT_FLAG_NONE);
+            }
+        }
+        ns[avecCache] = (nanosecondes() - t0) / (500 * 20);
+    }
+    snprintf(msg, sizeof(msg), "lv_text_get_size : %u ns sans cache, %u ns avec cache (%u octets utilisés)",
+             (unsigned)ns[0], (unsigned)ns[1], (unsigned)lv_cache_get_size(LV_GLOBAL_DEFAULT()->text_cache, NULL));
+    TEST_MESSAGE(msg);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_mesures);
+    RUN_TEST(test_rendu);
+    RUN_TEST(test_budget);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,173 @@
+// Tests de l'ordonnanceur des timers LVGL (tas binaire trié par temps restant)
+// Lancement : pio test -e native -f native/test_timer
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+
+// Relevés avec l'ancien parcours de liste (voir test_scenario_identique_a_la_liste)
+#define SCENARIO_APPELS     8110u
+#define SCENARIO_CONTROLE_H 0x0011D4B8u
+#define SCENARIO_CONTROLE_L 0x3D92CF1Eu
+
+static uint32_t tick;                    // Temps simulé en ms
+static uint64_t somme;                   // Somme de contrôle des appels
+static uint32_t appels;                  // Nombre d'appels de callback
+
+static uint32_t lireTick(void)
+{
+    return tick;
+}
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void cbSimple(lv_timer_t *t)
+{
+    somme += (uintptr_t)lv_timer_get_user_data(t) * 2654435761u + tick;
+    appels++;
+}
+
+// Callback qui modifie son propre timer (période, suppression/recréation, répétitions, reset)
+static void cbModifiant(lv_timer_t *t)
+{
+    uintptr_t id = (uintptr_t)lv_timer_get_user_data(t);
+    somme += ((id * 7 + 1) * 2654435761u) ^ tick;
+    appels++;
+    uint32_t k = (id * 7 + tick) % 11;
+    if (k == 0) lv_timer_set_period(t, 1 + (id * 13 + tick) % 40);
+    else if (k == 1 && (tick % 3) == 0) {
+        lv_timer_delete(t);
+        lv_timer_create(cbModifiant, 1 + (id % 30), (void *)(id + 1000));
+    }
+    else if (k == 3) lv_timer_set_repeat_count(t, 3);
+    else if (k == 4) lv_timer_reset(t);
+}
+
+void setUp(void)
+{
+    lv_init();
+    lv_tick_set_cb(lireTick);
+    tick = 0;
+    somme = 0;
+    appels = 0;
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+// Chaque timer s'exécute à sa période et le délai retourné est celui du prochain timer
+static void test_periodes_et_delai(void)
+{
+    lv_timer_create(cbSimple, 7, (void *)1);
+    lv_timer_create(cbSimple, 10, (void *)2);
+    lv_timer_create(cbSimple, 25, (void *)3);
+
+    uint32_t delai = lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(7, delai);
+
+    for (tick = 1; tick <= 1000; tick++) {
+        delai = lv_timer_handler();
+        uint32_t attendu = LV_MIN(7 - tick % 7, LV_MIN(10 - tick % 10, 25 - tick % 25));
+        TEST_ASSERT_EQUAL_UINT32(attendu, delai);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1000 / 7 + 1000 / 10 + 1000 / 25, appels);
+}
+
+// Un timer de période 0 ne s'exécute qu'une fois par appel de lv_timer_handler()
+static void test_periode_nulle(void)
+{
+    lv_timer_create(cbSimple, 0, (void *)1);
+    lv_timer_create(cbSimple, 5, (void *)2);
+    for (tick = 1; tick <= 100; tick++) lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(100 + 100 / 5, appels);
+}
+
+// Pause, reprise et nombre de répétitions
+static void test_pause_et_repetitions(void)
+{
+    lv_timer_t *t = lv_timer_create(cbSimple, 10, (void *)1);
+    lv_timer_t *r = lv_timer_create(cbSimple, 10, (void *)2);
+    lv_timer_set_repeat_count(r, 3);
+    lv_timer_set_auto_delete(r, false);
+
+    lv_timer_pause(t);
+    for (tick = 1; tick <= 100; tick++) lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(3, appels);
+    TEST_ASSERT_TRUE(lv_timer_get_paused(r));
+
+    lv_timer_resume(t);
+    for (; tick <= 200; tick++) lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(3 + 10, appels);
+
+    lv_timer_ready(t);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(3 + 11, appels);
+}
+
+// Scénario avec des callbacks qui modifient ou recréent leur timer, plus pause/reprise/ready de l'extérieur.
+// Nombre d'appels et somme de contrôle (délais retournés compris) relevés avec l'ancien parcours de liste.
+static void test_scenario_identique_a_la_liste(void)
+{
+    for (uintptr_t i = 0; i < 50; i++) lv_timer_create(cbModifiant, 1 + i % 17, (void *)i);
+    lv_timer_t *fixe = lv_timer_create(cbSimple, 50, (void *)7);
+    lv_timer_t *enPause = lv_timer_create(cbSimple, 3, (void *)9);
+
+    uint64_t controle = 0;
+    for (tick = 1; tick < 20000; tick++) {
+        if (tick % 97 == 0) lv_timer_ready(fixe);
+        if (tick % 89 == 0) lv_timer_set_period(fixe, 20 + tick % 60);
+        if (tick % 50 == 0) {
+            if (lv_timer_get_paused(enPause)) lv_timer_resume(enPause);
+            else lv_timer_pause(enPause);
+        }
+        somme = 0;
+        uint32_t delai = lv_timer_handler();
+        controle += somme + delai * 1000003u;
+    }
+    TEST_ASSERT_EQUAL_UINT32(SCENARIO_APPELS, appels);
+    TEST_ASSERT_EQUAL_HEX32(SCENARIO_CONTROLE_H, (uint32_t)(controle >> 32));
+    TEST_ASSERT_EQUAL_HEX32(SCENARIO_CONTROLE_L, (uint32_t)controle);
+}
+
+// Coût d'un appel de lv_timer_handler() avec 10, 100 et 1000 timers (1 appel par ms simulée)
+static void test_benchmark(void)
+{
+    static const uint32_t nb[] = {10, 100, 1000};
+    char msg[128];
+
+    for (uint32_t k = 0; k < 3; k++) {
+        lv_deinit();
+        setUp();
+        for (uintptr_t i = 0; i < nb[k]; i++) lv_timer_create(cbSimple, 16 + (i * 37) % 1000, (void *)i);
+
+        uint64_t t0 = nanosecondes();
+        for (tick = 1; tick <= 20000; tick++) lv_timer_handler();
+        uint64_t t1 = nanosecondes();
+        for (uint32_t r = 0; r < 20000; r++) lv_timer_delete(lv_timer_create(cbSimple, 5, NULL));
+        uint64_t t2 = nanosecondes();
+
+        snprintf(msg, sizeof(msg), "%4u timers : %5u ns par lv_timer_handler(), %4u ns par create+delete",
+                 (unsigned)nb[k], (unsigned)((t1 - t0) / 20000), (unsigned)((t2 - t1) / 20000));
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_periodes_et_delai);
+    RUN_TEST(test_periode_nulle);
+    RUN_TEST(test_pause_et_repetitions);
+    RUN_TEST(test_scenario_identique_a_la_liste);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
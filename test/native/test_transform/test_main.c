@@ -0,0 +1,314 @@
+// Tests de la rotation et de la mise à l'échelle des images (lv_draw_sw_transform)
+// Lancement : pio test -e native -f native/test_transform
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl.h"
+#include "src/lvgl_private.h"            // lv_draw_sw_transform (API privée LVGL)
+
+// Images tournées d'un angle qui n'est pas droit : relevé avec le code d'avant l'optimisation, identique
+#define CONTROLE_ROTATIONS  0xB971AF1Eu
+// Tous les cas (angles droits exacts, mises à l'échelle seules) : relevé avec le code actuel
+#define CONTROLE_TOUS       0xB42E55ABu
+// Images de référence mises à l'échelle sans rotation, lignes source calculées une par une
+#define CONTROLE_ECHELLE    0xBE3C39DDu
+
+#define NB_CAS      20000
+
+static uint8_t src[200 * 200 * 4 * 2];
+static uint8_t dest[600 * 600 * 4];
+static uint8_t reference[600 * 600 * 4];
+static uint32_t graine;
+
+static uint32_t aleatoire(void)
+{
+    graine = graine * 1103515245u + 12345u;
+    return graine >> 8;
+}
+
+static uint64_t nanosecondes(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// FNV-1a
+static uint32_t controler(uint32_t h, const void *p, size_t taille)
+{
+    const uint8_t *o = (const uint8_t *)p;
+    for (size_t i = 0; i < taille; i++) h = (h ^ o[i]) * 16777619u;
+    return h;
+}
+
+static uint32_t taillePixel(lv_color_format_t cf)
+{
+    switch (cf) {
+        case LV_COLOR_FORMAT_ARGB8888:
+        case LV_COLOR_FORMAT_XRGB8888: return 4;
+        case LV_COLOR_FORMAT_RGB888: return 3;
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_RGB565A8: return 2;
+        default: return 1;
+    }
+}
+
+// Octets écrits par lv_draw_sw_transform pour une zone de w x h
+static uint32_t tailleDestination(lv_color_format_t cf, int32_t w, int32_t h, bool recolor)
+{
+    switch (cf) {
+        case LV_COLOR_FORMAT_ARGB8888:
+        case LV_COLOR_FORMAT_XRGB8888:
+        case LV_COLOR_FORMAT_RGB888: return w * h * 4;
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_RGB565A8: return w * h * 3;
+        case LV_COLOR_FORMAT_L8: return w * h * (recolor ? 4 : 2);
+        default: return w * h;
+    }
+}
+
+static void transformer(const lv_draw_image_dsc_t *dsc, const lv_area_t *zone, int32_t w, int32_t h, int32_t stride,
+                        lv_color_format_t cf)
+{
+    memset(dest, 0xA5, tailleDestination(cf, lv_area_get_width(zone), lv_area_get_height(zone), true));
+    lv_draw_sw_transform(NULL, zone, src, w, h, stride, dsc, NULL, cf, dest);
+}
+
+void setUp(void)
+{
+    lv_init();
+    graine = 1;
+}
+
+void tearDown(void)
+{
+    lv_deinit();
+}
+
+// À 90, 180 et 270 degrés sans mise à l'échelle, chaque pixel de la source est copié tel quel
+// à sa position exacte et les pixels hors de l'image sont transparents
+static void test_angles_droits_sans_perte(void)
+{
+    static const lv_color_format_t formats[] = {LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_RGB565};
+    static const int32_t angles[] = {900, 1800, 2700, -900, 3600 + 900};
+
+    for (uint32_t f = 0; f < 2; f++) {
+        for (uint32_t a = 0; a < 5; a++) {
+            for (uint32_t n = 0; n < 20; n++) {
+                lv_color_format_t cf = formats[f];
+                int32_t w = 1 + aleatoire() % 60;
+                int32_t h = 1 + aleatoire() % 60;
+                int32_t stride = w * taillePixel(cf) + (aleatoire() % 3) * 4;
+                // Valeurs toutes différentes pour retrouver l'origine de chaque pixel
+                for (int32_t y = 0; y < h; y++) {
+                    for (int32_t x = 0; x < w; x++) {
+                        uint32_t v = 1 + y * w + x;
+                        if (cf == LV_COLOR_FORMAT_ARGB8888) ((uint32_t *)(src + y * stride))[x] = v * 2654435761u | 1;
+                        else ((uint16_t *)(src + y * stride))[x] = (uint16_t)v;
+                    }
+                }
+
+                lv_draw_image_dsc_t dsc;
+                lv_draw_image_dsc_init(&dsc);
+                dsc.rotation = angles[a];
+                dsc.pivot.x = aleatoire() % (w + 1);
+                dsc.pivot.y = aleatoire() % (h + 1);
+                dsc.antialias = aleatoire() & 1;
+                lv_area_t zone;
+                lv_image_buf_get_transformed_area(&zone, w, h, dsc.rotation, LV_SCALE_NONE, LV_SCALE_NONE, &dsc.pivot);
+                // LVGL tourne les indices des pixels autour du pivot alors que la zone est calculée avec leurs bords :
+                // l'image peut dépasser d'un pixel, la zone est agrandie pour retrouver tous les pixels
+                lv_area_increase(&zone, 1, 1);
+                transformer(&dsc, &zone, w, h, stride, cf);
+
+                // Point source du pixel destination (x, y) : rotation inverse des indices autour du pivot
+                int32_t quart = ((dsc.rotation % 3600 + 3600) % 3600) / 900;
+                int32_t zw = lv_area_get_width(&zone);
+                int32_t zh = lv_area_get_height(&zone);
+                uint32_t copies = 0;
+                for (int32_t y = 0; y < zh; y++) {
+                    for (int32_t x = 0; x < zw; x++) {
+                        int32_t dx = zone.x1 + x - dsc.pivot.x;
+                        int32_t dy = zone.y1 + y - dsc.pivot.y;
+                        int32_t xs = quart == 1 ? dy : quart == 2 ? -dx : -dy;
+                        int32_t ys = quart == 1 ? -dx : quart == 2 ? -dy : dx;
+                        xs += dsc.pivot.x;
+                        ys += dsc.pivot.y;
+                        bool dedans = xs >= 0 && xs < w && ys >= 0 && ys < h;
+                        if (cf == LV_COLOR_FORMAT_ARGB8888) {
+                            uint32_t px = ((uint32_t *)dest)[y * zw + x];
+                            uint32_t attendu = dedans ? ((uint32_t *)(src + ys * stride))[xs] : 0;
+                            TEST_ASSERT_EQUAL_HEX32(attendu, px);
+                        }
+                        else {
+                            uint8_t alpha = dest[zw * zh * 2 + y * zw + x];
+                            TEST_ASSERT_EQUAL_HEX8(dedans ? 0xFF : 0x00, alpha);
+                            if (dedans) TEST_ASSERT_EQUAL_HEX16(((uint16_t *)(src + ys * stride))[xs],
+                                                                    ((uint16_t *)dest)[y * zw + x]);
+                        }
+                        copies += dedans;
+                    }
+                }
+                TEST_ASSERT_EQUAL_UINT32(w * h, copies);
+            }
+        }
+    }
+}
+
+// Cas aléatoires : tous les formats, angles, mises à l'échelle, pivots, antialiasing et recoloration
+static void test_cas_aleatoires(void)
+{
+    static const lv_color_format_t formats[] = {LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_XRGB8888,
+                                                LV_COLOR_FORMAT_RGB888, LV_COLOR_FORMAT_RGB565,
+                                                LV_COLOR_FORMAT_RGB565A8, LV_COLOR_FORMAT_A8, LV_COLOR_FORMAT_L8
+                                               };
+    uint32_t hRotations = 2166136261u;
+    uint32_t hTous = 2166136261u;
+    uint32_t nbRotations = 0;
+
+    for (uint32_t n = 0; n < NB_CAS; n++) {
+        lv_color_format_t cf = formats[aleatoire() % 7];
+        int32_t w = 1 + aleatoire() % 60;
+        int32_t h = 1 + aleatoire() % 60;
+        int32_t stride = w * taillePixel(cf) + (aleatoire() % 3) * 4;
+        uint32_t type = aleatoire() % 3;
+        for (int32_t i = 0; i < stride * h * 2; i++) {
+            if (type == 0) src[i] = (uint8_t)aleatoire();
+            else if (type == 1) src[i] = (aleatoire() % 8) ? 0xFF : (uint8_t)aleatoire();   // Surtout uni
+            else src[i] = ((i / (stride * 4)) & 1) ? 0x33 : 0xCC;                           // Rayures
+        }
+
+        lv_draw_image_dsc_t dsc;
+        lv_draw_image_dsc_init(&dsc);
+        dsc.rotation = aleatoire() % 8 < 3 ? ((int32_t)(aleatoire() % 9) - 4) * 900 : (int32_t)(aleatoire() % 7200) - 3600;
+        if (aleatoire() % 4 == 0) {
+            dsc.scale_x = 64 + aleatoire() % 600;
+            dsc.scale_y = 64 + aleatoire() % 600;
+        }
+        dsc.pivot.x = aleatoire() % (w + 1);
+        dsc.pivot.y = aleatoire() % (h + 1);
+        dsc.antialias = aleatoire() & 1;
+        dsc.recolor_opa = (aleatoire() & 1) ? LV_OPA_COVER : LV_OPA_TRANSP;
+        if (dsc.rotation == 0 && dsc.scale_x == LV_SCALE_NONE) continue;   // Pas de transformation
+
+        lv_area_t zone;
+        lv_image_buf_get_transformed_area(&zone, w, h, dsc.rotation, dsc.scale_x, dsc.scale_y, &dsc.pivot);
+        zone.x1 += (int32_t)(aleatoire() % 3) - 1;
+        zone.y1 += (int32_t)(aleatoire() % 3) - 1;
+        if (lv_area_get_width(&zone) < 1 || lv_area_get_height(&zone) < 1) continue;
+
+        transformer(&dsc, &zone, w, h, stride, cf);
+        uint32_t taille = tailleDestination(cf, lv_area_get_width(&zone), lv_area_get_height(&zone),
+                                            dsc.recolor_opa >= LV_OPA_MIN);
+        hTous = controler(hTous, dest, taille);
+        bool angleDroit = dsc.rotation % 900 == 0 && dsc.scale_x == LV_SCALE_NONE && cf != LV_COLOR_FORMAT_L8;
+        if (dsc.rotation != 0 && !angleDroit) {
+            hRotations = controler(hRotations, dest, taille);
+            nbRotations++;
+        }
+    }
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "%u rotations comparées au code d'origine", (unsigned)nbRotations);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_ROTATIONS, hRotations);
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_TOUS, hTous);
+}
+
+// Image mise à l'échelle sans rotation (bruit ARGB8888) : rendue en bandes de hauteurs aléatoires,
+// comme avec un tampon de rendu partiel, elle doit être identique à l'image de référence rendue d'un coup
+static void test_echelle_par_bandes(void)
+{
+    uint32_t hReferences = 2166136261u;
+    uint32_t nbBandes = 0;
+
+    for (uint32_t n = 0; n < 500; n++) {
+        int32_t w = 1 + aleatoire() % 60;
+        int32_t h = 1 + aleatoire() % 60;
+        int32_t stride = w * 4;
+        for (int32_t i = 0; i < stride * h; i++) src[i] = (uint8_t)aleatoire();
+
+        lv_draw_image_dsc_t dsc;
+        lv_draw_image_dsc_init(&dsc);
+        dsc.scale_x = 64 + aleatoire() % 600;
+        dsc.scale_y = 64 + aleatoire() % 600;
+        dsc.pivot.x = aleatoire() % (w + 1);
+        dsc.pivot.y = aleatoire() % (h + 1);
+        dsc.antialias = aleatoire() & 1;
+
+        lv_area_t zone;
+        lv_image_buf_get_transformed_area(&zone, w, h, 0, dsc.scale_x, dsc.scale_y, &dsc.pivot);
+        int32_t zw = lv_area_get_width(&zone);
+        int32_t zh = lv_area_get_height(&zone);
+        transformer(&dsc, &zone, w, h, stride, LV_COLOR_FORMAT_ARGB8888);
+        memcpy(reference, dest, zw * zh * 4);
+        hReferences = controler(hReferences, reference, zw * zh * 4);
+
+        char msg[64];
+        snprintf(msg, sizeof(msg), "cas %u", (unsigned)n);
+        lv_area_t bande = zone;
+        while (bande.y1 <= zone.y2) {
+            int32_t hauteur = 1 + (int32_t)(aleatoire() % 8);
+            bande.y2 = LV_MIN(bande.y1 + hauteur - 1, zone.y2);
+            transformer(&dsc, &bande, w, h, stride, LV_COLOR_FORMAT_ARGB8888);
+            TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&reference[(bande.y1 - zone.y1) * zw * 4], dest,
+                                             lv_area_get_size(&bande) * 4, msg);
+            bande.y1 = bande.y2 + 1;
+            nbBandes++;
+        }
+    }
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "%u bandes comparées aux images de référence", (unsigned)nbBandes);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_HEX32(CONTROLE_ECHELLE, hReferences);
+}
+
+// Bras de la barrière (12 x 120 ARGB8888 rayé) de 1 à 89 degrés puis à 90 degrés, en ns par pixel de la zone
+static void test_benchmark(void)
+{
+    char msg[128];
+    uint32_t *p = (uint32_t *)src;
+    for (int32_t y = 0; y < 120; y++) {
+        for (int32_t x = 0; x < 12; x++) p[y * 12 + x] = ((y * 8 / 120) % 2) ? 0xFFFFFFFFu : 0xFFF44336u;
+    }
+
+    for (int32_t aa = 1; aa >= 0; aa--) {
+        for (int32_t droit = 0; droit < 2; droit++) {
+            uint64_t ns = 0;
+            uint64_t pixels = 0;
+            for (uint32_t r = 0; r < 50; r++) {
+                for (int32_t angle = droit ? 900 : 10; angle <= (droit ? 900 : 890); angle += 10) {
+                    lv_draw_image_dsc_t dsc;
+                    lv_draw_image_dsc_init(&dsc);
+                    dsc.rotation = angle;
+                    dsc.pivot.x = 6;
+                    dsc.pivot.y = 120;
+                    dsc.antialias = aa;
+                    lv_area_t zone;
+                    lv_image_buf_get_transformed_area(&zone, 12, 120, angle, LV_SCALE_NONE, LV_SCALE_NONE, &dsc.pivot);
+                    uint64_t t0 = nanosecondes();
+                    lv_draw_sw_transform(NULL, &zone, src, 12, 120, 48, &dsc, NULL, LV_COLOR_FORMAT_ARGB8888, dest);
+                    ns += nanosecondes() - t0;
+                    pixels += lv_area_get_size(&zone);
+                }
+            }
+            snprintf(msg, sizeof(msg), "bras %s, antialiasing %s : %.2f ns par pixel", droit ? "à 90 degrés" : "de 1 à 89 degrés",
+                     aa ? "oui" : "non", (double)ns / pixels);
+            TEST_MESSAGE(msg);
+        }
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_angles_droits_sans_perte);
+    RUN_TEST(test_cas_aleatoires);
+    RUN_TEST(test_echelle_par_bandes);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}